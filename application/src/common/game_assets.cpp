@@ -72,7 +72,7 @@ namespace assets
     };
 }
 
-void assets::InitAssets(AssetManager *assets)
+void assets::InitAssets(AssetManager *assets, AssetManager::LoadingCallback loadingCallback)
 {
     static const SheetLoadInfo sheetsToLoad[] = {
         // Stage
@@ -110,10 +110,15 @@ void assets::InitAssets(AssetManager *assets)
         { SHEET_VFX_DUST_4, "atlas/dust/dust_4.json" },
     };
 
+    std::vector<int> sheetIDs;
     for (const auto &sheet : sheetsToLoad)
     {
         assets->AddSpriteSheet(sheet.sheetID, ASSETS_PATH, sheet.path, true);
+        sheetIDs.push_back(sheet.sheetID);
     }
+
+    // Dcode toutes les sprite sheets en parallle plutt qu' la premire utilisation
+    assets->LoadSpriteSheets(sheetIDs, loadingCallback);
 }
 
 void assets::InitTextures(AssetManager * assets)
@@ -416,18 +421,15 @@ std::string assets::AnimIDToString(AnimID animID)
 void game::UpdateFontSize(Scene *scene)
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(scene->GetRenderer(), &viewport);
+    if (viewport.w <= 0) return;
+
     AssetManager *assets = scene->GetAssetManager();
 
+    // Les polices ne sont modifies que si la largeur de la vue change
     const float scale = viewport.w / 1920.0f;
-    for (int i = 0; i < static_cast<int>(FontID::FONT_COUNT); i++)
+    if (assets->SetFontScale(scale))
     {
-        FontID fontID = static_cast<FontID>(i);
-        TTF_Font *font = assets->GetFont(fontID);
-        if (font == nullptr) continue;
-
-        float initialSize = assets->GetFontInitialSize(fontID);
-
-        TTF_SetFontSize(font, roundf(initialSize * scale));
+        assets->PrewarmFonts(scene->GetTextEngine());
     }
 }
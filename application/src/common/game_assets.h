@@ -17,7 +17,9 @@
 
 namespace assets
 {
-    void InitAssets(AssetManager *assets);
+    /// @brief Enregistre les sprite sheets puis les charge en parallèle.
+    /// @param loadingCallback fonction appelée après le chargement de chaque sprite sheet.
+    void InitAssets(AssetManager *assets, AssetManager::LoadingCallback loadingCallback = nullptr);
     void InitTextures(AssetManager *assets);
     void InitFonts(AssetManager *assets);
     void InitSFX(AssetManager *assets);
@@ -155,6 +155,13 @@ void GameCommon::ResetPlayerStats()
     }
 }
 
+GameCommon &GameCommon::GetFromScene(Scene *scene)
+{
+    void *userData = scene->GetContext().userData;
+    if (userData == nullptr) return g_gameCommon;
+    return *static_cast<GameCommon *>(userData);
+}
+
 void InitInputConfig(InputManager* inputManager)
 {
     ApplicationInput* applicationInput = new ApplicationInput();
@@ -175,6 +182,6 @@ void InitInputConfig(InputManager* inputManager)
 float game::GetUIPixelScale(Scene* scene)
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(scene->GetRenderer(), &viewport);
     return fmaxf(1.f, roundf(4.f * viewport.w / 1920.0f));
 }
@@ -111,6 +111,10 @@ public:
 
     void UpdatePlayerConfigs();
     void ResetPlayerStats();
+
+    /// @brief Renvoie la configuration du match joué dans la scène :
+    /// celle du contexte de la scène si elle en a une, g_gameCommon sinon.
+    static GameCommon &GetFromScene(Scene *scene);
 };
 
 extern GameCommon g_gameCommon;
@@ -0,0 +1,61 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "common/loading_screen.h"
+#include "common/game_assets.h"
+
+LoadingScreen::LoadingScreen(SDL_Renderer *renderer)
+    : m_renderer(renderer)
+    , m_lastRenderNS(0)
+{
+}
+
+void LoadingScreen::Render(const AssetManager::LoadingProgress &progress)
+{
+    if (m_renderer == nullptr) return;
+
+    // La dernière étape est toujours affichée
+    const Uint64 timeNS = SDL_GetTicksNS();
+    const bool lastStep = (progress.loadedCount >= progress.totalCount);
+    if (lastStep == false && timeNS - m_lastRenderNS < MIN_RENDER_INTERVAL_NS) return;
+    m_lastRenderNS = timeNS;
+
+    // Garde la fenêtre réactive pendant le chargement
+    SDL_PumpEvents();
+
+    int width = 0, height = 0;
+    SDL_RendererLogicalPresentation mode = SDL_LOGICAL_PRESENTATION_DISABLED;
+    SDL_GetRenderLogicalPresentation(m_renderer, &width, &height, &mode);
+    if (width <= 0 || height <= 0)
+    {
+        SDL_GetCurrentRenderOutputSize(m_renderer, &width, &height);
+    }
+
+    const float ratio = progress.totalCount > 0 ?
+        (float)progress.loadedCount / (float)progress.totalCount : 1.f;
+    const SDL_FRect frameRect = {
+        0.25f * width, 0.5f * height - 10.f, 0.5f * width, 20.f
+    };
+    const SDL_FRect barRect = {
+        frameRect.x + 4.f, frameRect.y + 4.f, ratio * (frameRect.w - 8.f), frameRect.h - 8.f
+    };
+
+    const Color &background = Colors::DarkBlue;
+    const Color &foreground = Colors::Gold;
+    SDL_SetRenderDrawColor(m_renderer, background.r, background.g, background.b, 255);
+    SDL_RenderClear(m_renderer);
+    SDL_SetRenderDrawColor(m_renderer, foreground.r, foreground.g, foreground.b, 255);
+    SDL_RenderRect(m_renderer, &frameRect);
+    SDL_RenderFillRect(m_renderer, &barRect);
+    SDL_RenderPresent(m_renderer);
+}
+
+AssetManager::LoadingCallback LoadingScreen::GetCallback()
+{
+    if (m_renderer == nullptr) return nullptr;
+
+    return [this](const AssetManager::LoadingProgress &progress) { Render(progress); };
+}
@@ -0,0 +1,35 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+
+/// @brief Écran affiché pendant le chargement des assets d'une scène.
+/// Il est rendu depuis la fonction de progression de
+/// AssetManager::LoadSpriteSheets(), sur le thread du moteur de rendu.
+class LoadingScreen
+{
+public:
+    /// @param renderer le moteur de rendu. S'il est nul, rien n'est affiché.
+    LoadingScreen(SDL_Renderer *renderer);
+    LoadingScreen(LoadingScreen const&) = delete;
+    LoadingScreen& operator=(LoadingScreen const&) = delete;
+
+    void Render(const AssetManager::LoadingProgress &progress);
+
+    /// @brief Renvoie la fonction de progression à donner au gestionnaire
+    /// des ressources, ou nullptr sans moteur de rendu.
+    AssetManager::LoadingCallback GetCallback();
+
+    /// @brief Intervalle minimal entre deux affichages : avec la synchronisation
+    /// verticale, chaque affichage peut bloquer jusqu'à une image.
+    static constexpr Uint64 MIN_RENDER_INTERVAL_NS = SDL_NS_PER_SECOND / 60;
+
+private:
+    SDL_Renderer *m_renderer;
+    Uint64 m_lastRenderNS;
+};
@@ -0,0 +1,239 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "common/match_bench.h"
+#include "scene_manager/stage_manager.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    cJSON *StatsToJSON(const SystemProfiler::Stats &stats)
+    {
+        cJSON *jStats = cJSON_CreateObject();
+        cJSON_AddStringToObject(jStats, "name", stats.name.c_str());
+        cJSON_AddNumberToObject(jStats, "samples", stats.sampleCount);
+        cJSON_AddNumberToObject(jStats, "mean_us", stats.meanUS);
+        cJSON_AddNumberToObject(jStats, "p99_us", stats.p99US);
+        cJSON_AddNumberToObject(jStats, "max_us", stats.maxUS);
+        return jStats;
+    }
+
+    double GetNumber(cJSON *jObject, const char *name)
+    {
+        return cJSON_GetNumberValue(cJSON_GetObjectItem(jObject, name));
+    }
+
+    /// @brief Affiche une comparaison et indique s'il s'agit d'une régression.
+    /// @param higherIsBetter vrai pour un débit, faux pour une durée.
+    bool CompareValue(const std::string &name, double reference, double value,
+        double thresholdPercent, bool higherIsBetter)
+    {
+        double change = reference > 0.0 ? 100.0 * (value - reference) / reference : 0.0;
+        if (higherIsBetter) change = -change;
+        const bool regression = change > thresholdPercent;
+
+        std::cout << "  " << std::left << std::setw(36) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << reference << " -> " << std::setw(12) << value
+            << " (" << std::showpos << std::setprecision(1) << change << std::noshowpos << " % slower)"
+            << (regression ? " REGRESSION" : "") << std::endl;
+        return regression;
+    }
+}
+
+MatchBench::Config::Config()
+    : tickCount(60 * 60)
+    , seed(12345)
+    , tickRate(SceneContext::DEFAULT_TICK_RATE)
+{
+}
+
+MatchBench::MatchBench(const GameCommon &gameCommon, const Config &config)
+    : m_gameCommon(gameCommon)
+    , m_config(config)
+    , m_profiler()
+    , m_tickCount(0)
+    , m_wallTimeMS(0.0)
+{
+    // Quatre IA, chacune avec un personnage différent
+    const PlayerType types[] = {
+        PlayerType::FIRE_KNIGHT, PlayerType::WATER_PRIESTESS,
+        PlayerType::LEAF_RANGER, PlayerType::METAL_BLADEKEEPER
+    };
+    m_gameCommon.playerCount = MAX_PLAYER_COUNT;
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        PlayerConfig *playerConfig = m_gameCommon.GetPlayerConfig(i);
+        playerConfig->type = types[i % 4];
+        playerConfig->playerID = i;
+        playerConfig->teamID = i;
+        playerConfig->skinID = 0;
+        playerConfig->isCPU = true;
+    }
+
+    // Match limité en temps, plus long que la mesure
+    const float durationS = (float)m_config.tickCount / m_config.tickRate;
+    StageConfig &stageConfig = m_gameCommon.stageConfig;
+    stageConfig.mode = StageConfig::Mode::LIMITED_TIME;
+    stageConfig.duration = (int)(durationS / 60.f) + 1;
+    stageConfig.bombsFrequency = StageConfig::Frequency::OFTEN;
+    stageConfig.potionFrequency = StageConfig::Frequency::OFTEN;
+
+    m_gameCommon.UpdatePlayerConfigs();
+}
+
+void MatchBench::Run()
+{
+    m_profiler.Clear();
+
+    InputManager inputManager(false);
+    InitInputConfig(&inputManager);
+
+    SceneContext context = SceneContext::Headless(&m_gameCommon);
+    context.seed = m_config.seed;
+    context.tickRate = m_config.tickRate;
+    StageManager stageManager(&inputManager, nullptr, nullptr, context);
+
+    Scene *scene = stageManager.GetScene();
+    scene->SetStateHashEnabled(false);
+    scene->SetSystemProfiler(&m_profiler);
+
+    const Uint64 timeStepNS = scene->GetTimeStepNS();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    while (stageManager.ShouldQuitScene() == false)
+    {
+        if ((int)scene->GetFixedStepCount() >= m_config.tickCount) break;
+
+        scene->SetNextDeltaNS(timeStepNS);
+        scene->Update();
+    }
+    m_wallTimeMS = 1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+        / (double)SDL_GetPerformanceFrequency();
+    m_tickCount = (int)scene->GetFixedStepCount();
+
+    scene->SetSystemProfiler(nullptr);
+}
+
+float MatchBench::GetTicksPerSecond() const
+{
+    return m_wallTimeMS > 0.0 ? (float)(1000.0 * m_tickCount / m_wallTimeMS) : 0.f;
+}
+
+void MatchBench::PrintReport() const
+{
+    const SystemProfiler::Stats tickStats = m_profiler.GetTickStats();
+    std::cout << "Match benchmark (seed " << m_config.seed << ")" << std::endl;
+    std::cout << "  ticks         : " << m_tickCount << std::endl;
+    std::cout << "  wall time     : " << m_wallTimeMS << " ms" << std::endl;
+    std::cout << "  ticks/s       : " << GetTicksPerSecond() << std::endl;
+
+    std::cout << "  " << std::left << std::setw(36) << "system"
+        << std::right << std::setw(12) << "mean us"
+        << std::setw(12) << "p99 us" << std::setw(12) << "max us" << std::endl;
+
+    std::vector<SystemProfiler::Stats> allStats = m_profiler.GetSystemStats();
+    allStats.push_back(tickStats);
+    for (const SystemProfiler::Stats &stats : allStats)
+    {
+        std::cout << "  " << std::left << std::setw(36) << stats.name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << stats.meanUS
+            << std::setw(12) << stats.p99US
+            << std::setw(12) << stats.maxUS << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+bool MatchBench::SaveJSON(const std::string &path) const
+{
+    cJSON *jRoot = cJSON_CreateObject();
+    cJSON_AddNumberToObject(jRoot, "seed", (double)m_config.seed);
+    cJSON_AddNumberToObject(jRoot, "ticks", m_tickCount);
+    cJSON_AddNumberToObject(jRoot, "ticks_per_second", GetTicksPerSecond());
+    cJSON_AddItemToObject(jRoot, "tick", StatsToJSON(m_profiler.GetTickStats()));
+
+    cJSON *jSystems = cJSON_AddArrayToObject(jRoot, "systems");
+    for (const SystemProfiler::Stats &stats : m_profiler.GetSystemStats())
+    {
+        cJSON_AddItemToArray(jSystems, StatsToJSON(stats));
+    }
+
+    char *text = cJSON_Print(jRoot);
+    cJSON_Delete(jRoot);
+
+    std::ofstream file(path);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't write the match benchmark " << path << std::endl;
+        cJSON_free(text);
+        return false;
+    }
+    file << text << "\n";
+    cJSON_free(text);
+    return true;
+}
+
+bool MatchBench::Compare(const std::string &baselinePath, double thresholdPercent) const
+{
+    std::ifstream file(baselinePath);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't read the match benchmark " << baselinePath << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    cJSON *jRoot = cJSON_ParseWithLength(text.c_str(), text.size());
+    cJSON *jTick = cJSON_GetObjectItem(jRoot, "tick");
+    cJSON *jSystems = cJSON_GetObjectItem(jRoot, "systems");
+    if (cJSON_IsObject(jTick) == false || cJSON_IsArray(jSystems) == false)
+    {
+        std::cout << "ERROR - Invalid match benchmark " << baselinePath << std::endl;
+        cJSON_Delete(jRoot);
+        return false;
+    }
+    if ((int)GetNumber(jRoot, "ticks") != m_tickCount)
+    {
+        std::cout << "WARNING - The baseline has " << (int)GetNumber(jRoot, "ticks")
+            << " ticks instead of " << m_tickCount << std::endl;
+    }
+
+    std::cout << "Comparison with " << baselinePath
+        << " (threshold " << thresholdPercent << " %)" << std::endl;
+
+    int regressionCount = 0;
+    const SystemProfiler::Stats tickStats = m_profiler.GetTickStats();
+    regressionCount += CompareValue("ticks/s", GetNumber(jRoot, "ticks_per_second"),
+        GetTicksPerSecond(), thresholdPercent, true);
+    regressionCount += CompareValue("Tick mean us", GetNumber(jTick, "mean_us"),
+        tickStats.meanUS, thresholdPercent, false);
+    regressionCount += CompareValue("Tick p99 us", GetNumber(jTick, "p99_us"),
+        tickStats.p99US, thresholdPercent, false);
+
+    for (const SystemProfiler::Stats &stats : m_profiler.GetSystemStats())
+    {
+        cJSON *jSystem = nullptr;
+        cJSON_ArrayForEach(jSystem, jSystems)
+        {
+            cJSON *jName = cJSON_GetObjectItem(jSystem, "name");
+            if (cJSON_IsString(jName) && stats.name == jName->valuestring) break;
+        }
+        if (jSystem == nullptr) continue;
+
+        const double referenceUS = GetNumber(jSystem, "mean_us");
+        if (referenceUS < MIN_COMPARED_US) continue;
+
+        regressionCount += CompareValue(stats.name, referenceUS, stats.meanUS, thresholdPercent, false);
+    }
+    cJSON_Delete(jRoot);
+
+    std::cout << regressionCount << " regression(s)" << std::endl << std::defaultfloat;
+    return regressionCount == 0;
+}
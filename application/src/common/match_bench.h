@@ -0,0 +1,60 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+
+/// @brief Mesure les performances d'un vrai match entre quatre IA, sans rendu ni son.
+///
+/// Le match utilise une graine fixe, des bombes et des potions fréquentes,
+/// et avance d'un nombre fixe de pas. Le temps de chaque système de simulation
+/// est mesuré à chaque pas (SystemProfiler). Les résultats peuvent être écrits
+/// dans un fichier JSON puis servir de référence pour détecter les régressions.
+class MatchBench
+{
+public:
+    struct Config
+    {
+        Config();
+
+        int tickCount;
+        uint64_t seed;
+        float tickRate;
+    };
+
+    /// @brief Prépare le match.
+    /// @param gameCommon la configuration de départ. Le nombre de joueurs,
+    /// leurs personnages et les réglages du niveau sont remplacés.
+    MatchBench(const GameCommon &gameCommon, const Config &config);
+    MatchBench(MatchBench const&) = delete;
+    MatchBench& operator=(MatchBench const&) = delete;
+
+    void Run();
+    void PrintReport() const;
+
+    bool SaveJSON(const std::string &path) const;
+
+    /// @brief Compare les mesures à une référence écrite avec SaveJSON().
+    /// La durée moyenne et le 99e centile d'un pas sont toujours comparés.
+    /// Un système n'est comparé que si sa durée moyenne de référence dépasse
+    /// MIN_COMPARED_US : en dessous, les variations sont surtout du bruit.
+    /// @return false si une régression dépasse le seuil ou si la référence est invalide.
+    bool Compare(const std::string &baselinePath, double thresholdPercent) const;
+
+    /// @brief Durée moyenne minimale (en microsecondes) d'un système comparé.
+    static constexpr double MIN_COMPARED_US = 5.0;
+
+    float GetTicksPerSecond() const;
+
+private:
+    GameCommon m_gameCommon;
+    Config m_config;
+    SystemProfiler m_profiler;
+    int m_tickCount;
+    double m_wallTimeMS;
+};
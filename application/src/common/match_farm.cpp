@@ -0,0 +1,151 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "common/match_farm.h"
+#include "scene_manager/stage_manager.h"
+
+MatchFarm::Config::Config()
+    : matchCount(8)
+    , threadCount(0)
+    , seed(1)
+    , maxTicks(60 * 60 * 5)
+    , tickRate(SceneContext::DEFAULT_TICK_RATE)
+{
+}
+
+MatchFarm::MatchResult::MatchResult()
+    : seed(0)
+    , tickCount(0)
+    , finished(false)
+    , gameTimeS(0.f)
+    , wallTimeMS(0.f)
+    , playerStats{}
+{
+}
+
+MatchFarm::MatchFarm(const GameCommon &gameCommon, const Config &config)
+    : m_gameCommon(gameCommon)
+    , m_config(config)
+    , m_results()
+    , m_wallTimeMS(0.f)
+{
+    for (int i = 0; i < m_gameCommon.playerCount; i++)
+    {
+        m_gameCommon.GetPlayerConfig(i)->isCPU = true;
+    }
+    m_gameCommon.UpdatePlayerConfigs();
+}
+
+void MatchFarm::Run()
+{
+    const int matchCount = std::max(0, m_config.matchCount);
+    m_results.assign(matchCount, MatchResult());
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    {
+        ThreadPool threadPool(m_config.threadCount);
+        for (int i = 0; i < matchCount; i++)
+        {
+            // Chaque tâche écrit uniquement dans son propre résultat
+            threadPool.Submit([this, i]()
+            {
+                m_results[i] = PlayMatch(
+                    m_gameCommon, m_config.seed + i, m_config.maxTicks, m_config.tickRate);
+            });
+        }
+        threadPool.Wait();
+    }
+    m_wallTimeMS = (float)(1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+        / (double)SDL_GetPerformanceFrequency());
+}
+
+MatchFarm::MatchResult MatchFarm::PlayMatch(
+    const GameCommon &gameCommon, uint64_t seed, int maxTicks, float tickRate)
+{
+    MatchResult result;
+    result.seed = seed;
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    // Copie propre au match, partagée par tous ses systèmes via le contexte
+    GameCommon matchCommon = gameCommon;
+
+    // Les manettes appartiennent au thread principal
+    InputManager inputManager(false);
+    InitInputConfig(&inputManager);
+
+    SceneContext context = SceneContext::Headless(&matchCommon);
+    context.seed = seed;
+    context.tickRate = tickRate;
+    StageManager stageManager(&inputManager, nullptr, nullptr, context);
+
+    Scene *scene = stageManager.GetScene();
+    const Uint64 timeStepNS = scene->GetTimeStepNS();
+    while (stageManager.ShouldQuitScene() == false)
+    {
+        if ((int)scene->GetFixedStepCount() >= maxTicks) break;
+
+        scene->SetNextDeltaNS(timeStepNS);
+        scene->Update();
+    }
+
+    result.tickCount = (int)scene->GetFixedStepCount();
+    result.finished = stageManager.ShouldQuitScene();
+    result.gameTimeS = (float)((double)(result.tickCount * timeStepNS) / 1e9);
+    result.playerStats = matchCommon.playerStats;
+    result.wallTimeMS = (float)(1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+        / (double)SDL_GetPerformanceFrequency());
+    return result;
+}
+
+void MatchFarm::PrintSummary() const
+{
+    const int matchCount = (int)m_results.size();
+    if (matchCount == 0) return;
+
+    int finishedCount = 0;
+    int64_t tickCount = 0;
+    double gameTimeS = 0.0;
+    for (const MatchResult &result : m_results)
+    {
+        if (result.finished) finishedCount++;
+        tickCount += result.tickCount;
+        gameTimeS += result.gameTimeS;
+    }
+
+    std::cout << "Match farm" << std::endl;
+    std::cout << "  matches       : " << matchCount
+        << " (" << finishedCount << " finished)" << std::endl;
+    std::cout << "  fixed updates : " << tickCount << std::endl;
+    std::cout << "  wall time     : " << m_wallTimeMS << " ms" << std::endl;
+    if (m_wallTimeMS > 0.f)
+    {
+        std::cout << "  speed         : " << 1000.0 * gameTimeS / m_wallTimeMS
+            << "x real time" << std::endl;
+    }
+
+    for (int i = 0; i < m_gameCommon.playerCount; i++)
+    {
+        PlayerStats total;
+        for (const MatchResult &result : m_results)
+        {
+            const PlayerStats &stats = result.playerStats[i];
+            total.fallCount += stats.fallCount;
+            total.koCount += stats.koCount;
+            total.damageGiven += stats.damageGiven;
+            total.damageTaken += stats.damageTaken;
+            total.maxSpeed = std::max(total.maxSpeed, stats.maxSpeed);
+        }
+
+        const float n = (float)matchCount;
+        std::cout << "  player " << i
+            << " : ko " << total.koCount << " (" << total.koCount / n << "/match)"
+            << ", falls " << total.fallCount << " (" << total.fallCount / n << "/match)"
+            << ", damage " << total.damageGiven / n << "/" << total.damageTaken / n << " per match"
+            << ", max speed " << total.maxSpeed
+            << std::endl;
+    }
+}
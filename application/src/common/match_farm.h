@@ -0,0 +1,87 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+
+/// @brief Joue plusieurs matchs entre IA en parallèle, sans rendu ni son.
+///
+/// Chaque match possède sa propre scène, son gestionnaire des entrées et
+/// une copie de la configuration (GameCommon) transmise par le contexte
+/// de la scène : les matchs sont indépendants et s'exécutent sur les threads
+/// d'un ThreadPool. La scène avance au pas fixe, sans attendre l'horloge.
+class MatchFarm
+{
+public:
+    struct Config
+    {
+        Config();
+
+        int matchCount;
+
+        /// @brief Nombre de threads (0 pour le nombre de cœurs).
+        int threadCount;
+
+        /// @brief Graine du premier match, les suivants utilisent seed + i.
+        uint64_t seed;
+
+        /// @brief Nombre maximal de pas fixes d'un match.
+        int maxTicks;
+
+        /// @brief Fréquence de la simulation, en pas fixes par seconde.
+        float tickRate;
+    };
+
+    struct MatchResult
+    {
+        MatchResult();
+
+        uint64_t seed;
+        int tickCount;
+
+        /// @brief Indique si le match s'est terminé avant maxTicks.
+        bool finished;
+
+        /// @brief Temps de jeu simulé, en secondes.
+        float gameTimeS;
+        float wallTimeMS;
+        std::array<PlayerStats, MAX_PLAYER_COUNT> playerStats;
+    };
+
+    /// @brief Crée la ferme de matchs.
+    /// @param gameCommon la configuration des matchs. Tous les joueurs
+    /// sont contrôlés par une IA.
+    MatchFarm(const GameCommon &gameCommon, const Config &config);
+
+    /// @brief Joue tous les matchs et attend leur fin.
+    void Run();
+
+    /// @brief Affiche les statistiques de chaque joueur, cumulées sur tous les matchs.
+    void PrintSummary() const;
+
+    const std::vector<MatchResult> &GetResults() const;
+    float GetWallTimeMS() const;
+
+private:
+    GameCommon m_gameCommon;
+    Config m_config;
+    std::vector<MatchResult> m_results;
+    float m_wallTimeMS;
+
+    static MatchResult PlayMatch(const GameCommon &gameCommon, uint64_t seed, int maxTicks, float tickRate);
+};
+
+inline const std::vector<MatchFarm::MatchResult> &MatchFarm::GetResults() const
+{
+    return m_results;
+}
+
+inline float MatchFarm::GetWallTimeMS() const
+{
+    return m_wallTimeMS;
+}
@@ -0,0 +1,374 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "common/match_replay.h"
+#include "ecs/player/player_components.h"
+
+namespace
+{
+    const char REPLAY_MAGIC[4] = { 'S', 'P', 'S', 'R' };
+    const Uint16 REPLAY_VERSION = 2;
+
+    uint32_t FloatToBits(float value)
+    {
+        uint32_t bits = 0;
+        memcpy(&bits, &value, sizeof(float));
+        return bits;
+    }
+
+    float BitsToFloat(uint32_t bits)
+    {
+        float value = 0.f;
+        memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+}
+
+MatchReplay::MatchReplay()
+    : m_mode(Mode::NONE)
+    , m_seed(0)
+    , m_tickRate(0.f)
+    , m_desync(false)
+    , m_finished(false)
+    , m_playerCount(0)
+    , m_players{}
+    , m_stageConfig()
+    , m_frameDeltas()
+    , m_inputs()
+    , m_fixedUpdateCount(0)
+    , m_frameIdx(0)
+    , m_readPos(0)
+    , m_prevFlags{}
+    , m_prevDirection{}
+{
+}
+
+void MatchReplay::StartRecording(unsigned int seed, float tickRate)
+{
+    m_mode = Mode::RECORD;
+    m_seed = seed;
+    m_tickRate = tickRate;
+    m_desync = false;
+    m_frameDeltas.clear();
+    m_inputs.clear();
+    m_fixedUpdateCount = 0;
+
+    m_playerCount = g_gameCommon.playerCount;
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        const PlayerConfig &config = g_gameCommon.playerConfigs[i];
+        PlayerRecord &player = m_players[i];
+        player.enabled = config.enabled;
+        player.isCPU = config.isCPU;
+        player.type = (uint8_t)config.type;
+        player.skinID = (uint8_t)config.skinID;
+        player.teamID = (uint8_t)config.teamID;
+        player.level = (uint8_t)config.level;
+    }
+    m_stageConfig = g_gameCommon.stageConfig;
+
+    ResetCursors();
+}
+
+void MatchReplay::StartPlayback()
+{
+    m_mode = Mode::PLAYBACK;
+    m_desync = false;
+
+    g_gameCommon.playerCount = m_playerCount;
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        PlayerConfig &config = g_gameCommon.playerConfigs[i];
+        const PlayerRecord &player = m_players[i];
+        config.playerID = i;
+        config.enabled = player.enabled;
+        config.isCPU = player.isCPU;
+        config.type = (PlayerType)player.type;
+        config.skinID = player.skinID;
+        config.teamID = player.teamID;
+        config.level = player.level;
+    }
+    g_gameCommon.stageConfig = m_stageConfig;
+    g_gameCommon.UpdatePlayerConfigs();
+
+    ResetCursors();
+}
+
+void MatchReplay::ResetCursors()
+{
+    PlayerControllerInput defaultInput;
+    m_frameIdx = 0;
+    m_readPos = 0;
+    m_finished = false;
+    m_prevFlags.fill(PlayerInputUtils::EncodeFlags(defaultInput));
+    m_prevDirection.fill(defaultInput.direction);
+}
+
+void MatchReplay::Desync(const char *reason)
+{
+    if (m_desync == false)
+    {
+        std::cout << "ERROR - Replay desync at frame " << m_frameIdx
+            << " (" << reason << ")" << std::endl;
+    }
+    m_desync = true;
+}
+
+void MatchReplay::RecordFrame(Uint64 deltaNS)
+{
+    assert(m_mode == Mode::RECORD);
+
+    // Le timer de la scène limite l'écart de temps à 100 ms
+    m_frameDeltas.push_back((Uint32)std::min<Uint64>(deltaNS, UINT32_MAX));
+}
+
+bool MatchReplay::NextFrame(Uint64 &deltaNS)
+{
+    assert(m_mode == Mode::PLAYBACK);
+
+    if (m_frameIdx >= m_frameDeltas.size())
+    {
+        m_finished = true;
+        return false;
+    }
+
+    deltaNS = m_frameDeltas[m_frameIdx++];
+    return true;
+}
+
+void MatchReplay::RecordInputs(Sample type, const PlayerControllerInput *const inputs[MAX_PLAYER_COUNT])
+{
+    assert(m_mode == Mode::RECORD);
+
+    uint8_t presentMask = 0;
+    uint8_t changedMask = 0;
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        if (inputs[i] == nullptr) continue;
+        presentMask |= 1 << i;
+
+        const uint8_t flags = PlayerInputUtils::EncodeFlags(*inputs[i]);
+        if (flags != m_prevFlags[i] ||
+            FloatToBits(inputs[i]->direction) != FloatToBits(m_prevDirection[i]))
+        {
+            changedMask |= 1 << i;
+        }
+    }
+
+    // En-tête : type de l'échantillon, joueurs présents, joueurs modifiés
+    m_inputs.push_back(((uint8_t)type << 4) | presentMask);
+    m_inputs.push_back(changedMask);
+
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        if ((changedMask & (1 << i)) == 0) continue;
+
+        m_prevFlags[i] = PlayerInputUtils::EncodeFlags(*inputs[i]);
+        m_prevDirection[i] = inputs[i]->direction;
+
+        const uint32_t bits = FloatToBits(m_prevDirection[i]);
+        m_inputs.push_back(m_prevFlags[i]);
+        m_inputs.push_back((uint8_t)(bits >> 0));
+        m_inputs.push_back((uint8_t)(bits >> 8));
+        m_inputs.push_back((uint8_t)(bits >> 16));
+        m_inputs.push_back((uint8_t)(bits >> 24));
+    }
+
+    if (type == Sample::FIXED_UPDATE) m_fixedUpdateCount++;
+}
+
+bool MatchReplay::PlayInputs(Sample type, PlayerControllerInput *inputs[MAX_PLAYER_COUNT])
+{
+    assert(m_mode == Mode::PLAYBACK);
+    if (m_desync) return false;
+
+    if (m_readPos + 2 > m_inputs.size())
+    {
+        Desync("end of input stream");
+        return false;
+    }
+
+    const uint8_t header = m_inputs[m_readPos++];
+    const uint8_t changedMask = m_inputs[m_readPos++];
+
+    uint8_t presentMask = 0;
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        if (inputs[i]) presentMask |= 1 << i;
+    }
+
+    if ((header >> 4) != (uint8_t)type)
+    {
+        Desync("unexpected sample type");
+        return false;
+    }
+    if ((header & 0xF) != presentMask)
+    {
+        Desync("different players");
+        return false;
+    }
+
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        if ((changedMask & (1 << i)) != 0)
+        {
+            if (m_readPos + 5 > m_inputs.size())
+            {
+                Desync("truncated input");
+                return false;
+            }
+            const uint8_t *data = m_inputs.data() + m_readPos;
+            const uint32_t bits =
+                ((uint32_t)data[1] << 0) | ((uint32_t)data[2] << 8) |
+                ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+            m_prevFlags[i] = data[0];
+            m_prevDirection[i] = BitsToFloat(bits);
+            m_readPos += 5;
+        }
+
+        if (inputs[i] == nullptr) continue;
+
+        PlayerInputUtils::DecodeFlags(m_prevFlags[i], *inputs[i]);
+        inputs[i]->direction = m_prevDirection[i];
+    }
+
+    if (type == Sample::FIXED_UPDATE) m_fixedUpdateCount++;
+    return true;
+}
+
+bool MatchReplay::Save(const std::string &path) const
+{
+    SDL_IOStream *io = SDL_IOFromFile(path.c_str(), "wb");
+    if (io == nullptr)
+    {
+        std::cout << "ERROR - Save replay " << path << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    bool success = true;
+    success &= SDL_WriteIO(io, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) == sizeof(REPLAY_MAGIC);
+    success &= SDL_WriteU16LE(io, REPLAY_VERSION);
+    success &= SDL_WriteU32LE(io, (Uint32)m_seed);
+    success &= SDL_WriteU32LE(io, FloatToBits(m_tickRate));
+
+    // Configuration
+    success &= SDL_WriteU8(io, (Uint8)m_playerCount);
+    for (const PlayerRecord &player : m_players)
+    {
+        success &= SDL_WriteU8(io, player.enabled ? 1 : 0);
+        success &= SDL_WriteU8(io, player.isCPU ? 1 : 0);
+        success &= SDL_WriteU8(io, player.type);
+        success &= SDL_WriteU8(io, player.skinID);
+        success &= SDL_WriteU8(io, player.teamID);
+        success &= SDL_WriteU8(io, player.level);
+    }
+    success &= SDL_WriteU8(io, (Uint8)m_stageConfig.type);
+    success &= SDL_WriteU8(io, (Uint8)m_stageConfig.mode);
+    success &= SDL_WriteU8(io, (Uint8)m_stageConfig.bombsFrequency);
+    success &= SDL_WriteU8(io, (Uint8)m_stageConfig.potionFrequency);
+    success &= SDL_WriteS32LE(io, (Sint32)m_stageConfig.duration);
+    success &= SDL_WriteS32LE(io, (Sint32)m_stageConfig.lifeCount);
+
+    // Frames et entrées
+    success &= SDL_WriteU32LE(io, (Uint32)m_frameDeltas.size());
+    for (Uint32 deltaNS : m_frameDeltas)
+    {
+        success &= SDL_WriteU32LE(io, deltaNS);
+    }
+    success &= SDL_WriteU32LE(io, (Uint32)m_inputs.size());
+    success &= SDL_WriteIO(io, m_inputs.data(), m_inputs.size()) == m_inputs.size();
+
+    success &= SDL_CloseIO(io);
+    if (success == false)
+    {
+        std::cout << "ERROR - Save replay " << path << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+    }
+    return success;
+}
+
+bool MatchReplay::Load(const std::string &path)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path.c_str(), "rb");
+    if (io == nullptr)
+    {
+        std::cout << "ERROR - Load replay " << path << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    char magic[4] = { 0 };
+    Uint16 version = 0;
+    Uint32 seed = 0;
+    Uint8 u8 = 0;
+    Sint32 s32 = 0;
+    Uint32 size = 0;
+
+    bool success = true;
+    success &= SDL_ReadIO(io, magic, sizeof(magic)) == sizeof(magic);
+    success &= memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0;
+    success &= SDL_ReadU16LE(io, &version);
+    success &= version == REPLAY_VERSION;
+    success &= SDL_ReadU32LE(io, &seed);
+    m_seed = seed;
+    Uint32 tickRateBits = 0;
+    success &= SDL_ReadU32LE(io, &tickRateBits);
+    m_tickRate = BitsToFloat(tickRateBits);
+    success &= m_tickRate > 0.f;
+
+    // Configuration
+    success &= SDL_ReadU8(io, &u8);
+    m_playerCount = std::min<int>(u8, MAX_PLAYER_COUNT);
+    for (PlayerRecord &player : m_players)
+    {
+        success &= SDL_ReadU8(io, &u8); player.enabled = (u8 != 0);
+        success &= SDL_ReadU8(io, &u8); player.isCPU = (u8 != 0);
+        success &= SDL_ReadU8(io, &player.type);
+        success &= SDL_ReadU8(io, &player.skinID);
+        success &= SDL_ReadU8(io, &player.teamID);
+        success &= SDL_ReadU8(io, &player.level);
+    }
+    success &= SDL_ReadU8(io, &u8); m_stageConfig.type = (StageConfig::Type)u8;
+    success &= SDL_ReadU8(io, &u8); m_stageConfig.mode = (StageConfig::Mode)u8;
+    success &= SDL_ReadU8(io, &u8); m_stageConfig.bombsFrequency = (StageConfig::Frequency)u8;
+    success &= SDL_ReadU8(io, &u8); m_stageConfig.potionFrequency = (StageConfig::Frequency)u8;
+    success &= SDL_ReadS32LE(io, &s32); m_stageConfig.duration = s32;
+    success &= SDL_ReadS32LE(io, &s32); m_stageConfig.lifeCount = s32;
+
+    // Frames et entrées
+    success &= SDL_ReadU32LE(io, &size);
+    if (success)
+    {
+        m_frameDeltas.resize(size);
+        for (Uint32 &deltaNS : m_frameDeltas)
+        {
+            success &= SDL_ReadU32LE(io, &deltaNS);
+        }
+    }
+    success &= SDL_ReadU32LE(io, &size);
+    if (success)
+    {
+        m_inputs.resize(size);
+        success &= SDL_ReadIO(io, m_inputs.data(), size) == size;
+    }
+
+    SDL_CloseIO(io);
+
+    if (success == false)
+    {
+        std::cout << "ERROR - Load replay " << path << std::endl
+            << "      - Invalid or corrupted file" << std::endl;
+        m_frameDeltas.clear();
+        m_inputs.clear();
+        return false;
+    }
+
+    m_mode = Mode::NONE;
+    m_fixedUpdateCount = 0;
+    ResetCursors();
+    return true;
+}
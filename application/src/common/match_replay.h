@@ -0,0 +1,175 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+
+struct PlayerControllerInput;
+
+/// @brief Enregistrement d'un match pour pouvoir le rejouer à l'identique.
+/// Le fichier contient la graine du générateur aléatoire, la configuration
+/// de g_gameCommon, la fréquence de la simulation, l'écart de temps
+/// (en nanosecondes) de chaque frame et les entrées
+/// PlayerControllerInput de chaque joueur à chaque pas fixe et à chaque frame.
+/// Les entrées sont codées par différence avec l'échantillon précédent.
+class MatchReplay
+{
+public:
+    MatchReplay();
+
+    enum class Mode : int
+    {
+        NONE, RECORD, PLAYBACK
+    };
+
+    enum class Sample : uint8_t
+    {
+        /// @brief Entrées lues par les systèmes pendant un pas fixe.
+        FIXED_UPDATE = 1,
+        /// @brief Entrées lues par les systèmes pendant une frame.
+        UPDATE = 2
+    };
+
+    Mode GetMode() const;
+    bool IsRecording() const;
+    bool IsPlaying() const;
+
+    /// @brief Indique si la lecture a détecté une désynchronisation
+    /// (échantillon inattendu ou joueurs différents).
+    bool HasDesync() const;
+
+    /// @brief Indique si toutes les frames enregistrées ont été rejouées.
+    /// Le résultat devient vrai quand NextFrame() ne trouve plus de frame.
+    bool IsFinished() const;
+
+    unsigned int GetSeed() const;
+
+    /// @brief Renvoie la fréquence de la simulation enregistrée (pas fixes par seconde).
+    float GetTickRate() const;
+    int GetFrameCount() const;
+    int GetFixedUpdateCount() const;
+    size_t GetDataSize() const;
+
+    /// @brief Commence un nouvel enregistrement.
+    /// La configuration actuelle de g_gameCommon est sauvegardée.
+    /// @param seed la graine utilisée pour le générateur aléatoire.
+    /// @param tickRate la fréquence de la simulation.
+    void StartRecording(unsigned int seed, float tickRate);
+
+    /// @brief Commence la lecture d'un enregistrement chargé avec Load().
+    /// La configuration enregistrée est appliquée à g_gameCommon.
+    void StartPlayback();
+
+    /// @brief Ajoute l'écart de temps de la frame courante (en nanosecondes).
+    void RecordFrame(Uint64 deltaNS);
+
+    /// @brief Renvoie l'écart de temps de la prochaine frame à rejouer.
+    /// @param[out] deltaNS l'écart de temps en nanosecondes.
+    /// @return false si toutes les frames ont été rejouées.
+    bool NextFrame(Uint64 &deltaNS);
+
+    /// @brief Enregistre les entrées des joueurs.
+    /// @param type le moment de la mise à jour.
+    /// @param inputs les entrées indexées par playerID (nullptr si le joueur est absent).
+    void RecordInputs(Sample type, const PlayerControllerInput *const inputs[MAX_PLAYER_COUNT]);
+
+    /// @brief Remplace les entrées des joueurs par celles de l'enregistrement.
+    /// @param type le moment de la mise à jour.
+    /// @param inputs les entrées indexées par playerID (nullptr si le joueur est absent).
+    /// @return false en cas de désynchronisation.
+    bool PlayInputs(Sample type, PlayerControllerInput *inputs[MAX_PLAYER_COUNT]);
+
+    /// @brief Ecrit l'enregistrement dans un fichier binaire.
+    bool Save(const std::string &path) const;
+
+    /// @brief Charge un enregistrement depuis un fichier binaire.
+    bool Load(const std::string &path);
+
+private:
+    struct PlayerRecord
+    {
+        bool enabled;
+        bool isCPU;
+        uint8_t type;
+        uint8_t skinID;
+        uint8_t teamID;
+        uint8_t level;
+    };
+
+    Mode m_mode;
+    unsigned int m_seed;
+    float m_tickRate;
+    bool m_desync;
+    bool m_finished;
+
+    int m_playerCount;
+    std::array<PlayerRecord, MAX_PLAYER_COUNT> m_players;
+    StageConfig m_stageConfig;
+
+    std::vector<Uint32> m_frameDeltas;
+    std::vector<uint8_t> m_inputs;
+    int m_fixedUpdateCount;
+
+    size_t m_frameIdx;
+    size_t m_readPos;
+    std::array<uint8_t, MAX_PLAYER_COUNT> m_prevFlags;
+    std::array<float, MAX_PLAYER_COUNT> m_prevDirection;
+
+    void ResetCursors();
+    void Desync(const char *reason);
+};
+
+inline MatchReplay::Mode MatchReplay::GetMode() const
+{
+    return m_mode;
+}
+
+inline bool MatchReplay::IsRecording() const
+{
+    return m_mode == Mode::RECORD;
+}
+
+inline bool MatchReplay::IsPlaying() const
+{
+    return m_mode == Mode::PLAYBACK;
+}
+
+inline bool MatchReplay::HasDesync() const
+{
+    return m_desync;
+}
+
+inline bool MatchReplay::IsFinished() const
+{
+    return m_finished;
+}
+
+inline unsigned int MatchReplay::GetSeed() const
+{
+    return m_seed;
+}
+
+inline float MatchReplay::GetTickRate() const
+{
+    return m_tickRate;
+}
+
+inline int MatchReplay::GetFrameCount() const
+{
+    return (int)m_frameDeltas.size();
+}
+
+inline int MatchReplay::GetFixedUpdateCount() const
+{
+    return m_fixedUpdateCount;
+}
+
+inline size_t MatchReplay::GetDataSize() const
+{
+    return m_frameDeltas.size() * sizeof(Uint32) + m_inputs.size();
+}
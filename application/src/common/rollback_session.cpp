@@ -0,0 +1,472 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "common/rollback_session.h"
+#include "scene_manager/stage_manager.h"
+
+namespace
+{
+    enum PacketType : uint8_t
+    {
+        PACKET_INPUTS = 1,
+        PACKET_ACK = 2
+    };
+
+    const int NO_TICK = std::numeric_limits<int>::max();
+
+    void WriteU32(std::vector<uint8_t> &packet, uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            packet.push_back((uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    bool ReadU32(const std::vector<uint8_t> &packet, size_t &pos, uint32_t &value)
+    {
+        if (pos + 4 > packet.size()) return false;
+        value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            value |= (uint32_t)packet[pos++] << (8 * i);
+        }
+        return true;
+    }
+
+    void WriteInput(std::vector<uint8_t> &packet, const PlayerControllerInput &input)
+    {
+        uint32_t bits = 0;
+        memcpy(&bits, &input.direction, sizeof(float));
+        packet.push_back(PlayerInputUtils::EncodeFlags(input));
+        WriteU32(packet, bits);
+    }
+
+    bool ReadInput(const std::vector<uint8_t> &packet, size_t &pos, PlayerControllerInput &input)
+    {
+        if (pos + 1 > packet.size()) return false;
+        PlayerInputUtils::DecodeFlags(packet[pos++], input);
+
+        uint32_t bits = 0;
+        if (ReadU32(packet, pos, bits) == false) return false;
+        memcpy(&input.direction, &bits, sizeof(float));
+        return true;
+    }
+
+    double GetElapsedMS(Uint64 start)
+    {
+        return 1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+            / (double)SDL_GetPerformanceFrequency();
+    }
+}
+
+RollbackSession::Stats::Stats()
+    : tickCount(0)
+    , rollbackCount(0)
+    , lastRollbackDepth(0)
+    , maxRollbackDepth(0)
+    , resimulatedTicks(0)
+    , failedRollbackCount(0)
+    , mispredictionCount(0)
+    , saveCount(0)
+    , resimTimeMS(0.0)
+    , saveTimeMS(0.0)
+{
+}
+
+float RollbackSession::Stats::GetResimCostMS() const
+{
+    if (resimulatedTicks <= 0) return 0.f;
+    return (float)(resimTimeMS / resimulatedTicks);
+}
+
+float RollbackSession::Stats::GetSaveCostMS() const
+{
+    if (saveCount <= 0) return 0.f;
+    return (float)(saveTimeMS / saveCount);
+}
+
+RollbackSession::TickInputs::TickInputs()
+    : tick(-1)
+    , confirmed(false)
+    , inputs()
+{
+}
+
+RollbackSession::RollbackSession(Transport *transport, uint32_t localMask)
+    : m_transport(transport)
+    , m_peer(nullptr)
+    , m_link(nullptr)
+    , m_localMask(localMask)
+    , m_started(false)
+    , m_playerCount(0)
+    , m_simTick(0)
+    , m_tick(0)
+    , m_timeStepNS(0)
+    , m_snapshots()
+    , m_history()
+    , m_rollbackTick(NO_TICK)
+    , m_confirmedTick()
+    , m_confirmedInput()
+    , m_ackedTick()
+    , m_peerHistory()
+    , m_peerAckedTick()
+    , m_peerReceivedTick()
+    , m_peerLastUpdate()
+    , m_stats()
+{
+    assert(transport != nullptr);
+    m_confirmedTick.fill(-1);
+    m_ackedTick.fill(-1);
+    m_peerAckedTick.fill(-1);
+    m_peerReceivedTick.fill(-1);
+}
+
+void RollbackSession::SetLoopbackPeer(Transport *peer, LoopbackLink *link)
+{
+    m_peer = peer;
+    m_link = link;
+}
+
+void RollbackSession::Start(StageManager *stageManager)
+{
+    Scene *scene = stageManager->GetScene();
+    m_timeStepNS = scene->GetTimeStepNS();
+    m_playerCount = GameCommon::GetFromScene(scene).playerCount;
+    m_tick = 0;
+    m_simTick = 0;
+    m_started = true;
+
+    SaveTick(stageManager, 0);
+    scene->SetNextDeltaNS(m_timeStepNS);
+}
+
+void RollbackSession::Update(StageManager *stageManager)
+{
+    if (m_started == false) return;
+
+    Scene *scene = stageManager->GetScene();
+
+    // Le tick m_tick vient d'être simulé
+    m_stats.tickCount++;
+    m_tick++;
+    m_simTick = m_tick;
+
+    if (m_link) m_link->Advance(m_timeStepNS);
+    if (m_peer) ReceivePeerPackets();
+    ReceivePackets();
+
+    if (m_rollbackTick != NO_TICK)
+    {
+        Rollback(stageManager);
+    }
+    else
+    {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        SaveTick(stageManager, m_tick);
+        m_stats.saveTimeMS += GetElapsedMS(start);
+        m_stats.saveCount++;
+    }
+
+    SendInputs(m_transport, m_history, m_ackedTick, m_localMask);
+    if (m_peer) SendInputs(m_peer, m_peerHistory, m_peerAckedTick, ~m_localMask);
+
+    // Exactement un pas fixe par frame
+    scene->SetNextDeltaNS(m_timeStepNS);
+}
+
+void RollbackSession::ProcessInputs(
+    Sample type, PlayerControllerInput *inputs[MAX_PLAYER_COUNT], uint32_t aiMask)
+{
+    if (m_started == false) return;
+
+    const int s = (int)type;
+    const int tick = m_simTick;
+    const bool resimulating = m_simTick < m_tick;
+
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        if (inputs[i] == nullptr) continue;
+
+        TickInputs &entry = m_history[i][tick % INPUT_HISTORY];
+        if (IsLocal(i))
+        {
+            if (resimulating)
+            {
+                *(inputs[i]) = entry.inputs[s];
+            }
+            else
+            {
+                if (entry.tick != tick)
+                {
+                    entry.tick = tick;
+                    entry.confirmed = true;
+                    entry.inputs.fill(*(inputs[i]));
+                }
+                entry.inputs[s] = *(inputs[i]);
+            }
+            continue;
+        }
+
+        if (m_peer && resimulating == false)
+        {
+            // Entrées générées par le joueur distant simulé. Les entrées d'un
+            // joueur humain sont écrites pendant la frame et celles d'une IA
+            // pendant le pas fixe, comme sans rollback.
+            const bool isAI = (aiMask & (1u << i)) != 0;
+            TickInputs &peerEntry = m_peerHistory[i][tick % INPUT_HISTORY];
+            if (peerEntry.tick != tick)
+            {
+                peerEntry.tick = tick;
+                peerEntry.confirmed = true;
+            }
+            if (type == Sample::FIXED_UPDATE)
+            {
+                peerEntry.inputs[s] = isAI ? *(inputs[i]) : m_peerLastUpdate[i];
+            }
+            else
+            {
+                peerEntry.inputs[s] = isAI ? peerEntry.inputs[(int)Sample::FIXED_UPDATE] : *(inputs[i]);
+                m_peerLastUpdate[i] = peerEntry.inputs[s];
+            }
+        }
+
+        if (entry.tick != tick || entry.confirmed == false)
+        {
+            entry.tick = tick;
+            entry.confirmed = false;
+            entry.inputs[s] = PredictInput(i);
+        }
+        *(inputs[i]) = entry.inputs[s];
+    }
+}
+
+int RollbackSession::GetMaxRollbackDepth(float frameBudgetMS) const
+{
+    const float cost = m_stats.GetResimCostMS();
+    if (cost <= 0.f) return MAX_ROLLBACK_TICKS;
+
+    const int depth = (int)(frameBudgetMS / cost);
+    return std::max(0, std::min(depth, MAX_ROLLBACK_TICKS));
+}
+
+void RollbackSession::SaveTick(StageManager *stageManager, int tick)
+{
+    stageManager->SaveState(m_snapshots[tick % m_snapshots.size()]);
+}
+
+void RollbackSession::Rollback(StageManager *stageManager)
+{
+    const int tick = m_rollbackTick;
+    const int depth = m_tick - tick;
+    m_rollbackTick = NO_TICK;
+
+    // Le snapshot du tick fautif n'est plus disponible : la partie est désynchronisée
+    if (depth > MAX_ROLLBACK_TICKS)
+    {
+        if (m_stats.failedRollbackCount == 0)
+        {
+            std::cout << "ERROR - Rollback of " << depth << " ticks exceeds the "
+                << MAX_ROLLBACK_TICKS << " saved ticks" << std::endl;
+        }
+        m_stats.failedRollbackCount++;
+        SaveTick(stageManager, m_tick);
+        return;
+    }
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    Scene *scene = stageManager->GetScene();
+    SceneSnapshot &snapshot = m_snapshots[tick % m_snapshots.size()];
+    if (stageManager->LoadState(snapshot, SceneSnapshot::RestoreMode::SIMULATION) == false)
+    {
+        m_stats.failedRollbackCount++;
+        SaveTick(stageManager, m_tick);
+        return;
+    }
+
+    for (m_simTick = tick; m_simTick < m_tick; m_simTick++)
+    {
+        scene->ResimulateStep();
+        SaveTick(stageManager, m_simTick + 1);
+    }
+    assert(m_simTick == m_tick);
+
+    m_stats.resimTimeMS += GetElapsedMS(start);
+    m_stats.resimulatedTicks += depth;
+    m_stats.rollbackCount++;
+    m_stats.lastRollbackDepth = depth;
+    m_stats.maxRollbackDepth = std::max(m_stats.maxRollbackDepth, depth);
+}
+
+void RollbackSession::ReceivePackets()
+{
+    std::vector<uint8_t> packet;
+    while (m_transport->Receive(packet))
+    {
+        size_t pos = 2;
+        if (packet.size() < pos) continue;
+        const uint8_t type = packet[0];
+        const int playerID = packet[1];
+        if (playerID >= MAX_PLAYER_COUNT) continue;
+
+        uint32_t tick = 0;
+        if (ReadU32(packet, pos, tick) == false) continue;
+
+        if (type == PACKET_INPUTS && IsLocal(playerID) == false)
+        {
+            if (pos + 1 > packet.size()) continue;
+            const int count = packet[pos++];
+            for (int i = 0; i < count; i++)
+            {
+                PlayerControllerInput fixedInput, updateInput;
+                if (ReadInput(packet, pos, fixedInput) == false) break;
+                if (ReadInput(packet, pos, updateInput) == false) break;
+                ConfirmInput(playerID, (int)tick + i, fixedInput, updateInput);
+            }
+        }
+        else if (type == PACKET_ACK && IsLocal(playerID))
+        {
+            m_ackedTick[playerID] = std::max(m_ackedTick[playerID], (int)tick);
+        }
+    }
+
+    // Acquitte les entrées reçues sans trou
+    for (int i = 0; i < m_playerCount; i++)
+    {
+        if (IsLocal(i) || m_confirmedTick[i] < 0) continue;
+
+        packet.clear();
+        packet.push_back(PACKET_ACK);
+        packet.push_back((uint8_t)i);
+        WriteU32(packet, (uint32_t)m_confirmedTick[i]);
+        m_transport->Send(packet);
+    }
+}
+
+void RollbackSession::ReceivePeerPackets()
+{
+    std::vector<uint8_t> packet;
+    while (m_peer->Receive(packet))
+    {
+        size_t pos = 2;
+        if (packet.size() < pos) continue;
+        const uint8_t type = packet[0];
+        const int playerID = packet[1];
+        if (playerID >= MAX_PLAYER_COUNT) continue;
+
+        uint32_t tick = 0;
+        if (ReadU32(packet, pos, tick) == false) continue;
+
+        if (type == PACKET_INPUTS && IsLocal(playerID))
+        {
+            // Le pair ne rejoue pas les entrées, il se contente de les acquitter
+            if (pos + 1 > packet.size()) continue;
+            const int count = packet[pos++];
+            const int lastTick = (int)tick + count - 1;
+            if ((int)tick <= m_peerReceivedTick[playerID] + 1)
+            {
+                m_peerReceivedTick[playerID] = std::max(m_peerReceivedTick[playerID], lastTick);
+            }
+        }
+        else if (type == PACKET_ACK && IsLocal(playerID) == false)
+        {
+            m_peerAckedTick[playerID] = std::max(m_peerAckedTick[playerID], (int)tick);
+        }
+    }
+
+    for (int i = 0; i < m_playerCount; i++)
+    {
+        if (IsLocal(i) == false || m_peerReceivedTick[i] < 0) continue;
+
+        packet.clear();
+        packet.push_back(PACKET_ACK);
+        packet.push_back((uint8_t)i);
+        WriteU32(packet, (uint32_t)m_peerReceivedTick[i]);
+        m_peer->Send(packet);
+    }
+}
+
+void RollbackSession::SendInputs(
+    Transport *transport, const std::array<InputHistory, MAX_PLAYER_COUNT> &history,
+    const std::array<int, MAX_PLAYER_COUNT> &ackedTick, uint32_t mask)
+{
+    std::vector<uint8_t> packet;
+    for (int i = 0; i < m_playerCount; i++)
+    {
+        if ((mask & (1u << i)) == 0) continue;
+
+        // Entrées non acquittées, de la plus ancienne à la plus récente
+        const int firstTick = std::max(ackedTick[i] + 1, m_tick - INPUT_HISTORY + 1);
+        int count = 0;
+        while (count < MAX_INPUTS_PER_PACKET && firstTick + count < m_tick)
+        {
+            const TickInputs &entry = history[i][(firstTick + count) % INPUT_HISTORY];
+            if (entry.tick != firstTick + count) break;
+            count++;
+        }
+        if (count == 0) continue;
+
+        packet.clear();
+        packet.push_back(PACKET_INPUTS);
+        packet.push_back((uint8_t)i);
+        WriteU32(packet, (uint32_t)firstTick);
+        packet.push_back((uint8_t)count);
+        for (int k = 0; k < count; k++)
+        {
+            const TickInputs &entry = history[i][(firstTick + k) % INPUT_HISTORY];
+            WriteInput(packet, entry.inputs[(int)Sample::FIXED_UPDATE]);
+            WriteInput(packet, entry.inputs[(int)Sample::UPDATE]);
+        }
+        transport->Send(packet);
+    }
+}
+
+void RollbackSession::ConfirmInput(
+    int playerID, int tick, const PlayerControllerInput &fixedInput,
+    const PlayerControllerInput &updateInput)
+{
+    if (tick <= m_confirmedTick[playerID]) return;
+    if (tick <= m_tick - INPUT_HISTORY || tick >= m_tick + INPUT_HISTORY) return;
+
+    TickInputs &entry = m_history[playerID][tick % INPUT_HISTORY];
+    if (entry.tick == tick)
+    {
+        if (entry.confirmed) return;
+
+        // Le tick a été simulé avec une prédiction
+        if (PlayerInputUtils::Equals(entry.inputs[0], fixedInput) == false ||
+            PlayerInputUtils::Equals(entry.inputs[1], updateInput) == false)
+        {
+            m_stats.mispredictionCount++;
+            m_rollbackTick = std::min(m_rollbackTick, tick);
+        }
+    }
+
+    entry.tick = tick;
+    entry.confirmed = true;
+    entry.inputs[(int)Sample::FIXED_UPDATE] = fixedInput;
+    entry.inputs[(int)Sample::UPDATE] = updateInput;
+
+    // Avance le dernier tick confirmé sans trou
+    while (true)
+    {
+        const int next = m_confirmedTick[playerID] + 1;
+        const TickInputs &nextEntry = m_history[playerID][next % INPUT_HISTORY];
+        if (nextEntry.tick != next || nextEntry.confirmed == false) break;
+
+        m_confirmedTick[playerID] = next;
+        m_confirmedInput[playerID] = nextEntry.inputs[(int)Sample::UPDATE];
+    }
+}
+
+PlayerControllerInput RollbackSession::PredictInput(int playerID) const
+{
+    // Le joueur garde les mêmes touches enfoncées, sans nouvel appui
+    PlayerControllerInput input = m_confirmedInput[playerID];
+    input.jumpPressed = false;
+    input.attackPressed = false;
+    return input;
+}
@@ -0,0 +1,179 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+#include "ecs/player/player_components.h"
+
+class StageManager;
+
+/// @brief Session de jeu en réseau avec prédiction et retour en arrière (rollback).
+///
+/// La session avance au pas : chaque frame exécute exactement un pas fixe (tick).
+/// Les entrées des joueurs locaux sont envoyées à chaque tick, avec les entrées
+/// précédentes qui n'ont pas encore été acquittées. Les entrées des joueurs
+/// distants sont prédites (dernière entrée confirmée, sans appui) tant qu'elles
+/// ne sont pas reçues. Quand une entrée reçue diffère de la prédiction,
+/// la scène est restaurée au tick fautif puis resimulée jusqu'au tick courant.
+///
+/// Un snapshot de la scène est conservé pour chacun des MAX_ROLLBACK_TICKS
+/// derniers ticks.
+class RollbackSession
+{
+public:
+    /// @brief Nombre de ticks conservés pour les retours en arrière.
+    static constexpr int MAX_ROLLBACK_TICKS = 30;
+    /// @brief Nombre de ticks conservés dans l'historique des entrées.
+    static constexpr int INPUT_HISTORY = 128;
+    /// @brief Nombre maximal d'entrées envoyées dans un paquet.
+    static constexpr int MAX_INPUTS_PER_PACKET = 32;
+
+    /// @brief Crée la session.
+    /// @param transport le canal vers l'autre machine.
+    /// @param localMask les joueurs contrôlés par cette machine (bit i pour le joueur i).
+    RollbackSession(Transport *transport, uint32_t localMask);
+    RollbackSession(RollbackSession const&) = delete;
+    RollbackSession& operator=(RollbackSession const&) = delete;
+
+    /// @brief Active le mode de test en boucle locale : les entrées des joueurs
+    /// distants sont générées sur cette machine puis envoyées par `peer`
+    /// à travers la liaison simulée.
+    void SetLoopbackPeer(Transport *peer, LoopbackLink *link);
+
+    enum class Sample : int
+    {
+        /// @brief Entrées lues par les systèmes pendant un pas fixe.
+        FIXED_UPDATE = 0,
+        /// @brief Entrées lues par les systèmes pendant une frame.
+        UPDATE = 1
+    };
+
+    struct Stats
+    {
+        Stats();
+
+        int tickCount;
+        int rollbackCount;
+        int lastRollbackDepth;
+        int maxRollbackDepth;
+        int resimulatedTicks;
+        int failedRollbackCount;
+        int mispredictionCount;
+        int saveCount;
+
+        /// @brief Temps total des resimulations (pas et snapshots).
+        double resimTimeMS;
+        /// @brief Temps total des snapshots pris hors resimulation.
+        double saveTimeMS;
+
+        /// @brief Coût moyen de la resimulation d'un tick (snapshot compris).
+        float GetResimCostMS() const;
+        /// @brief Coût moyen d'un snapshot.
+        float GetSaveCostMS() const;
+    };
+
+    /// @brief Prend le snapshot du premier tick et impose le pas de la première frame.
+    /// Doit être appelée à la fin de la création du niveau.
+    void Start(StageManager *stageManager);
+
+    /// @brief Termine le tick courant : réception des paquets, retour en arrière
+    /// éventuel, snapshot du tick suivant et envoi des entrées locales.
+    /// Doit être appelée à la fin de chaque frame (StageManager::OnSceneUpdate).
+    void Update(StageManager *stageManager);
+
+    /// @brief Enregistre les entrées locales et impose les entrées distantes
+    /// (confirmées ou prédites) pour le tick en cours de simulation.
+    /// @param type le moment de la mise à jour.
+    /// @param inputs les entrées indexées par playerID (nullptr si le joueur est absent).
+    /// @param aiMask les joueurs contrôlés par une IA (bit i pour le joueur i).
+    void ProcessInputs(Sample type, PlayerControllerInput *inputs[MAX_PLAYER_COUNT], uint32_t aiMask);
+
+    bool IsLocal(int playerID) const;
+    bool IsLoopback() const;
+    int GetTick() const;
+    const Stats &GetStats() const;
+
+    /// @brief Estime la profondeur maximale d'un retour en arrière qui tient
+    /// dans le budget d'une frame, d'après les coûts mesurés.
+    int GetMaxRollbackDepth(float frameBudgetMS) const;
+
+private:
+    struct TickInputs
+    {
+        TickInputs();
+
+        int tick;
+        bool confirmed;
+        std::array<PlayerControllerInput, 2> inputs;
+    };
+    using InputHistory = std::array<TickInputs, INPUT_HISTORY>;
+
+    Transport *m_transport;
+    Transport *m_peer;
+    LoopbackLink *m_link;
+    uint32_t m_localMask;
+    bool m_started;
+    int m_playerCount;
+
+    /// @brief Tick en cours de simulation ou de resimulation.
+    int m_simTick;
+    /// @brief Prochain tick à simuler normalement.
+    int m_tick;
+    Uint64 m_timeStepNS;
+
+    std::array<SceneSnapshot, MAX_ROLLBACK_TICKS + 1> m_snapshots;
+
+    /// @brief Entrées utilisées pour chaque joueur (locales, confirmées ou prédites).
+    std::array<InputHistory, MAX_PLAYER_COUNT> m_history;
+    /// @brief Premier tick dont l'entrée reçue diffère de la prédiction.
+    int m_rollbackTick;
+    /// @brief Dernier tick confirmé sans trou, pour chaque joueur distant.
+    std::array<int, MAX_PLAYER_COUNT> m_confirmedTick;
+    std::array<PlayerControllerInput, MAX_PLAYER_COUNT> m_confirmedInput;
+    /// @brief Dernier tick acquitté par l'autre machine, pour chaque joueur local.
+    std::array<int, MAX_PLAYER_COUNT> m_ackedTick;
+
+    // Extrémité simulée de la boucle locale
+    std::array<InputHistory, MAX_PLAYER_COUNT> m_peerHistory;
+    std::array<int, MAX_PLAYER_COUNT> m_peerAckedTick;
+    std::array<int, MAX_PLAYER_COUNT> m_peerReceivedTick;
+    std::array<PlayerControllerInput, MAX_PLAYER_COUNT> m_peerLastUpdate;
+
+    Stats m_stats;
+
+    void SaveTick(StageManager *stageManager, int tick);
+    void ReceivePackets();
+    void ReceivePeerPackets();
+    void Rollback(StageManager *stageManager);
+    void SendInputs(Transport *transport, const std::array<InputHistory, MAX_PLAYER_COUNT> &history,
+        const std::array<int, MAX_PLAYER_COUNT> &ackedTick, uint32_t mask);
+
+    void ConfirmInput(int playerID, int tick, const PlayerControllerInput &fixedInput,
+        const PlayerControllerInput &updateInput);
+    PlayerControllerInput PredictInput(int playerID) const;
+};
+
+inline bool RollbackSession::IsLocal(int playerID) const
+{
+    return (m_localMask & (1u << playerID)) != 0;
+}
+
+inline bool RollbackSession::IsLoopback() const
+{
+    return m_peer != nullptr;
+}
+
+inline int RollbackSession::GetTick() const
+{
+    return m_tick;
+}
+
+inline const RollbackSession::Stats &RollbackSession::GetStats() const
+{
+    return m_stats;
+}
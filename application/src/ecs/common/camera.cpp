@@ -42,6 +42,11 @@ void CameraSystem::OnUpdate(EntityCommandBuffer &ecb)
         {
             UpdateDebugCamera(camera, cameraTransform);
         }
+
+        // L'auditeur des effets sonores suit la caméra
+        const b2AABB worldView = camera.GetWorldView(cameraTransform.position);
+        m_scene->GetAssetManager()->GetSoundMixer()->SetListener(
+            cameraTransform.position, 0.5f * (worldView.upperBound.x - worldView.lowerBound.x));
     }
 }
 
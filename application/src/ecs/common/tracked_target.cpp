@@ -32,7 +32,7 @@ void TrackedTargetSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
             target.isEnabled = false;
             target.isGrounded = ground.isGrounded;
             target.ejectionScore = damageable.ejectionScore;
-            target.isEnabled = g_gameCommon.IsPlayerEnabled(affiliation.playerID);
+            target.isEnabled = GameCommon::GetFromScene(m_scene).IsPlayerEnabled(affiliation.playerID);
         }
         else
         {
@@ -46,9 +46,11 @@ void TrackedTargetSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
 }
 
 void TargetUtils::SearchTarget(
-    TrackedTarget &target, entt::registry &registry,
+    TrackedTarget &target, Scene *scene,
     uint64_t teamMask, b2Vec2 position)
 {
+    entt::registry &registry = scene->GetRegistry();
+    GameCommon &gameCommon = GameCommon::GetFromScene(scene);
     float minDist = FLT_MAX;
     auto playerView = registry.view<
         const PlayerController,
@@ -58,8 +60,8 @@ void TargetUtils::SearchTarget(
     for (auto [entity, controller, affiliation, rigidbody] : playerView.each())
     {
         const int playerID = affiliation.playerID;
-        if (g_gameCommon.IsPlayerEnabled(playerID) == false) continue;
-        if ((g_gameCommon.GetTeamMask(playerID) & teamMask) == 0) continue;
+        if (gameCommon.IsPlayerEnabled(playerID) == false) continue;
+        if ((gameCommon.GetTeamMask(playerID) & teamMask) == 0) continue;
         if (b2Body_IsValid(rigidbody.bodyId) == false) continue;
 
         b2Vec2 playerPosition = b2Body_GetPosition(rigidbody.bodyId);
@@ -32,7 +32,7 @@ class TargetUtils
 {
 public:
     static void SearchTarget(
-        TrackedTarget &target, entt::registry &registry,
+        TrackedTarget &target, Scene *scene,
         uint64_t teamMask, b2Vec2 position);
 
 private:
@@ -28,7 +28,7 @@ void VisualIDCommand::Create(
     AssertNew(spriteSheet);
     SpriteGroup *spriteGroup = nullptr;
 
-    PlayerConfig *config = g_gameCommon.GetPlayerConfig(affiliation.playerID);
+    PlayerConfig *config = GameCommon::GetFromScene(scene).GetPlayerConfig(affiliation.playerID);
     if (config == nullptr) return;
 
     // Bonus : Vous pouvez changer le groupe en fonction de la config pour pouvoir afficher CPU
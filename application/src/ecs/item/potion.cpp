@@ -89,7 +89,7 @@ void PotionSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
         if (damageable.cumulativeDamage.amount <= 0) continue;
 
         entt::entity damagerEntity = damageable.lastDamagerEntity;
-        if (PlayerUtils::HealIfPlayer(m_registry, damagerEntity, 30.f))
+        if (PlayerUtils::HealIfPlayer(m_scene, damagerEntity, 30.f))
         {
             ecb.DestroyEntity(entity);
         }
@@ -19,7 +19,7 @@ void FireKnightSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
     {
         if (controller.isStateUpdated == false) continue;
 
-        PlayerConfig *config = g_gameCommon.GetPlayerConfig(affiliation.playerID);
+        PlayerConfig *config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(affiliation.playerID);
         if (config == nullptr) continue;
 
         // TODO - Commencez une animation du type RUN quand l'tat du personnage
@@ -100,7 +100,7 @@ void FireKnightSystem::OnAnimFrameChanged(
     PlayerAnimInfo &animInfo)
 {
     const int playerID = affiliation.playerID;
-    PlayerConfig *config = g_gameCommon.GetPlayerConfig(playerID);
+    PlayerConfig *config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(playerID);
     if (config == nullptr) return;
 
     QueryFilter filter;
@@ -325,7 +325,7 @@ void FireKnightSystem::OnAnimCycleEnd(
     const PlayerControllerInput &input,
     PlayerAnimInfo &event)
 {
-    PlayerConfig *config = g_gameCommon.GetPlayerConfig(affiliation.playerID);
+    PlayerConfig *config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(affiliation.playerID);
     if (config == nullptr) return;
 
     AnimType nextAnimType = AnimType::UNDEFINED;
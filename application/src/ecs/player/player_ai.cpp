@@ -53,8 +53,8 @@ void PlayerAISystem::OnFixedUpdate(EntityCommandBuffer &ecb)
 
         // Recherche une cible
         b2Vec2 position = b2Body_GetPosition(rigidbody.bodyId);
-        const uint64_t otherTeamMask = g_gameCommon.GetOtherTeamMask(affiliation.playerID);
-        TargetUtils::SearchTarget(target, m_registry, otherTeamMask, position);
+        const uint64_t otherTeamMask = GameCommon::GetFromScene(m_scene).GetOtherTeamMask(affiliation.playerID);
+        TargetUtils::SearchTarget(target, m_scene, otherTeamMask, position);
         if (m_registry.valid(target.entity) == false) continue;
 
 
@@ -92,7 +92,7 @@ void PlayerAISystem::OnStateUpdated(PlayerAI &playerAI, const PlayerController &
     case PlayerState::ATTACK_SPECIAL:
     case PlayerState::SMASH_HOLD:
     case PlayerState::SMASH_RELEASE:
-        playerAI.desiredTargetDistance = random::RangeF(0.5f, 3.5f);
+        playerAI.desiredTargetDistance = m_scene->GetRandom().RangeF(0.5f, 3.5f);
         break;
     default: break;
     }
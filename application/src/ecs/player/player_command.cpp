@@ -22,7 +22,7 @@ void PlayerCommand::Create(
 {
     SpriteGroup *spriteGroup = nullptr;
     SpriteAnimManager *animManager = scene->GetAnimManager();
-    PlayerConfig *config = g_gameCommon.GetPlayerConfig(playerID);
+    PlayerConfig *config = GameCommon::GetFromScene(scene).GetPlayerConfig(playerID);
     if (config == nullptr)
     {
         assert(false);
@@ -18,6 +18,36 @@ PlayerControllerInput::PlayerControllerInput()
 {
 }
 
+uint8_t PlayerInputUtils::EncodeFlags(const PlayerControllerInput &input)
+{
+    uint8_t flags = 0;
+    if (input.jumpPressed)    flags |= 1 << 0;
+    if (input.jumpDown)       flags |= 1 << 1;
+    if (input.attackPressed)  flags |= 1 << 2;
+    if (input.attackDown)     flags |= 1 << 3;
+    if (input.defendDown)     flags |= 1 << 4;
+    if (input.oneWayPassDown) flags |= 1 << 5;
+    flags |= ((uint8_t)input.attackType & 0x3) << 6;
+    return flags;
+}
+
+void PlayerInputUtils::DecodeFlags(uint8_t flags, PlayerControllerInput &input)
+{
+    input.jumpPressed    = (flags & (1 << 0)) != 0;
+    input.jumpDown       = (flags & (1 << 1)) != 0;
+    input.attackPressed  = (flags & (1 << 2)) != 0;
+    input.attackDown     = (flags & (1 << 3)) != 0;
+    input.defendDown     = (flags & (1 << 4)) != 0;
+    input.oneWayPassDown = (flags & (1 << 5)) != 0;
+    input.attackType = (AttackType)((flags >> 6) & 0x3);
+}
+
+bool PlayerInputUtils::Equals(const PlayerControllerInput &a, const PlayerControllerInput &b)
+{
+    return EncodeFlags(a) == EncodeFlags(b) &&
+        memcmp(&a.direction, &b.direction, sizeof(float)) == 0;
+}
+
 PlayerController::PlayerController(PlayerType type)
     : currState(PlayerState::IDLE)
     , prevState(PlayerState::IDLE)
@@ -26,6 +26,20 @@ struct PlayerControllerInput
     AttackType attackType;
 };
 
+class PlayerInputUtils
+{
+public:
+    /// @brief Code les boolens et le type d'attaque d'une entre sur un octet.
+    static uint8_t EncodeFlags(const PlayerControllerInput &input);
+    static void DecodeFlags(uint8_t flags, PlayerControllerInput &input);
+
+    /// @brief Compare deux entres bit  bit (direction comprise).
+    static bool Equals(const PlayerControllerInput &a, const PlayerControllerInput &b);
+
+private:
+    PlayerInputUtils() = delete;
+};
+
 enum class PlayerState
 {
     IDLE, RUN, SKID, ROLL, JUMP, FALL,
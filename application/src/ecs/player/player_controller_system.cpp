@@ -19,82 +19,131 @@ void PlayerControllerSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
         if (input.oneWayPassDown) oneWayPass.delay = 0.2f;
     }
 
-    auto view = m_registry.view<
+    auto updatePlayer = [&](
+        entt::entity entity,
+        Rigidbody &rigidbody,
+        Damageable &damageable,
+        const PlayerControllerInput &input,
+        PlayerController &controller,
+        const GroundContact &ground,
+        const PlayerAffiliation &affiliation,
+        PlayerAnimInfo &animInfo)
+    {
+        FixedUpdatePlayer(
+            ecb, delta, entity, rigidbody, damageable,
+            input, controller, ground, affiliation, animInfo
+        );
+    };
+
+    if (m_scene->HasGroup<
         Rigidbody,
         Damageable,
-        const PlayerControllerInput,
+        PlayerControllerInput,
         PlayerController,
-        const GroundContact,
-        const PlayerAffiliation,
-        PlayerAnimInfo
-    >();
-    for (auto [entity, rigidbody, damageable, input, controller, ground, affiliation, animInfo] : view.each())
+        GroundContact,
+        PlayerAffiliation,
+        PlayerAnimInfo>())
+    {
+        m_registry.group<
+            Rigidbody,
+            Damageable,
+            PlayerControllerInput,
+            PlayerController,
+            GroundContact,
+            PlayerAffiliation,
+            PlayerAnimInfo
+        >().each(updatePlayer);
+    }
+    else
     {
-        b2Vec2 position = b2Body_GetPosition(rigidbody.bodyId);
-        b2Vec2 velocity = b2Body_GetLinearVelocity(rigidbody.bodyId) - ground.groundVelocity;
+        m_registry.view<
+            Rigidbody,
+            Damageable,
+            const PlayerControllerInput,
+            PlayerController,
+            const GroundContact,
+            const PlayerAffiliation,
+            PlayerAnimInfo
+        >().each(updatePlayer);
+    }
+}
 
-        controller.isStateUpdated = false;
-        controller.prevState = controller.currState;
+void PlayerControllerSystem::FixedUpdatePlayer(
+    EntityCommandBuffer &ecb,
+    float delta,
+    entt::entity entity,
+    Rigidbody &rigidbody,
+    Damageable &damageable,
+    const PlayerControllerInput &input,
+    PlayerController &controller,
+    const GroundContact &ground,
+    const PlayerAffiliation &affiliation,
+    PlayerAnimInfo &animInfo)
+{
+    b2Vec2 position = b2Body_GetPosition(rigidbody.bodyId);
+    b2Vec2 velocity = b2Body_GetLinearVelocity(rigidbody.bodyId) - ground.groundVelocity;
 
-        // Fall
-        if (position.y < -5.f || fabsf(position.x) > 40.f || position.y > 25.f)
+    controller.isStateUpdated = false;
+    controller.prevState = controller.currState;
+
+    // Fall
+    if (position.y < -5.f || fabsf(position.x) > 40.f || position.y > 25.f)
+    {
+        bool destroyPlayer = OnPlayerFall(entity, rigidbody, affiliation, damageable, controller);
+        if (destroyPlayer)
         {
-            bool destroyPlayer = OnPlayerFall(entity, rigidbody, affiliation, damageable, controller);
-            if (destroyPlayer)
-            {
-                ecb.DestroyEntity(entity);
-            }
-            continue;
+            ecb.DestroyEntity(entity);
         }
+        return;
+    }
 
-        // Ground
-        if (ground.wasGrounded == false && ground.isGrounded)
-        {
-            controller.bonusJumpCount = controller.maxBonusJumpCount;
-            m_scene->GetAssetManager()->PlaySoundFX(SFX_LAND);
+    // Ground
+    if (ground.wasGrounded == false && ground.isGrounded)
+    {
+        controller.bonusJumpCount = controller.maxBonusJumpCount;
+        m_scene->GetAssetManager()->PlaySoundFX(SFX_LAND);
 
-            // TODO - Appeler la fonction PlayerUtils::EmitLandDust pour mettre de la poussire.
-            //      - La scne est accessible via le membre m_scene
-            //      - On peut savoir si le personnage regarde vers la droite avec le champ facingRight du controller.
-            PlayerUtils::EmitLandDust(m_scene, position, controller.facingRight);
-        }
+        // TODO - Appeler la fonction PlayerUtils::EmitLandDust pour mettre de la poussire.
+        //      - La scne est accessible via le membre m_scene
+        //      - On peut savoir si le personnage regarde vers la droite avec le champ facingRight du controller.
+        PlayerUtils::EmitLandDust(m_scene, position, controller.facingRight);
+    }
 
-        // Shield & Damage
-        FixedUpdateShieldAndDamage(affiliation, ground, controller, damageable);
+    // Shield & Damage
+    FixedUpdateShieldAndDamage(affiliation, ground, controller, damageable);
 
-        // State
-        FixedUpdateState(rigidbody, damageable, input, controller, ground, animInfo);
+    // State
+    FixedUpdateState(rigidbody, damageable, input, controller, ground, animInfo);
 
-        if (controller.isStateUpdated)
-        {
-            FixedUpdateOnStateChanged(rigidbody, damageable, input, controller, ground);
-        }
+    if (controller.isStateUpdated)
+    {
+        FixedUpdateOnStateChanged(rigidbody, damageable, input, controller, ground);
+    }
 
-        // Physics
-        FixedUpdateAutoVelocity(controller, rigidbody, ground, animInfo);
-        FixedUpdatePhysics(entity, rigidbody, damageable, input, controller, ground, animInfo);
+    // Physics
+    FixedUpdateAutoVelocity(controller, rigidbody, ground, animInfo);
+    FixedUpdatePhysics(entity, rigidbody, damageable, input, controller, ground, animInfo);
 
-        // Finalise step
-        DamageUtils::ResetLastDamager(damageable);
-        DamageUtils::ResetCumulativeDamage(damageable);
+    // Finalise step
+    DamageUtils::ResetLastDamager(damageable);
+    DamageUtils::ResetCumulativeDamage(damageable);
 
-        animInfo.type = PlayerAnimInfo::Event::NONE;
+    animInfo.type = PlayerAnimInfo::Event::NONE;
 
-        damageable.lockTime -= delta;
-        damageable.lockAttackTime -= delta;
-        controller.delayAttack -= delta;
-        controller.delayEarlyJump -= delta;
+    damageable.lockTime -= delta;
+    damageable.lockAttackTime -= delta;
+    controller.delayAttack -= delta;
+    controller.delayEarlyJump -= delta;
 
-        // TODO - Dcommentez le code suivant qui met  jour des dlais
-        //        dont vous aurez ventuellement besoin pour la partie libre.
+    // TODO - Dcommentez le code suivant qui met  jour des dlais
+    //        dont vous aurez ventuellement besoin pour la partie libre.
 
-        controller.delayBonusJump -= delta;
-        controller.delayCoyoteJump -= delta;
-        controller.delayRoll -= delta;
-        controller.delaySmashReleaseMin -= delta;
-        controller.delaySmashReleaseMax -= delta;
-        if (ground.isGrounded) controller.delayClearLastDamager -= delta;
-    }
+    controller.delayBonusJump -= delta;
+    controller.delayCoyoteJump -= delta;
+    controller.delayRoll -= delta;
+    controller.delaySmashReleaseMin -= delta;
+    controller.delaySmashReleaseMax -= delta;
+    if (ground.isGrounded) controller.delayClearLastDamager -= delta;
 }
 
 void PlayerControllerSystem::OnUpdate(EntityCommandBuffer &ecb)
@@ -112,7 +161,7 @@ void PlayerControllerSystem::OnUpdate(EntityCommandBuffer &ecb)
             controller.delayEarlyJump = 0.1f;
         }
 
-        sprite.flip = controller.facingRight ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
+        sprite.SetFlip(controller.facingRight ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL, m_scene->GetUpdateID());
     }
 }
 
@@ -135,12 +184,12 @@ bool PlayerControllerSystem::OnPlayerFall(
 
     int fallCount = INT_MAX;
     int lastDamagerID = controller.lastDamagerAffiliation.playerID;
-    PlayerStats *damagerStats = g_gameCommon.GetPlayerStats(lastDamagerID);
+    PlayerStats *damagerStats = GameCommon::GetFromScene(m_scene).GetPlayerStats(lastDamagerID);
     if (damagerStats)
     {
         damagerStats->koCount++;
     }
-    PlayerStats *playerStats = g_gameCommon.GetPlayerStats(affiliation.playerID);
+    PlayerStats *playerStats = GameCommon::GetFromScene(m_scene).GetPlayerStats(affiliation.playerID);
     if (playerStats)
     {
         playerStats->ejectionScore = 0.f;
@@ -148,7 +197,7 @@ bool PlayerControllerSystem::OnPlayerFall(
         fallCount = playerStats->fallCount;
     }
 
-    const StageConfig &stageConfig = g_gameCommon.stageConfig;
+    const StageConfig &stageConfig = GameCommon::GetFromScene(m_scene).stageConfig;
     if (stageConfig.mode == StageConfig::Mode::LIMITED_LIVES)
     {
         if (fallCount >= stageConfig.lifeCount)
@@ -212,8 +261,8 @@ void PlayerControllerSystem::FixedUpdateShieldAndDamage(
 
     // Stats
     int lastDamagerID = controller.lastDamagerAffiliation.playerID;
-    PlayerStats *damagerStats = g_gameCommon.GetPlayerStats(lastDamagerID);
-    PlayerStats *playerStats = g_gameCommon.GetPlayerStats(affiliation.playerID);
+    PlayerStats *damagerStats = GameCommon::GetFromScene(m_scene).GetPlayerStats(lastDamagerID);
+    PlayerStats *playerStats = GameCommon::GetFromScene(m_scene).GetPlayerStats(affiliation.playerID);
     if (damagerStats)
     {
         // BONUS - Modifier les stats du damager
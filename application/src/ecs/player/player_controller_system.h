@@ -22,6 +22,18 @@ public:
     virtual void OnUpdate(EntityCommandBuffer &ecb) override;
 
 protected:
+    void FixedUpdatePlayer(
+        EntityCommandBuffer &ecb,
+        float delta,
+        entt::entity entity,
+        Rigidbody &rigidbody,
+        Damageable &damageable,
+        const PlayerControllerInput &input,
+        PlayerController &controller,
+        const GroundContact &ground,
+        const PlayerAffiliation &affiliation,
+        PlayerAnimInfo &animInfo);
+
     bool OnPlayerFall(
         entt::entity entity,
         const Rigidbody &rigidbody,
@@ -0,0 +1,64 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "ecs/player/player_replay_system.h"
+#include "ecs/player/player_components.h"
+#include "scene_manager/stage_manager.h"
+
+void PlayerReplaySystem::OnFixedUpdate(EntityCommandBuffer &ecb)
+{
+    ProcessInputs(MatchReplay::Sample::FIXED_UPDATE);
+}
+
+void PlayerReplaySystem::OnUpdate(EntityCommandBuffer &ecb)
+{
+    StageManager *stageManager = StageManager::GetFromScene(m_scene);
+    if (stageManager == nullptr) return;
+    MatchReplay *replay = stageManager->GetReplay();
+    if (replay == nullptr) return;
+
+    if (replay->IsRecording())
+    {
+        replay->RecordFrame(m_scene->GetUnscaledDeltaNS());
+    }
+
+    ProcessInputs(MatchReplay::Sample::UPDATE);
+}
+
+void PlayerReplaySystem::ProcessInputs(MatchReplay::Sample type)
+{
+    StageManager *stageManager = StageManager::GetFromScene(m_scene);
+    if (stageManager == nullptr) return;
+    MatchReplay *replay = stageManager->GetReplay();
+    if (replay == nullptr) return;
+
+    PlayerControllerInput *inputs[MAX_PLAYER_COUNT] = { nullptr };
+    auto view = m_registry.view<PlayerControllerInput, const PlayerAffiliation>();
+    for (auto [entity, input, affiliation] : view.each())
+    {
+        if (affiliation.playerID < 0) continue;
+        if (affiliation.playerID >= MAX_PLAYER_COUNT) continue;
+
+        inputs[affiliation.playerID] = &input;
+    }
+
+    switch (replay->GetMode())
+    {
+    case MatchReplay::Mode::RECORD:
+        replay->RecordInputs(type, inputs);
+        break;
+
+    case MatchReplay::Mode::PLAYBACK:
+        // Les frames jouées après la fin de l'enregistrement (fondu de sortie)
+        // ne sont pas rejouées.
+        if (replay->IsFinished()) break;
+        replay->PlayInputs(type, inputs);
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,26 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+#include "common/match_replay.h"
+
+/// @brief Enregistre ou rejoue les entrées des joueurs.
+/// Ce système doit être placé après PlayerInputSystem et PlayerAISystem
+/// et avant PlayerControllerSystem.
+class PlayerReplaySystem : public System
+{
+public:
+    PlayerReplaySystem(Scene *scene) : System(scene, "Player replay system") {}
+
+    virtual void OnFixedUpdate(EntityCommandBuffer &ecb) override;
+    virtual void OnUpdate(EntityCommandBuffer &ecb) override;
+
+private:
+    void ProcessInputs(MatchReplay::Sample type);
+};
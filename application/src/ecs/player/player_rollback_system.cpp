@@ -0,0 +1,45 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "ecs/player/player_rollback_system.h"
+#include "ecs/player/player_components.h"
+#include "ecs/player/player_ai.h"
+#include "scene_manager/stage_manager.h"
+
+void PlayerRollbackSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
+{
+    ProcessInputs(RollbackSession::Sample::FIXED_UPDATE);
+}
+
+void PlayerRollbackSystem::OnUpdate(EntityCommandBuffer &ecb)
+{
+    ProcessInputs(RollbackSession::Sample::UPDATE);
+}
+
+void PlayerRollbackSystem::ProcessInputs(RollbackSession::Sample type)
+{
+    StageManager *stageManager = StageManager::GetFromScene(m_scene);
+    if (stageManager == nullptr) return;
+    RollbackSession *session = stageManager->GetRollback();
+    if (session == nullptr) return;
+
+    PlayerControllerInput *inputs[MAX_PLAYER_COUNT] = { nullptr };
+    uint32_t aiMask = 0;
+    auto view = m_registry.view<PlayerControllerInput, const PlayerAffiliation>();
+    for (auto [entity, input, affiliation] : view.each())
+    {
+        if (affiliation.playerID < 0) continue;
+        if (affiliation.playerID >= MAX_PLAYER_COUNT) continue;
+
+        inputs[affiliation.playerID] = &input;
+        if (m_registry.all_of<PlayerAI>(entity))
+        {
+            aiMask |= 1u << affiliation.playerID;
+        }
+    }
+
+    session->ProcessInputs(type, inputs, aiMask);
+}
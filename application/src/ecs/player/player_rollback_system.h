@@ -0,0 +1,27 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "common/game_settings.h"
+#include "common/game_common.h"
+#include "common/rollback_session.h"
+
+/// @brief Transmet les entrées des joueurs à la session de rollback et applique
+/// les entrées distantes (confirmées ou prédites).
+/// Ce système doit être placé après PlayerInputSystem et PlayerAISystem
+/// et avant PlayerControllerSystem.
+class PlayerRollbackSystem : public System
+{
+public:
+    PlayerRollbackSystem(Scene *scene) : System(scene, "Player rollback system") {}
+
+    virtual void OnFixedUpdate(EntityCommandBuffer &ecb) override;
+    virtual void OnUpdate(EntityCommandBuffer &ecb) override;
+
+private:
+    void ProcessInputs(RollbackSession::Sample type);
+};
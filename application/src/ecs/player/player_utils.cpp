@@ -11,7 +11,7 @@ void PlayerUtils::EmitSmallDust(
 {
     SpriteAnimManager *animManager = scene->GetAnimManager();
     ParticleSystem *particleSystem = scene->GetParticleSystem();
-    AnimType type = (rand() & 1) ? AnimType::SMALL_DUST_1 : AnimType::SMALL_DUST_2;
+    AnimType type = scene->GetCosmeticRandom().Bool() ? AnimType::SMALL_DUST_1 : AnimType::SMALL_DUST_2;
     Particle particle(AnimID_Make(AnimCategory::DUST, type));
 
     particle.SetLifetimeFromAnim(animManager);
@@ -93,13 +93,14 @@ void PlayerUtils::EmitEjectionParticles(Scene *scene, b2Vec2 position, b2Vec2 ej
 
     SpriteAnimManager *animManager = scene->GetAnimManager();
     ParticleSystem *particleSystem = scene->GetParticleSystem();
+    RandomStream &random = scene->GetCosmeticRandom();
     for (int i = 0; i < 30; i++)
     {
         Particle particle(AnimID_Make(AnimCategory::VFX, AnimType::SQUARE_PARTICULE));
-        b2Vec2 velocity = math::UnitVectorDeg(angle + random::RangeF(-15.f, 15.f));
-        velocity *= random::RangeF(5.f, 15.0f);
+        b2Vec2 velocity = math::UnitVectorDeg(angle + random.RangeF(-15.f, 15.f));
+        velocity *= random.RangeF(5.f, 15.0f);
 
-        particle.SetLifetime(random::RangeF(0.8f, 1.2f));
+        particle.SetLifetime(random.RangeF(0.8f, 1.2f));
         particle.position = position + b2Vec2{ 0.f, 1.f };
         particle.velocity = velocity;
         particle.damping = b2Vec2{ 1.f, 1.f };
@@ -136,8 +137,9 @@ void PlayerUtils::PlaySFXAttack(Scene *scene, int playerID, SoundID soundID, SFX
         break;
     }
 
-    assets->SetSoundVolume(soundID, volume);
-    assets->PlaySoundFX(soundID);
+    // Une attaque plus intense peut interrompre une attaque plus faible
+    const int priority = (int)intensity;
+    assets->PlaySoundFX(soundID, SoundParams::At(GetPlayerPosition(scene, playerID), priority, volume));
 }
 
 void PlayerUtils::PlaySFXHit(Scene *scene, int playerID, SoundID soundID, SFXIntensity intensity, bool hit)
@@ -157,8 +159,19 @@ void PlayerUtils::PlaySFXHit(Scene *scene, int playerID, SoundID soundID, SFXInt
         break;
     }
 
-    assets->SetSoundVolume(soundID, volume);
-    assets->PlaySoundFX(soundID);
+    // Les coups ports sont prioritaires sur les attaques dans le vide
+    const int priority = (int)SFXIntensity::MAX + 1 + (int)intensity;
+    assets->PlaySoundFX(soundID, SoundParams::At(GetPlayerPosition(scene, playerID), priority, volume));
+}
+
+b2Vec2 PlayerUtils::GetPlayerPosition(Scene *scene, int playerID)
+{
+    auto view = scene->GetRegistry().view<const PlayerAffiliation, const PlayerController, const Transform>();
+    for (auto [entity, affiliation, controller, transform] : view.each())
+    {
+        if (affiliation.playerID == playerID) return transform.position;
+    }
+    return b2Vec2_zero;
 }
 
 bool PlayerUtils::IsAttacking(const PlayerController &controller)
@@ -178,8 +191,9 @@ void PlayerUtils::SetState(PlayerController &controller, PlayerState state)
     controller.isStateUpdated = true;
 }
 
-bool PlayerUtils::HealIfPlayer(entt::registry &registry, entt::entity entity, float amount)
+bool PlayerUtils::HealIfPlayer(Scene *scene, entt::entity entity, float amount)
 {
+    entt::registry &registry = scene->GetRegistry();
     if (registry.valid(entity) &&
         registry.all_of<PlayerController, PlayerAffiliation, Damageable>(entity))
     {
@@ -188,7 +202,7 @@ bool PlayerUtils::HealIfPlayer(entt::registry &registry, entt::entity entity, fl
         damageable.ejectionScore -= amount;
         damageable.ejectionScore = fmaxf(0.f, damageable.ejectionScore);
 
-        PlayerStats *stats = g_gameCommon.GetPlayerStats(affiliation.playerID);
+        PlayerStats *stats = GameCommon::GetFromScene(scene).GetPlayerStats(affiliation.playerID);
         if (stats)
         {
             stats->ejectionScore = damageable.ejectionScore;
@@ -31,10 +31,11 @@ public:
 
     static void PlaySFXAttack(Scene *scene, int playerID, SoundID soundID, SFXIntensity intensity);
     static void PlaySFXHit(Scene *scene, int playerID, SoundID soundID, SFXIntensity intensity, bool hit);
+    static b2Vec2 GetPlayerPosition(Scene *scene, int playerID);
 
     static bool IsAttacking(const PlayerController &controller);
     static void SetState(PlayerController &controller, PlayerState state);
-    static bool HealIfPlayer(entt::registry &registry, entt::entity entity, float amount);
+    static bool HealIfPlayer(Scene *scene, entt::entity entity, float amount);
 
 private:
     PlayerUtils() = delete;
@@ -19,7 +19,7 @@ void WaterPriestessSystem::OnFixedUpdate(EntityCommandBuffer& ecb)
     {
         if (controller.isStateUpdated == false) continue;
 
-        PlayerConfig* config = g_gameCommon.GetPlayerConfig(affiliation.playerID);
+        PlayerConfig* config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(affiliation.playerID);
         if (config == nullptr) continue;
 
         // TODO S'inspirer du Fire Knight
@@ -91,7 +91,7 @@ void WaterPriestessSystem::OnAnimFrameChanged(
 {
     // TODO S'inspirer du Fire Knight
     const int playerID = affiliation.playerID;
-    PlayerConfig* config = g_gameCommon.GetPlayerConfig(playerID);
+    PlayerConfig* config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(playerID);
     if (config == nullptr) return;
 
     QueryFilter filter;
@@ -271,7 +271,7 @@ void WaterPriestessSystem::OnAnimCycleEnd(
     PlayerAnimInfo &event)
 {
     // TODO S'inspirer du Fire Knight
-    PlayerConfig* config = g_gameCommon.GetPlayerConfig(affiliation.playerID);
+    PlayerConfig* config = GameCommon::GetFromScene(m_scene).GetPlayerConfig(affiliation.playerID);
     if (config == nullptr) return;
 
     AnimType nextAnimType = AnimType::UNDEFINED;
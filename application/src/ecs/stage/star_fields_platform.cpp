@@ -240,7 +240,7 @@ FloatingPlatform::FloatingPlatform()
 
 void FloatingPlatformSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
 {
-    float elapsed = m_scene->GetElapsed();
+    float elapsed = m_scene->GetFixedElapsed();
 
     auto view = m_registry.view<const FloatingPlatform, KinematicTargetPosition, const ReferencePosition, const Rigidbody>();
     for (auto [entity, platform, targetPos, refPos, rigidbody] : view.each())
@@ -7,6 +7,7 @@
 #include "imgui/imgui_manager.h"
 #include "common/game_common.h"
 #include "ecs/common/camera.h"
+#include "scene_manager/stage_manager.h"
 
 ImGuiManager::ImGuiManager(Scene *scene, uint32_t flags)
     : ImGuiManagerBase(scene)
@@ -19,6 +20,7 @@ ImGuiManager::ImGuiManager(Scene *scene, uint32_t flags)
     , m_realtimePressed(false)
     , m_flags(flags)
     , m_gizmosShape()
+    , m_lineBatch()
     , m_points()
     , m_selectedDrawMode(0)
     , m_shapeExtents{ 1.f, 1.f }
@@ -43,6 +45,12 @@ void ImGuiManager::RenderDebug()
     }
 
     ImGui::SeparatorText("Scene update");
+    const Scene::FixedStepStats &stepStats = m_scene->GetFixedStepStats();
+    ImGui::Text("Tick rate: %.1f Hz (%llu ns)",
+        m_scene->GetTickRate(), (unsigned long long)m_scene->GetTimeStepNS());
+    ImGui::Text("Steps/frame: %d (max %d)", stepStats.lastStepCount, stepStats.maxStepCount);
+    ImGui::Text("Clamped frames: %d (dropped %.1f ms)",
+        stepStats.clampedFrameCount, (double)stepStats.droppedNS / 1e6);
     ImGui::Button("Make step [Tab]");
     m_makeStepClicked = ImGui::IsItemClicked();
     m_makeStepActive = ImGui::IsItemActive();
@@ -56,6 +64,123 @@ void ImGuiManager::RenderDebug()
         }
     }
 
+    if (StageManager *stageManager = dynamic_cast<StageManager *>(m_scene->GetSceneManager()))
+    {
+        ImGui::SeparatorText("Save state");
+        if (ImGui::Button("Save")) stageManager->RequestSaveState();
+
+        const SceneSnapshot &quickSave = stageManager->GetQuickSave();
+        if (quickSave.IsEmpty() == false)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button("Load")) stageManager->RequestLoadState();
+
+            ImGui::Text("Size: %.1f KB", (float)quickSave.GetSize() / 1024.f);
+            ImGui::Text("Save: %.3f ms / Load: %.3f ms",
+                stageManager->GetQuickSaveTimeMS(), stageManager->GetQuickLoadTimeMS());
+        }
+
+        if (m_scene->IsStateHashEnabled())
+        {
+            const TickHash &hash = m_scene->GetStateHash();
+            ImGui::SeparatorText("State hash");
+            ImGui::Text("Tick %llu: %016llx", (unsigned long long)hash.tick, (unsigned long long)hash.value);
+            ImGui::Text("Time: %.3f ms", m_scene->GetStateHashTimeMS());
+        }
+
+        if (RollbackSession *rollback = stageManager->GetRollback())
+        {
+            const RollbackSession::Stats &stats = rollback->GetStats();
+            ImGui::SeparatorText("Rollback");
+            ImGui::Text("Tick: %d", rollback->GetTick());
+            ImGui::Text("Rollbacks: %d (failed %d)", stats.rollbackCount, stats.failedRollbackCount);
+            ImGui::Text("Depth: %d (max %d)", stats.lastRollbackDepth, stats.maxRollbackDepth);
+            ImGui::Text("Resimulation: %.3f ms/tick", stats.GetResimCostMS());
+            ImGui::Text("Snapshot: %.3f ms", stats.GetSaveCostMS());
+            ImGui::Text("Max depth in 16 ms: %d", rollback->GetMaxRollbackDepth(16.f));
+        }
+    }
+
+    if (g_framePacer)
+    {
+        ImGui::SeparatorText("Frame pacing");
+        int mode = (int)g_framePacer->GetMode();
+        float targetFPS = g_framePacer->GetTargetFPS();
+        bool modeChanged = ImGui::Combo("Mode", &mode, "VSync\0Capped\0Uncapped\0");
+        if (mode == (int)FramePacer::Mode::CAPPED)
+        {
+            modeChanged |= ImGui::SliderFloat("Target FPS", &targetFPS, 10.f, 360.f, "%.0f");
+        }
+        if (modeChanged)
+        {
+            g_framePacer->SetMode((FramePacer::Mode)mode, targetFPS);
+        }
+
+        const FramePacer::FrameStats average = g_framePacer->GetAverage();
+        const FramePacer::FrameStats maximum = g_framePacer->GetMaximum();
+        ImGui::Text("Frame: %.2f ms (max %.2f)", (double)average.frameNS / 1e6, (double)maximum.frameNS / 1e6);
+        ImGui::Text("CPU: %.2f ms (max %.2f)", (double)average.cpuNS / 1e6, (double)maximum.cpuNS / 1e6);
+        ImGui::Text("Wait: %.2f ms / Present: %.2f ms",
+            (double)average.waitNS / 1e6, (double)average.presentNS / 1e6);
+
+        float frameTimes[FramePacer::HISTORY_SIZE];
+        const int count = g_framePacer->GetFrameTimesMS(frameTimes);
+        ImGui::PlotLines("##FrameTimes", frameTimes, count, 0, nullptr, 0.f, 50.f, ImVec2(0.f, 60.f));
+    }
+
+    AssetManager *assets = m_scene->GetAssetManager();
+    const std::vector<AssetManager::LoadRecord> &loadRecords = assets->GetLoadRecords();
+    if (loadRecords.empty() == false || g_assetCache)
+    {
+        ImGui::SeparatorText("Asset loading");
+        ImGui::Text("Sprite sheets: %d in %.1f ms",
+            (int)loadRecords.size(), (double)assets->GetLoadTimeNS() / 1e6);
+        if (g_assetCache)
+        {
+            const AssetCache::Stats &cacheStats = g_assetCache->GetStats();
+            ImGui::Text("Cache: %d assets, %.1f / %.1f MB (unused %.1f MB)",
+                g_assetCache->GetEntryCount(),
+                (double)g_assetCache->GetResidentSize() / (1 << 20),
+                (double)g_assetCache->GetBudget() / (1 << 20),
+                (double)g_assetCache->GetUnusedSize() / (1 << 20));
+            ImGui::Text("Hits: %d / Misses: %d / Evictions: %d",
+                cacheStats.hitCount, cacheStats.missCount, cacheStats.evictionCount);
+        }
+        if (ImGui::CollapsingHeader("Load times"))
+        {
+            if (ImGui::BeginTable("LoadTimes", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+            {
+                ImGui::TableSetupColumn("Asset");
+                ImGui::TableSetupColumn("Decode ms");
+                ImGui::TableSetupColumn("Upload ms");
+                ImGui::TableHeadersRow();
+                for (const AssetManager::LoadRecord &record : loadRecords)
+                {
+                    const size_t pos = record.path.find_last_of('/');
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(record.path.c_str() + (pos == std::string::npos ? 0 : pos + 1));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", (double)record.decodeNS / 1e6);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", (double)record.uploadNS / 1e6);
+                }
+                ImGui::EndTable();
+            }
+        }
+    }
+
+    SoundMixer *soundMixer = assets->GetSoundMixer();
+    const SoundMixer::Stats &mixerStats = soundMixer->GetStats();
+    ImGui::SeparatorText("Sound mixer");
+    ImGui::Text("Voices: %d / %d", mixerStats.activeVoiceCount, soundMixer->GetVoiceCount());
+    ImGui::Text("Requests: %d (merged %d)", mixerStats.requestCount, mixerStats.mergedCount);
+    ImGui::Text("Stolen: %d / Dropped: %d", mixerStats.stolenCount, mixerStats.droppedCount);
+    ImGui::Text("Mixing: %.3f ms (%.2f us/call)",
+        (double)mixerStats.mixTimeNS / 1e6,
+        mixerStats.mixCallCount ? (double)mixerStats.mixTimeNS / 1e3 / (double)mixerStats.mixCallCount : 0.0);
+    if (ImGui::Button("Reset##SoundMixer")) soundMixer->ResetStats();
+
     ImGui::SeparatorText("Debug draws");
 
     for (auto &system : m_scene->GetPresentationSystems())
@@ -66,7 +191,10 @@ void ImGuiManager::RenderDebug()
         }
         else if (dynamic_pointer_cast<RenderQuerySystem>(system))
         {
-            ImGui::Checkbox("Render queries", &(system->enabled));
+            if (ImGui::Checkbox("Render queries", &(system->enabled)))
+            {
+                m_scene->SetQueryGizmosEnabled(system->enabled);
+            }
         }
         else if (dynamic_pointer_cast<RenderGridSystem>(system))
         {
@@ -155,16 +283,17 @@ void ImGuiManager::RenderDrawShape()
 void ImGuiManager::RenderGameCommon()
 {
     ImGui::Begin("Game common", &m_showCommon);
+    GameCommon &gameCommon = GameCommon::GetFromScene(m_scene);
 
     ImGui::SeparatorText("Players");
     if (ImGui::BeginTabBar("PlayerTabBar"))
     {
-        for (int i = 0; i < g_gameCommon.playerCount; i++)
+        for (int i = 0; i < gameCommon.playerCount; i++)
         {
             std::string label = std::string("Player ") + std::to_string(i);
             if (ImGui::BeginTabItem(label.c_str()))
             {
-                PlayerConfig *config = g_gameCommon.GetPlayerConfig(i);
+                PlayerConfig *config = gameCommon.GetPlayerConfig(i);
                 ImGui::PushID(config);
 
                 if (ImGui::CollapsingHeader("Config"))
@@ -188,7 +317,7 @@ void ImGuiManager::RenderGameCommon()
                 }
                 ImGui::PopID();
 
-                PlayerStats *stats = g_gameCommon.GetPlayerStats(i);
+                PlayerStats *stats = gameCommon.GetPlayerStats(i);
                 ImGui::PushID(stats);
                 if (ImGui::CollapsingHeader("Stats"))
                 {
@@ -213,7 +342,7 @@ void ImGuiManager::RenderGameCommon()
     }
     ImGui::SeparatorText("Stage");
 
-    StageConfig *stage = &g_gameCommon.stageConfig;
+    StageConfig *stage = &gameCommon.stageConfig;
     if (ImGui::CollapsingHeader("Stage congfig"))
     {
         if (ImGui::BeginTable("StageConfig", 2, ImGuiTableFlags_RowBg))
@@ -350,6 +479,7 @@ void ImGuiManager::Update()
                 dynamic_pointer_cast<RenderQuerySystem>(system))
             {
                 system->enabled = m_showImGui;
+                m_scene->SetQueryGizmosEnabled(m_showImGui);
             }
             if ((m_flags & IM_GUI_GRID) != 0 &&
                 dynamic_pointer_cast<RenderGridSystem>(system))
@@ -469,8 +599,8 @@ void ImGuiManager::Render()
         {
             if (camera.isActive == false) continue;
 
-            SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
-            m_gizmosShape.Render(g_renderer, camera, cameraTransform);
+            m_gizmosShape.Render(m_lineBatch, Colors::White, camera, cameraTransform);
+            m_lineBatch.Render(m_scene->GetRenderer());
             break;
         }
     }
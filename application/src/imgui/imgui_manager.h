@@ -40,6 +40,7 @@ private:
     uint32_t m_flags;
 
     GizmosShape m_gizmosShape;
+    LineBatch m_lineBatch;
     std::vector<b2Vec2> m_points;
     b2Vec2 m_shapeExtents;
     int m_selectedDrawMode;
@@ -7,6 +7,10 @@
 
 #include "common/game_settings.h"
 #include "common/game_common.h"
+#include "common/match_replay.h"
+#include "common/rollback_session.h"
+#include "common/match_farm.h"
+#include "common/match_bench.h"
 
 #include "scene_manager/stage_manager.h"
 #include "scene_manager/title_manager.h"
@@ -30,13 +34,178 @@ enum class GameState
     MAIN_MENU, STAGE
 };
 
+/// @brief Affiche le premier pas fixe où deux simulations divergent.
+/// @return false en cas de divergence.
+bool ReportDivergence(const StateHashLog &logA, const StateHashLog &logB)
+{
+    const StateHashLog::Divergence divergence = StateHashLog::Compare(logA, logB);
+    if (divergence.diverged == false)
+    {
+        std::cout << "State hash : no divergence in "
+            << logA.GetTickCount() << " ticks" << std::endl;
+        return true;
+    }
+
+    std::cout << "State hash : divergence at tick " << divergence.tick;
+    const std::vector<std::string> &categories = logA.GetCategories();
+    if (divergence.category >= 0 && divergence.category < (int)categories.size())
+    {
+        std::cout << " (" << categories[divergence.category] << ")" << std::endl;
+    }
+    else
+    {
+        std::cout << " (tick count " << logA.GetTickCount()
+            << " / " << logB.GetTickCount() << ")" << std::endl;
+    }
+    return false;
+}
+
 int main(int argc, char *argv[])
 {
+    // Options de la ligne de commande
+    //   --record <file> : enregistre chaque match dans un fichier
+    //   --replay <file> : rejoue un match enregistré puis quitte
+    //   --headless      : aucun rendu ni son (avec --replay)
+    //   --fast          : désactive la synchronisation verticale, sans limite
+    //   --fps <n>       : limite l'affichage à n images par seconde, sans
+    //                     synchronisation verticale
+    //   --frame-log <file> : écrit les temps de chaque frame (CSV)
+    //   --rollback <latency> <jitter> <loss> : joue le match en rollback, le
+    //                     joueur 0 étant local et les autres passant par une
+    //                     liaison simulée (délais en ms, pertes en %)
+    //   --hash-log <file> : écrit le hash de l'état après chaque pas fixe
+    //   --verify        : rejoue deux fois le match (avec --replay) et compare
+    //                     les hashs de chaque pas fixe
+    //   --compare-hash <a> <b> : compare deux fichiers écrits avec --hash-log
+    //   --farm <matches> <threads> : joue des matchs entre IA sans rendu,
+    //                     en parallèle, affiche les statistiques puis quitte
+    //   --tick-rate <hz> : nombre de pas fixes de la simulation par seconde
+    //   --bench-match <ticks> : mesure un match entre quatre IA sans rendu
+    //                     (temps de chaque système) puis quitte
+    //   --bench-json <file> : écrit les mesures de --bench-match (JSON)
+    //   --bench-compare <file> <pct> : compare les mesures à une référence,
+    //                     échoue si un écart dépasse pct pourcents
+    //   --asset-budget <MB> : mémoire des assets conservés entre les scènes
+    //                     (0 pour tout recharger à chaque changement de scène)
+    std::string recordPath;
+    std::string replayPath;
+    bool headless = false;
+    bool fast = false;
+    float targetFPS = 0.f;
+    std::string frameLogPath;
+    bool rollbackEnabled = false;
+    LoopbackConfig loopbackConfig;
+    std::string hashLogPath;
+    std::string comparePaths[2];
+    bool verify = false;
+    MatchFarm::Config farmConfig;
+    bool farm = false;
+    float tickRate = SceneContext::DEFAULT_TICK_RATE;
+    MatchBench::Config benchConfig;
+    bool benchMatch = false;
+    std::string benchJsonPath;
+    std::string benchBaselinePath;
+    double benchThreshold = 10.0;
+    size_t assetBudget = AssetCache::DEFAULT_BUDGET;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (arg == "--headless") headless = true;
+        else if (arg == "--fast") fast = true;
+        else if (arg == "--fps" && i + 1 < argc) targetFPS = std::max(1.f, (float)atof(argv[++i]));
+        else if (arg == "--frame-log" && i + 1 < argc) frameLogPath = argv[++i];
+        else if (arg == "--hash-log" && i + 1 < argc) hashLogPath = argv[++i];
+        else if (arg == "--verify") verify = true;
+        else if (arg == "--compare-hash" && i + 2 < argc)
+        {
+            comparePaths[0] = argv[++i];
+            comparePaths[1] = argv[++i];
+        }
+        else if (arg == "--farm" && i + 2 < argc)
+        {
+            farm = true;
+            farmConfig.matchCount = std::max(1, atoi(argv[++i]));
+            farmConfig.threadCount = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--bench-match" && i + 1 < argc)
+        {
+            benchMatch = true;
+            benchConfig.tickCount = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--bench-json" && i + 1 < argc) benchJsonPath = argv[++i];
+        else if (arg == "--bench-compare" && i + 2 < argc)
+        {
+            benchBaselinePath = argv[++i];
+            benchThreshold = atof(argv[++i]);
+        }
+        else if (arg == "--asset-budget" && i + 1 < argc)
+        {
+            assetBudget = (size_t)std::max(0, atoi(argv[++i])) << 20;
+        }
+        else if (arg == "--tick-rate" && i + 1 < argc)
+        {
+            tickRate = std::clamp((float)atof(argv[++i]), 1.f, 1000.f);
+        }
+        else if (arg == "--rollback" && i + 3 < argc)
+        {
+            rollbackEnabled = true;
+            loopbackConfig.latencyMS = (Uint64)std::max(0, atoi(argv[++i]));
+            loopbackConfig.jitterMS = (Uint64)std::max(0, atoi(argv[++i]));
+            loopbackConfig.lossRate = std::clamp((float)atof(argv[++i]) / 100.f, 0.f, 1.f);
+        }
+        else std::cout << "ERROR - Unknown argument " << arg << std::endl;
+    }
+
+    // Comparaison de deux exécutions, sans lancer le jeu
+    if (comparePaths[0].empty() == false)
+    {
+        StateHashLog logA, logB;
+        if (logA.Load(comparePaths[0]) == false || logB.Load(comparePaths[1]) == false)
+        {
+            return EXIT_FAILURE;
+        }
+        return ReportDivergence(logA, logB) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    MatchReplay replay;
+    if (replayPath.empty() == false && replay.Load(replayPath) == false)
+    {
+        return EXIT_FAILURE;
+    }
+    const bool replaying = replayPath.empty() == false;
+    const bool recording = recordPath.empty() == false && replaying == false;
+    if (replaying == false) headless = false;
+    if (farm || benchMatch) headless = true;
+    if (replaying && rollbackEnabled)
+    {
+        std::cout << "ERROR - --rollback cannot be used with --replay" << std::endl;
+        rollbackEnabled = false;
+    }
+    if (verify && replaying == false)
+    {
+        std::cout << "ERROR - --verify requires --replay" << std::endl;
+        verify = false;
+    }
+    if (headless) fast = true;
+
     // Initialisation de la SDL
+    if (headless)
+    {
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
     const Uint32 sdlFlags = SDL_INIT_VIDEO | SDL_INIT_GAMEPAD | SDL_INIT_AUDIO;
     const Uint32 mixFlags = 0;
     game::Init(sdlFlags, mixFlags);
 
+    // Les assets sont lus dans l'archive si elle existe, sinon dans les fichiers
+    AssetPack assetPack;
+    if (assetPack.Open(ASSETS_PATH "assets.pak", ASSETS_PATH))
+    {
+        AssetManager::SetAssetPack(&assetPack);
+    }
+
     game::SetMusicVolume(0.8f);
     game::SetFXChannelsVolume(0.5f);
 
@@ -45,10 +214,22 @@ int main(int argc, char *argv[])
 #ifdef FULLSCREEN
     windowFlags |= SDL_WINDOW_FULLSCREEN;
 #endif
+    if (headless) windowFlags = SDL_WINDOW_HIDDEN;
     game::CreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Super Pixel Smash", windowFlags);
     game::CreateRenderer(LOGICAL_WIDTH, LOGICAL_HEIGHT);
-
-    srand((unsigned int)time(nullptr));
+    if (fast)
+    {
+        g_framePacer->SetMode(FramePacer::Mode::UNCAPPED);
+    }
+    else if (targetFPS > 0.f)
+    {
+        g_framePacer->SetMode(FramePacer::Mode::CAPPED, targetFPS);
+    }
+    if (frameLogPath.empty() == false)
+    {
+        g_framePacer->OpenLog(frameLogPath);
+    }
+    g_assetCache->SetBudget(assetBudget);
 
     // Input manager
     SceneManager *sceneManger = nullptr;
@@ -88,19 +269,98 @@ int main(int argc, char *argv[])
 
     g_gameCommon.UpdatePlayerConfigs();
 
+    // Mesure des performances d'un match entre IA, sans boucle de jeu
+    if (benchMatch)
+    {
+        benchConfig.tickRate = tickRate;
+        MatchBench matchBench(g_gameCommon, benchConfig);
+        matchBench.Run();
+        matchBench.PrintReport();
+
+        bool success = true;
+        if (benchJsonPath.empty() == false)
+        {
+            success &= matchBench.SaveJSON(benchJsonPath);
+        }
+        if (benchBaselinePath.empty() == false)
+        {
+            success &= matchBench.Compare(benchBaselinePath, benchThreshold);
+        }
+
+        delete inputManager; inputManager = nullptr;
+        game::DestroyRenderer();
+        game::DestroyWindow();
+        game::Quit();
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Matchs entre IA sur plusieurs threads, sans boucle de jeu
+    if (farm)
+    {
+        farmConfig.seed = (uint64_t)time(nullptr);
+        farmConfig.tickRate = tickRate;
+        MatchFarm matchFarm(g_gameCommon, farmConfig);
+        matchFarm.Run();
+        matchFarm.PrintSummary();
+
+        delete inputManager; inputManager = nullptr;
+        game::DestroyRenderer();
+        game::DestroyWindow();
+        game::Quit();
+        return EXIT_SUCCESS;
+    }
+
 #ifdef SKIP_MENU
     state = GameState::STAGE;
 #endif
 
+    // Le replay remplace la configuration et lance directement le match
+    if (replaying)
+    {
+        replay.StartPlayback();
+        state = GameState::STAGE;
+    }
+    Uint64 replayStartMS = SDL_GetTicks();
+    bool replayDesync = false;
+
+    // Hashs de l'état (deux exécutions avec --verify)
+    StateHashLog hashLogs[2];
+    int verifyPass = 0;
+    bool verifyFailed = false;
+
     // Boucle de jeu
+    std::unique_ptr<LoopbackLink> loopbackLink;
+    std::unique_ptr<RollbackSession> rollback;
+    Uint64 transitionStartNS = 0;
     while (quitGame == false)
     {
         // Construction de la scène
         switch (state)
         {
         case GameState::STAGE:
-            sceneManger = new StageManager(inputManager);
+        {
+            if (rollbackEnabled)
+            {
+                loopbackConfig.seed = (uint32_t)time(nullptr);
+                loopbackLink = std::make_unique<LoopbackLink>(loopbackConfig);
+                rollback = std::make_unique<RollbackSession>(loopbackLink->GetEndpoint(0), 0x1);
+                rollback->SetLoopbackPeer(loopbackLink->GetEndpoint(1), loopbackLink.get());
+            }
+            SceneContext stageContext;
+            stageContext.tickRate = tickRate;
+            sceneManger = new StageManager(
+                inputManager, (replaying || recording) ? &replay : nullptr,
+                rollback.get(), stageContext
+            );
+            if (verify || hashLogPath.empty() == false)
+            {
+                Scene *stageScene = sceneManger->GetScene();
+                hashLogs[verifyPass].Clear();
+                stageScene->SetStateHashEnabled(true);
+                stageScene->SetStateHashLog(&hashLogs[verifyPass]);
+            }
             break;
+        }
 
         case GameState::MAIN_MENU:
         default:
@@ -108,9 +368,22 @@ int main(int argc, char *argv[])
             break;
         }
 
+        // Durée d'un changement de scène (destruction et construction)
+        if (transitionStartNS > 0)
+        {
+            const AssetCache::Stats &cacheStats = g_assetCache->GetStats();
+            std::cout << "INFO - Scene transition: "
+                << (double)(SDL_GetTicksNS() - transitionStartNS) / 1e6 << " ms (assets: "
+                << g_assetCache->GetEntryCount() << " cached, "
+                << (g_assetCache->GetResidentSize() >> 20) << " MB, "
+                << cacheStats.hitCount << " hits, "
+                << cacheStats.missCount << " misses)" << std::endl;
+        }
+
         // Boucle de rendu
         while (true)
         {
+            g_framePacer->BeginFrame();
             g_time->Update();
 
             // Met à jour la scène
@@ -126,6 +399,9 @@ int main(int argc, char *argv[])
             if (sceneManger->ShouldQuitScene())
                 break;
 
+            if (headless)
+                continue;
+
             // Efface le rendu précédent
             SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, 255);
             SDL_RenderClear(g_renderer);
@@ -134,7 +410,7 @@ int main(int argc, char *argv[])
             scene->Render();
 
             // Affiche le nouveau rendu
-            SDL_RenderPresent(g_renderer);
+            g_framePacer->EndFrame();
         }
 
         if (sceneManger->ShouldQuitGame())
@@ -142,10 +418,72 @@ int main(int argc, char *argv[])
             quitGame = true;
         }
 
+        if (state == GameState::STAGE && recording)
+        {
+            replay.Save(recordPath);
+        }
+        if (state == GameState::STAGE && hashLogPath.empty() == false && verifyPass == 0)
+        {
+            hashLogs[0].Save(hashLogPath);
+        }
+        bool restartStage = false;
+        if (state == GameState::STAGE && replaying)
+        {
+            const Uint64 wallMS = SDL_GetTicks() - replayStartMS;
+            std::cout << "Replay " << replayPath << std::endl;
+            std::cout << "  frames        : " << replay.GetFrameCount() << std::endl;
+            std::cout << "  fixed updates : " << replay.GetFixedUpdateCount() << std::endl;
+            std::cout << "  wall time     : " << wallMS << " ms" << std::endl;
+            std::cout << "  desync        : " << (replay.HasDesync() ? "yes" : "no") << std::endl;
+            replayDesync = replayDesync || replay.HasDesync();
+            for (int i = 0; i < g_gameCommon.playerCount; i++)
+            {
+                const PlayerStats *stats = g_gameCommon.GetPlayerStats(i);
+                std::cout << "  player " << i
+                    << " : ko " << stats->koCount
+                    << ", falls " << stats->fallCount
+                    << ", damage " << stats->damageGiven << "/" << stats->damageTaken
+                    << std::endl;
+            }
+            quitGame = true;
+
+            // Seconde exécution du même replay
+            if (verify && verifyPass == 0 && appInput->quitPressed == false)
+            {
+                verifyPass = 1;
+                replay.StartPlayback();
+                replayStartMS = SDL_GetTicks();
+                restartStage = true;
+                quitGame = false;
+            }
+            else if (verify && verifyPass == 1)
+            {
+                verifyFailed = (ReportDivergence(hashLogs[0], hashLogs[1]) == false);
+            }
+        }
+        if (state == GameState::STAGE && rollback)
+        {
+            const RollbackSession::Stats &stats = rollback->GetStats();
+            std::cout << "Rollback (latency " << loopbackConfig.latencyMS
+                << " ms, jitter " << loopbackConfig.jitterMS
+                << " ms, loss " << 100.f * loopbackConfig.lossRate << " %)" << std::endl;
+            std::cout << "  ticks         : " << stats.tickCount << std::endl;
+            std::cout << "  rollbacks     : " << stats.rollbackCount
+                << " (max depth " << stats.maxRollbackDepth
+                << ", failed " << stats.failedRollbackCount << ")" << std::endl;
+            std::cout << "  resimulated   : " << stats.resimulatedTicks
+                << " ticks, " << stats.GetResimCostMS() << " ms/tick" << std::endl;
+            std::cout << "  snapshot      : " << stats.GetSaveCostMS() << " ms" << std::endl;
+            std::cout << "  max depth     : " << rollback->GetMaxRollbackDepth(16.f)
+                << " ticks in 16 ms" << std::endl;
+            std::cout << "  packets       : " << loopbackLink->GetSentCount()
+                << " sent, " << loopbackLink->GetLostCount() << " lost" << std::endl;
+        }
+
         switch (state)
         {
         case GameState::STAGE:
-            state = GameState::MAIN_MENU;
+            state = restartStage ? GameState::STAGE : GameState::MAIN_MENU;
             break;
 
         case GameState::MAIN_MENU:
@@ -154,11 +492,14 @@ int main(int argc, char *argv[])
             break;
         }
 
+        transitionStartNS = SDL_GetTicksNS();
         if (sceneManger)
         {
             delete sceneManger;
             sceneManger = nullptr;
         }
+        rollback.reset();
+        loopbackLink.reset();
     }
 
     delete inputManager; inputManager = nullptr;
@@ -166,5 +507,5 @@ int main(int argc, char *argv[])
     game::DestroyWindow();
     game::Quit();
 
-    return EXIT_SUCCESS;
+    return (replayDesync || verifyFailed) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
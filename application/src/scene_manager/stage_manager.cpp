@@ -6,6 +6,7 @@
 
 #include "scene_manager/stage_manager.h"
 #include "imgui/imgui_manager.h"
+#include "common/loading_screen.h"
 
 #include "ecs/common/camera.h"
 #include "ecs/common/damage_utils.h"
@@ -23,6 +24,8 @@
 #include "ecs/player/water_priestess_system.h"
 #include "ecs/player/Metal_Bladekeeper_system.h"
 #include "ecs/player/player_ai.h"
+#include "ecs/player/player_replay_system.h"
+#include "ecs/player/player_rollback_system.h"
 
 #include "ecs/item/potion.h"
 #include "ecs/item/bomb.h"
@@ -30,36 +33,90 @@
 #include "ecs/stage/star_fields_terrain.h"
 #include "ecs/stage/star_fields_platform.h"
 
-StageManager::StageManager(InputManager *inputManager)
-    : SceneManager(inputManager)
+/// @brief Composants de l'application sauvegards dans les snapshots du niveau.
+using StageSnapshotComponents = entt::type_list_cat_t<
+    BasicSnapshotComponents,
+    entt::type_list<
+        PlayerControllerInput, PlayerController, PlayerAnimInfo, PlayerAI,
+        FireKnightTag, WaterPriestessTag, MetalBladekeeperTag,
+        PlayerAffiliation, Damageable, TrackedTarget, VisualID, ShieldTag,
+        GroundContact, OneWayPass, ReferencePosition,
+        KinematicTargetPosition, KinematicTargetRotation, FloatingPlatform,
+        BombTag, PotionTag, CameraFollow
+    >
+>;
+
+StageManager::StageManager(
+    InputManager *inputManager, MatchReplay *replay, RollbackSession *rollback,
+    const SceneContext &context)
+    : SceneManager(inputManager, context)
     , m_oneWayCallback(GetScene())
     , m_state(State::FIGHT)
     , m_paused(false)
     , m_pauseMenu(nullptr)
+    , m_stageHUD(nullptr)
     , m_delayStage(0.f)
     , m_delayBomb(-1.f)
     , m_delayPotion(-1.f)
+    , m_replay(replay)
+    , m_rollback(rollback)
+    , m_quickSave()
+    , m_saveStateRequested(false)
+    , m_loadStateRequested(false)
+    , m_quickSaveTimeMS(0.f)
+    , m_quickLoadTimeMS(0.f)
 {
     Scene *scene = GetScene();
     entt::registry &registry = scene->GetRegistry();
+    GameCommon &gameCommon = GameCommon::GetFromScene(scene);
+
+    // Replay : la graine du gnrateur alatoire et la configuration
+    // sont enregistres pour reproduire exactement le match
+    if (m_replay)
+    {
+        if (m_replay->IsPlaying() == false)
+        {
+            m_replay->StartRecording((unsigned int)time(nullptr), scene->GetTickRate());
+        }
+        scene->SeedRandom(m_replay->GetSeed());
+        scene->SetTickRate(m_replay->GetTickRate());
+
+        Uint64 deltaNS = 0;
+        if (m_replay->IsPlaying() && m_replay->NextFrame(deltaNS))
+        {
+            scene->SetNextDeltaNS(deltaNS);
+        }
+    }
     SpriteAnimManager *animManager = scene->GetAnimManager();
     animManager->SetAnimIDToString(assets::AnimIDToString);
 
     AssetManager *assets = scene->GetAssetManager();
-    assets::InitAssets(assets);
+    LoadingScreen loadingScreen(scene->GetRenderer());
+    assets::InitAssets(assets, loadingScreen.GetCallback());
     assets::InitTextures(assets);
     assets::InitFonts(assets);
+    if (scene->IsHeadless() == false)
+    {
+        game::UpdateFontSize(scene);
+    }
     assets::InitMusic(assets);
     assets::InitSFX(assets);
     assets::InitSpriteAnimations(scene);
 
-    std::shared_ptr<ImGuiManager> imGuiManager = std::make_shared<ImGuiManager>(scene);
-    scene->SetImGuiManager(imGuiManager);
-    imGuiManager->SetFlags(
-        IM_GUI_PHYSICS |
-        IM_GUI_QUERY |
-        IM_GUI_ENTITY_INSPECTOR
-    );
+    //--------------------------------------------------------------------------
+    // Groupes propritaires des combinaisons de composants les plus parcourues
+
+    scene->RegisterGroup<Transform, FixedUpdateTransform>(entt::get<>, entt::exclude<LocalTransform>);
+    scene->RegisterGroup<Sprite, SpriteAnimState>();
+    scene->RegisterGroup<
+        Rigidbody,
+        Damageable,
+        PlayerControllerInput,
+        PlayerController,
+        GroundContact,
+        PlayerAffiliation,
+        PlayerAnimInfo
+    >();
 
     //--------------------------------------------------------------------------
     // Simulation Systems
@@ -76,6 +133,8 @@ StageManager::StageManager(InputManager *inputManager)
     // Player
     scene->AddSimulationSystem(std::make_shared<PlayerInputSystem>(scene));
     scene->AddSimulationSystem(std::make_shared<PlayerAISystem>(scene));
+    scene->AddSimulationSystem(std::make_shared<PlayerReplaySystem>(scene));
+    scene->AddSimulationSystem(std::make_shared<PlayerRollbackSystem>(scene));
     scene->AddSimulationSystem(std::make_shared<PlayerControllerSystem>(scene));
     scene->AddSimulationSystem(std::make_shared<FireKnightSystem>(scene));
     scene->AddSimulationSystem(std::make_shared<WaterPriestessSystem>(scene));
@@ -90,129 +149,87 @@ StageManager::StageManager(InputManager *inputManager)
     scene->AddSimulationSystem(std::make_shared<VisualIDSimulationSystem>(scene));
     scene->AddSimulationSystem(std::make_shared<WorldBoundsSystem>(scene));
 
-    //--------------------------------------------------------------------------
-    // Presentation Systems
-
-    scene->AddPresentationSystem(std::make_shared<CameraSystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderGameSystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderUISystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderQuerySystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderPhysicsSystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderGridSystem>(scene));
-    scene->AddPresentationSystem(std::make_shared<RenderImGuiSystem>(scene, imGuiManager));
-
-    //--------------------------------------------------------------------------
-    // Composants ImGui
-
-    // Transform & physics
-    imGuiManager->AddComponent(std::make_unique<ImGuiTransform>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiFixedUpdateTransform>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiLocalTransform>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiRigidbody>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiReferencePosition>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiKinematicTargetPosition>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiKinematicTargetRotation>());
-
-    // Render
-    imGuiManager->AddComponent(std::make_unique<ImGuiRenderSortingLayer>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiRenderBlendMod>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiRenderColorMod>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiSprite>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiTiledSprite>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiTilemapRenderer>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiBackgroundLayer>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiSpriteAnimState>(scene));
-
-    // Camera
-    imGuiManager->AddComponent(std::make_unique<ImGuiCamera>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiCameraFollow>());
-
-    // Ground
-    imGuiManager->AddComponent(std::make_unique<ImGuiGroundContact>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiOneWayPass>());
-
-    // Player
-    imGuiManager->AddComponent(std::make_unique<ImGuiDamageable>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAffiliation>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAI>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerControllerInput>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerController>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAnimInfo>());
-    imGuiManager->AddComponent(std::make_unique<ImGuiTrackedTarget>());
-
-    // Other
-    imGuiManager->AddComponent(std::make_unique<ImGuiVisualID>());
-
-    // Tag
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<ShieldTag>>("Shield tag"));
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<FireKnightTag>>("Fire knight tag"));
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<WaterPriestessTag>>("Water priestess tag"));
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<MetalBladekeeperTag>>("Metal Bladekeeper tag"));
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<PotionTag>>("Potion tag"));
-    imGuiManager->AddTag(std::make_unique<ImGuiTag<BombTag>>("Bomb tag"));
+    // Un match sans rendu n'a ni systmes de prsentation, ni ImGui
+    // (son contexte est global), ni interface utilisateur
+    if (scene->IsHeadless() == false)
+    {
+        InitPresentation();
+    }
 
     //--------------------------------------------------------------------------
     // Cration du niveau
 
     // Stats
-    g_gameCommon.ResetPlayerStats();
+    gameCommon.ResetPlayerStats();
+
+    // Vrification du dterminisme
+    InitStateHash();
 
     // Stage
     InitStarFields();
 
     // Limite de temps
-    if (g_gameCommon.stageConfig.mode == StageConfig::Mode::LIMITED_TIME)
+    if (gameCommon.stageConfig.mode == StageConfig::Mode::LIMITED_TIME)
     {
-        m_delayStage = (float)g_gameCommon.stageConfig.duration * 60.f;
+        m_delayStage = (float)gameCommon.stageConfig.duration * 60.f;
     }
 
     // Camra
     CameraCommand::Create(registry, registry.create(), scene, b2Vec2{ 0.f, 1.f });
 
     // Cre l'interface utilisateur
-    m_stageHUD = new UIStageHUD(scene);
+    if (scene->IsHeadless() == false)
+    {
+        m_stageHUD = new UIStageHUD(scene);
+    }
 
     // Dlais pour les potions et les bombes
-    //m_delayBomb = random::RangeF(5.f, 15.f);
-    //m_delayPotion = random::RangeF(5.f, 15.f);
+    //m_delayBomb = scene->GetRandom().RangeF(5.f, 15.f);
+    //m_delayPotion = scene->GetRandom().RangeF(5.f, 15.f);
     // dlais bombes
 	
-    switch (g_gameCommon.stageConfig.bombsFrequency)
+    switch (gameCommon.stageConfig.bombsFrequency)
     {
         case StageConfig::Frequency::NEVER:
             m_delayBomb = 0;
         break;
         case StageConfig::Frequency::RARELY:
-            m_delayBomb = random::RangeF(20.f, 30.f);
+            m_delayBomb = scene->GetRandom().RangeF(20.f, 30.f);
             break;
         case StageConfig::Frequency::SOMETIMES:
-            m_delayBomb = random::RangeF(10.f, 20.f);
+            m_delayBomb = scene->GetRandom().RangeF(10.f, 20.f);
             break;
         case StageConfig::Frequency::OFTEN:
-            m_delayBomb = random::RangeF(5.f, 10.f);
+            m_delayBomb = scene->GetRandom().RangeF(5.f, 10.f);
             break;
         default:
             break;
     }
 
     //dlais potions
-    switch (g_gameCommon.stageConfig.potionFrequency)
+    switch (gameCommon.stageConfig.potionFrequency)
     {
     case StageConfig::Frequency::NEVER:
         m_delayPotion = 0;
         break;
     case StageConfig::Frequency::RARELY:
-        m_delayPotion = random::RangeF(20.f, 30.f);
+        m_delayPotion = scene->GetRandom().RangeF(20.f, 30.f);
         break;
     case StageConfig::Frequency::SOMETIMES:
-        m_delayPotion = random::RangeF(10.f, 20.f);
+        m_delayPotion = scene->GetRandom().RangeF(10.f, 20.f);
         break;
     case StageConfig::Frequency::OFTEN:
-        m_delayPotion = random::RangeF(5.f, 10.f);
+        m_delayPotion = scene->GetRandom().RangeF(5.f, 10.f);
         break;
     default:
         break;
     }
+
+    // Rollback : snapshot du premier tick
+    if (m_rollback)
+    {
+        m_rollback->Start(this);
+    }
 }
 
 StageManager::~StageManager()
@@ -224,16 +241,17 @@ void StageManager::OnSceneUpdate()
     Scene *scene = GetScene();
     InputManager *inputManager = scene->GetInputManager();
     ApplicationInput *applicationInput = ApplicationInput::GetFromManager(inputManager);
+    GameCommon &gameCommon = GameCommon::GetFromScene(scene);
 
     m_delayStage -= scene->GetDelta();
     PlayerStats *player;
-    switch(g_gameCommon.stageConfig.mode)
+    switch(gameCommon.stageConfig.mode)
     {
     default:
     case StageConfig::Mode::LIMITED_LIVES:
-        for (int i = 0; i < g_gameCommon.playerCount; i++) {
-            player = g_gameCommon.GetPlayerStats(i);
-            if (player->fallCount >= g_gameCommon.stageConfig.lifeCount)
+        for (int i = 0; i < gameCommon.playerCount; i++) {
+            player = gameCommon.GetPlayerStats(i);
+            if (player->fallCount >= gameCommon.stageConfig.lifeCount)
                 QuitScene();
         }
         break;
@@ -245,7 +263,29 @@ void StageManager::OnSceneUpdate()
         break;
     }
 
-    if (applicationInput->pausePressed)
+    // Replay : impose l'cart de temps de la prochaine frame
+    const bool isReplaying = m_replay && m_replay->IsPlaying();
+    if (isReplaying && m_replay->IsFinished() == false)
+    {
+        Uint64 deltaNS = 0;
+        if (m_replay->NextFrame(deltaNS))
+        {
+            scene->SetNextDeltaNS(deltaNS);
+        }
+        else
+        {
+            QuitGame();
+        }
+    }
+
+    // Rollback : fin du tick, avec retour en arrire si une prdiction tait fausse
+    if (m_rollback)
+    {
+        m_rollback->Update(this);
+    }
+
+    // La pause modifierait le droulement du replay et de la session rseau
+    if (applicationInput->pausePressed && isReplaying == false && m_rollback == nullptr)
     {
         if (m_paused)
         {
@@ -269,13 +309,18 @@ void StageManager::OnSceneUpdate()
         }
     }
 
-    game::UpdateFontSize(scene);
+    ProcessStateRequests();
+
+    if (scene->IsHeadless() == false)
+    {
+        game::UpdateFontSize(scene);
+    }
 }
 
 void StageManager::OnSceneFixedUpdate()
 {
     Scene *scene = GetScene();
-    const StageConfig &stageConfig = g_gameCommon.stageConfig;
+    const StageConfig &stageConfig = GameCommon::GetFromScene(scene).stageConfig;
     if (m_state == State::FIGHT)
     {
         if (stageConfig.bombsFrequency != StageConfig::Frequency::NEVER)
@@ -305,6 +350,61 @@ void StageManager::QuitPause()
     GetScene()->GetTime().SetTimeScale(1.f);
 }
 
+void StageManager::SaveState(SceneSnapshot &snapshot)
+{
+    snapshot.Capture(GetScene(), StageSnapshotComponents{});
+
+    SnapshotWriter &writer = snapshot.GetWriter();
+    writer.Write(m_state);
+    writer.Write(m_delayStage);
+    writer.Write(m_delayBomb);
+    writer.Write(m_delayPotion);
+    writer.Write(GameCommon::GetFromScene(GetScene()).playerStats);
+}
+
+bool StageManager::LoadState(SceneSnapshot &snapshot, SceneSnapshot::RestoreMode mode)
+{
+    if (snapshot.Restore(GetScene(), StageSnapshotComponents{}, mode) == false)
+        return false;
+
+    SnapshotReader &reader = snapshot.GetReader();
+    State state = m_state;
+    float delayStage = m_delayStage;
+    reader.Read(state);
+    reader.Read(delayStage);
+    if (mode == SceneSnapshot::RestoreMode::FULL)
+    {
+        m_state = state;
+        m_delayStage = delayStage;
+    }
+    reader.Read(m_delayBomb);
+    reader.Read(m_delayPotion);
+    reader.Read(GameCommon::GetFromScene(GetScene()).playerStats);
+    return reader.IsValid();
+}
+
+void StageManager::ProcessStateRequests()
+{
+    // Les snapshots sont pris entre deux mises  jour, jamais pendant
+    // l'excution des systmes
+    if (m_saveStateRequested)
+    {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        SaveState(m_quickSave);
+        m_quickSaveTimeMS = (float)(1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+            / (double)SDL_GetPerformanceFrequency());
+        m_saveStateRequested = false;
+    }
+    if (m_loadStateRequested && m_quickSave.IsEmpty() == false)
+    {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        LoadState(m_quickSave);
+        m_quickLoadTimeMS = (float)(1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+            / (double)SDL_GetPerformanceFrequency());
+    }
+    m_loadStateRequested = false;
+}
+
 StageManager *StageManager::GetFromScene(Scene *scene)
 {
     if (scene == nullptr)
@@ -320,10 +420,10 @@ void StageManager::AddPotion()
     Scene *scene = GetScene();
     entt::registry &registry = scene->GetRegistry();
 
-    b2Vec2 position = { random::RangeF(-6.f, 6.f), 10.f };
+    b2Vec2 position = { scene->GetRandom().RangeF(-6.f, 6.f), 10.f };
     PotionCommand::Create(registry, registry.create(), scene, position);
 
-    m_delayPotion = random::RangeF(15.f, 30.f);
+    m_delayPotion = scene->GetRandom().RangeF(15.f, 30.f);
 }
 
 void StageManager::AddBomb()
@@ -331,11 +431,138 @@ void StageManager::AddBomb()
     Scene *scene = GetScene();
     entt::registry &registry = scene->GetRegistry();
 
-    b2Vec2 position = { random::RangeF(-7.f, 7.f), 10.f };
-    b2Vec2 velocity = { random::RangeF(-3.f, 3.f), 0.f };
+    b2Vec2 position = { scene->GetRandom().RangeF(-7.f, 7.f), 10.f };
+    b2Vec2 velocity = { scene->GetRandom().RangeF(-3.f, 3.f), 0.f };
     BombCommand::Create(registry, registry.create(), scene, position, velocity);
 
-    m_delayBomb = random::RangeF(7.f, 20.f);
+    m_delayBomb = scene->GetRandom().RangeF(7.f, 20.f);
+}
+
+void StageManager::InitStateHash()
+{
+    Scene *scene = GetScene();
+
+    scene->AddStateHashCategory("PlayerController", [](Scene *scene, StateHasher &hasher)
+    {
+        hasher.AddComponents<PlayerController>(scene->GetRegistry(),
+            [](StateHasher &h, const PlayerController &controller)
+        {
+            h.Add(controller.currState);
+            h.Add(controller.prevState);
+            h.Add(controller.externalVelocity);
+            h.Add(controller.hVelocity);
+            h.Add(controller.hasAutoVelocity);
+            h.Add(controller.facingRight);
+            h.Add(controller.shieldPower);
+            h.Add(controller.smashMultiplier);
+            h.Add(controller.airAttackCount);
+            h.Add(controller.bonusJumpCount);
+            h.Add(controller.delayEarlyJump);
+            h.Add(controller.delayAttack);
+            h.Add(controller.delayRoll);
+            h.Add(controller.delaySmashReleaseMin);
+            h.Add(controller.delaySmashReleaseMax);
+            h.Add(controller.delayCoyoteJump);
+            h.Add(controller.delayBonusJump);
+            h.Add(controller.delayClearLastDamager);
+            h.Add(controller.lastDamagerEntity);
+            h.Add(controller.lastDamagerAffiliation.playerID);
+        });
+    });
+
+    scene->AddStateHashCategory("Damageable", [](Scene *scene, StateHasher &hasher)
+    {
+        hasher.AddComponents<Damageable>(scene->GetRegistry(),
+            [](StateHasher &h, const Damageable &damageable)
+        {
+            h.Add(damageable.cumulativeDamage.amount);
+            h.Add(damageable.cumulativeDamage.lockTime);
+            h.Add(damageable.cumulativeDamage.lockAttackTime);
+            h.Add(damageable.cumulativeDamage.ejectionSpeed);
+            h.Add(damageable.cumulativeDamage.ejectionType);
+            h.Add(damageable.cumulativeDamage.attackCenter);
+            h.Add(damageable.cumulativeDamage.direction);
+            h.Add(damageable.lastDamagerAffiliation.playerID);
+            h.Add(damageable.lastDamagerEntity);
+            h.Add(damageable.ejectionScore);
+            h.Add(damageable.lockTime);
+            h.Add(damageable.lockAttackTime);
+        });
+    });
+}
+
+void StageManager::InitPresentation()
+{
+    Scene *scene = GetScene();
+
+    std::shared_ptr<ImGuiManager> imGuiManager = std::make_shared<ImGuiManager>(scene);
+    scene->SetImGuiManager(imGuiManager);
+    imGuiManager->SetFlags(
+        IM_GUI_PHYSICS |
+        IM_GUI_QUERY |
+        IM_GUI_ENTITY_INSPECTOR
+    );
+
+    //--------------------------------------------------------------------------
+    // Presentation Systems
+
+    scene->AddPresentationSystem(std::make_shared<CameraSystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderGameSystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderUISystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderQuerySystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderPhysicsSystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderGridSystem>(scene));
+    scene->AddPresentationSystem(std::make_shared<RenderImGuiSystem>(scene, imGuiManager));
+
+    //--------------------------------------------------------------------------
+    // Composants ImGui
+
+    // Transform & physics
+    imGuiManager->AddComponent(std::make_unique<ImGuiTransform>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiFixedUpdateTransform>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiLocalTransform>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiRigidbody>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiReferencePosition>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiKinematicTargetPosition>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiKinematicTargetRotation>());
+
+    // Render
+    imGuiManager->AddComponent(std::make_unique<ImGuiRenderSortingLayer>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiRenderBlendMod>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiRenderColorMod>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiSprite>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiTiledSprite>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiTilemapRenderer>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiBackgroundLayer>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiSpriteAnimState>(scene));
+
+    // Camera
+    imGuiManager->AddComponent(std::make_unique<ImGuiCamera>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiCameraFollow>());
+
+    // Ground
+    imGuiManager->AddComponent(std::make_unique<ImGuiGroundContact>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiOneWayPass>());
+
+    // Player
+    imGuiManager->AddComponent(std::make_unique<ImGuiDamageable>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAffiliation>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAI>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerControllerInput>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerController>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiPlayerAnimInfo>());
+    imGuiManager->AddComponent(std::make_unique<ImGuiTrackedTarget>());
+
+    // Other
+    imGuiManager->AddComponent(std::make_unique<ImGuiVisualID>());
+
+    // Tag
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<ShieldTag>>("Shield tag"));
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<FireKnightTag>>("Fire knight tag"));
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<WaterPriestessTag>>("Water priestess tag"));
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<MetalBladekeeperTag>>("Metal Bladekeeper tag"));
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<PotionTag>>("Potion tag"));
+    imGuiManager->AddTag(std::make_unique<ImGuiTag<BombTag>>("Bomb tag"));
 }
 
 void StageManager::InitStarFields()
@@ -354,7 +581,8 @@ void StageManager::InitStarFields()
         b2Vec2(-6.f, 0.05f), b2Vec2(+6.f, 0.05f),
         b2Vec2(-2.f, 0.05f), b2Vec2(+2.f, 0.05f),
     };
-    for (int playerID = 0; playerID < g_gameCommon.playerCount; playerID++)
+    const int playerCount = GameCommon::GetFromScene(scene).playerCount;
+    for (int playerID = 0; playerID < playerCount; playerID++)
     {
         PlayerCommand::Create(
             registry, registry.create(), scene,
@@ -8,6 +8,8 @@
 
 #include "common/game_settings.h"
 #include "common/game_common.h"
+#include "common/match_replay.h"
+#include "common/rollback_session.h"
 
 #include "ui/stage/ui_stage_hud.h"
 #include "ui/stage/ui_pause_menu.h"
@@ -17,7 +19,16 @@
 class StageManager : public SceneManager
 {
 public:
-    StageManager(InputManager *inputManager);
+    /// @brief Cre le niveau.
+    /// @param inputManager le gestionnaire des entres.
+    /// @param replay l'enregistrement  complter ou  rejouer (optionnel).
+    /// @param rollback la session rseau avec rollback (optionnel).
+    /// @param context le contexte de la scne. Un contexte sans rendu
+    /// permet de jouer le match sur un autre thread.
+    StageManager(
+        InputManager *inputManager, MatchReplay *replay = nullptr,
+        RollbackSession *rollback = nullptr,
+        const SceneContext &context = SceneContext());
     virtual ~StageManager();
 
     virtual void OnSceneUpdate() override;
@@ -31,11 +42,34 @@ public:
     void QuitPause();
     float GetRemainingTime() const;
     bool IsPaused() const;
+    MatchReplay *GetReplay();
+    RollbackSession *GetRollback();
+
+    /// @brief Sauvegarde l'tat complet du match (scne et StageManager).
+    void SaveState(SceneSnapshot &snapshot);
+
+    /// @brief Restaure un tat sauvegard avec SaveState().
+    /// En mode SIMULATION, l'tat du niveau et le temps restant,
+    /// qui avancent  chaque frame, sont conservs.
+    /// @return false si le snapshot est invalide.
+    bool LoadState(
+        SceneSnapshot &snapshot,
+        SceneSnapshot::RestoreMode mode = SceneSnapshot::RestoreMode::FULL);
+
+    /// @brief Demande une sauvegarde rapide, effectue  la fin de la mise  jour.
+    void RequestSaveState();
+    /// @brief Demande le retour  la sauvegarde rapide.
+    void RequestLoadState();
+    const SceneSnapshot &GetQuickSave() const;
+    float GetQuickSaveTimeMS() const;
+    float GetQuickLoadTimeMS() const;
 
     static StageManager *GetFromScene(Scene *scene);
 
 private:
+    void InitPresentation();
     void InitStarFields();
+    void InitStateHash();
 
     void AddPotion();
     void AddBomb();
@@ -52,6 +86,17 @@ private:
     float m_delayBomb;
     float m_delayPotion;
 
+    MatchReplay *m_replay;
+    RollbackSession *m_rollback;
+
+    SceneSnapshot m_quickSave;
+    bool m_saveStateRequested;
+    bool m_loadStateRequested;
+    float m_quickSaveTimeMS;
+    float m_quickLoadTimeMS;
+
+    void ProcessStateRequests();
+
 };
 
 inline float StageManager::GetRemainingTime() const
@@ -63,3 +108,38 @@ inline bool StageManager::IsPaused() const
 {
     return m_paused;
 }
+
+inline MatchReplay *StageManager::GetReplay()
+{
+    return m_replay;
+}
+
+inline RollbackSession *StageManager::GetRollback()
+{
+    return m_rollback;
+}
+
+inline void StageManager::RequestSaveState()
+{
+    m_saveStateRequested = true;
+}
+
+inline void StageManager::RequestLoadState()
+{
+    m_loadStateRequested = true;
+}
+
+inline const SceneSnapshot &StageManager::GetQuickSave() const
+{
+    return m_quickSave;
+}
+
+inline float StageManager::GetQuickSaveTimeMS() const
+{
+    return m_quickSaveTimeMS;
+}
+
+inline float StageManager::GetQuickLoadTimeMS() const
+{
+    return m_quickLoadTimeMS;
+}
@@ -6,6 +6,7 @@
 
 #include "scene_manager/title_manager.h"
 #include "input/application_input.h"
+#include "common/loading_screen.h"
 
 #include "imgui/imgui_manager.h"
 #include "imgui/imgui_components.h"
@@ -21,9 +22,11 @@ TitleManager::TitleManager(InputManager *inputManager)
     animManager->SetAnimIDToString(assets::AnimIDToString);
 
     AssetManager *assets = scene->GetAssetManager();
-    assets::InitAssets(assets);
+    LoadingScreen loadingScreen(scene->GetRenderer());
+    assets::InitAssets(assets, loadingScreen.GetCallback());
     assets::InitTextures(assets);
     assets::InitFonts(assets);
+    game::UpdateFontSize(scene);
     assets::InitMusic(assets);
     assets::InitSFX(assets);
     assets::InitSpriteAnimations(scene);
@@ -12,6 +12,8 @@ UIStageHUD::UIStageHUD(Scene* scene)
     , m_damageTexts()
     , m_lifeText()
     , m_timeText(nullptr)
+    , m_lifeValues()
+    , m_timeValue(-1)
 {
     SetName("Stage HUD");
     SetFadeChildren(false);
@@ -21,12 +23,13 @@ UIStageHUD::UIStageHUD(Scene* scene)
     SpriteGroup* spriteGroup = nullptr;
     TTF_Font* font = nullptr;
 
-    int playerCount = g_gameCommon.playerCount;
+    GameCommon &gameCommon = GameCommon::GetFromScene(scene);
+    int playerCount = gameCommon.playerCount;
 
     //--------------------------------------------------------------------------
     // Grid layout
     UIGridLayout* hLayout;
-    switch (g_gameCommon.stageConfig.mode)
+    switch (gameCommon.stageConfig.mode)
     {
     default:
     case StageConfig::Mode::LIMITED_LIVES:
@@ -69,7 +72,7 @@ UIStageHUD::UIStageHUD(Scene* scene)
     AssertNew(spriteGroup);
 
     UIImage* fillImage;
-    switch (g_gameCommon.stageConfig.mode)
+    switch (gameCommon.stageConfig.mode)
     {
     default:
     case StageConfig::Mode::LIMITED_LIVES:
@@ -88,16 +91,16 @@ UIStageHUD::UIStageHUD(Scene* scene)
         for (int i = 0; i < playerCount; i++)
         {
             // Compteur des dgats
-            font = assets->GetFont(FONT_DAMAGE);
-            UIText* text = new UIText(scene, "0%", font, Colors::White);
-            text->SetAnchor(Anchor::CENTER);
+            UINumberText* damageText = new UINumberText(scene, FONT_DAMAGE, Colors::White);
+            damageText->SetSuffix("%");
+            damageText->SetAnchor(Anchor::CENTER);
 
-            hLayout->AddObject(text, 0, i * 2);
-            m_damageTexts.push_back(text);
+            hLayout->AddObject(damageText, 0, i * 2);
+            m_damageTexts.push_back(damageText);
 
             // Vie restante
             font = assets->GetFont(FONT_DAMAGE);
-            text = new UIText(scene, "Vie : 0", font, Colors::White);
+            UIText* text = new UIText(scene, "Vie : 0", font, Colors::White);
             text->SetAnchor(Anchor::CENTER);
 
             hLayout->AddObject(text, 0, i*2 +1);
@@ -121,16 +124,16 @@ UIStageHUD::UIStageHUD(Scene* scene)
         for (int i = 0; i < playerCount; i++)
         {
             // Compteur des dgats
-            font = assets->GetFont(FONT_DAMAGE);
-            UIText* text = new UIText(scene, "0%", font, Colors::White);
-            text->SetAnchor(Anchor::CENTER);
+            UINumberText* damageText = new UINumberText(scene, FONT_DAMAGE, Colors::White);
+            damageText->SetSuffix("%");
+            damageText->SetAnchor(Anchor::CENTER);
 
-            hLayout->AddObject(text, 0, i * 2);
-            m_damageTexts.push_back(text);
+            hLayout->AddObject(damageText, 0, i * 2);
+            m_damageTexts.push_back(damageText);
 
             // Score
             font = assets->GetFont(FONT_DAMAGE);
-            text = new UIText(scene, "Score : 0", font, Colors::White);
+            UIText* text = new UIText(scene, "Score : 0", font, Colors::White);
             text->SetAnchor(Anchor::CENTER);
 
             hLayout->AddObject(text, 0, i * 2 + 1);
@@ -152,19 +155,22 @@ void UIStageHUD::Update()
     UIObject::Update();
 
     StageManager* stageManager = StageManager::GetFromScene(m_scene);
-    const int playerCount = g_gameCommon.playerCount;
+    GameCommon &gameCommon = GameCommon::GetFromScene(m_scene);
+    const int playerCount = gameCommon.playerCount;
+    m_lifeValues.resize(playerCount, -1);
 
-    switch (g_gameCommon.stageConfig.mode)
+    switch (gameCommon.stageConfig.mode)
     {
     default:
     case StageConfig::Mode::LIMITED_LIVES:
         
         // Vie restante
         for (int i = 0; i < playerCount; i++) {
-            const PlayerStats* player = g_gameCommon.GetPlayerStats(i);
-            const int life = static_cast<int>(g_gameCommon.stageConfig.lifeCount - player->fallCount);
+            const PlayerStats* player = gameCommon.GetPlayerStats(i);
+            const int life = static_cast<int>(gameCommon.stageConfig.lifeCount - player->fallCount);
+            if (life == m_lifeValues[i]) continue;
 
-            char buffer[128] = { 0 };
+            m_lifeValues[i] = life;
             m_lifeText[i]->SetString("Vie : " + std::to_string(life));
         }
         break;
@@ -174,27 +180,34 @@ void UIStageHUD::Update()
 
         // Score
         for (int i = 0; i < playerCount; i++) {
-            const PlayerStats* player = g_gameCommon.GetPlayerStats(playerCount - i -1);
+            const PlayerStats* player = gameCommon.GetPlayerStats(playerCount - i -1);
             const int score = static_cast<int>(player->fallCount);
+            if (score == m_lifeValues[i]) continue;
 
-            char buffer[128] = { 0 };
+            m_lifeValues[i] = score;
             m_lifeText[i]->SetString("Score : " + std::to_string(score));
         }
         
         // Temps restant
-        int minutes = (int)stageManager->GetRemainingTime() / 60;
-        int seconds = (int)stageManager->GetRemainingTime() % 60;
-        char buffer[128] = { 0 };
+        const int remainingTime = (int)stageManager->GetRemainingTime();
+        if (remainingTime != m_timeValue)
+        {
+            m_timeValue = remainingTime;
+            int minutes = remainingTime / 60;
+            int seconds = remainingTime % 60;
+            char buffer[128] = { 0 };
 
-        sprintf_s(buffer, "%d:%02d", minutes, seconds);
-        m_timeText->SetString(buffer);
+            sprintf_s(buffer, "%d:%02d", minutes, seconds);
+            m_timeText->SetString(buffer);
+        }
             break;
     }
 
+    // Les compteurs de dgats ne sont reformats que si la valeur change
     for (int i = 0; i < playerCount; i++)
     {
         
-        const int score = static_cast<int>(g_gameCommon.playerStats[i].ejectionScore);
-        m_damageTexts[i]->SetString(std::to_string(score) + "%");
+        const int score = static_cast<int>(gameCommon.playerStats[i].ejectionScore);
+        m_damageTexts[i]->SetValue(score);
     }
 }
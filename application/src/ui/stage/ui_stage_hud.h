@@ -17,7 +17,11 @@ public:
     virtual void Update() override;
 
 private:
-    std::vector<UIText *>m_damageTexts;
+    std::vector<UINumberText *>m_damageTexts;
     std::vector<UIText *>m_lifeText;
     UIText *m_timeText;
+
+    /// @brief Valeurs affichées, les textes ne sont modifiés que si elles changent.
+    std::vector<int> m_lifeValues;
+    int m_timeValue;
 };
\ No newline at end of file
@@ -35,6 +35,6 @@ void UITitleBackground::Render()
     {
         SDL_Texture *texture = assets->GetTexture(textureID);
         assert(texture);
-        SDL_RenderTexture(g_renderer, texture, NULL, NULL);
+        SDL_RenderTexture(m_scene->GetRenderer(), texture, NULL, NULL);
     }
 }
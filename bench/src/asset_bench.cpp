@@ -0,0 +1,152 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "rendering/sprite_sheet.h"
+#include "scene/asset_manager.h"
+#include "utils/simd_math.h"
+
+#include <filesystem>
+
+namespace
+{
+    constexpr int ITERATION_COUNT = 20;
+    constexpr size_t RETRIVE_SIZE = (size_t)64 << 20;
+
+    void PrintThroughput(const bench::Result &result, size_t size)
+    {
+        bench::Print(result);
+        std::cout << "    " << std::fixed << std::setprecision(2)
+            << (double)size / (result.minUS * 1e3) << " GB/s" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+}
+
+void bench::BenchSpriteSheetParse()
+{
+    const std::filesystem::path atlasPath = std::filesystem::path(GetOptions().assetsPath) / "atlas";
+    std::error_code error;
+    if (std::filesystem::is_directory(atlasPath, error) == false)
+    {
+        std::cout << "ERROR - Atlas directory not found " << atlasPath.string()
+            << " (use --assets <dir>)" << std::endl;
+        return;
+    }
+
+    std::vector<std::string> paths;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(atlasPath, error))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".json")
+        {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    // Sans moteur de rendu, seule la géométrie est chargée
+    // (fichier binaire s'il a été produit par asset_packer, sinon JSON)
+    const std::string count = " (" + std::to_string(paths.size()) + " files)";
+    Print(Run("SpriteSheet load" + count, ITERATION_COUNT, [&]()
+    {
+        int rectCount = 0;
+        for (const std::string &path : paths)
+        {
+            SpriteSheet spriteSheet(nullptr, path);
+            rectCount += spriteSheet.GetSourceRectCount();
+        }
+        DoNotOptimize((float)rectCount);
+    }));
+
+    // Comparaison en mémoire, sans lecture de fichier
+    std::vector<std::string> texts;
+    std::vector<std::vector<Uint8>> binaries(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        size_t size = 0;
+        void *text = SDL_LoadFile(paths[i].c_str(), &size);
+        texts.emplace_back(text ? (const char *)text : "", text ? size : 0);
+        SDL_free(text);
+        SpriteSheet::ConvertJSON(texts[i].data(), texts[i].size(), binaries[i]);
+    }
+
+    Print(Run("SpriteSheet JSON convert" + count, ITERATION_COUNT, [&]()
+    {
+        size_t binarySize = 0;
+        std::vector<Uint8> binary;
+        for (const std::string &text : texts)
+        {
+            SpriteSheet::ConvertJSON(text.data(), text.size(), binary);
+            binarySize += binary.size();
+        }
+        DoNotOptimize((float)binarySize);
+    }));
+
+    Print(Run("SpriteSheet binary load" + count, ITERATION_COUNT, [&]()
+    {
+        int groupCount = 0;
+        for (const std::vector<Uint8> &binary : binaries)
+        {
+            if (binary.empty()) continue;
+            SpriteSheet spriteSheet(binary.data(), binary.size());
+            groupCount += spriteSheet.GetGroupCount();
+        }
+        DoNotOptimize((float)groupCount);
+    }));
+}
+
+void bench::BenchRetriveMem()
+{
+    std::cout << "Asset de-obfuscation (" << (RETRIVE_SIZE >> 20) << " MB, "
+        << simd::GetInstructionSetName() << ")" << std::endl;
+
+    std::vector<Uint8> original(RETRIVE_SIZE);
+    Uint32 state = 0x12345678;
+    for (Uint8 &byte : original)
+    {
+        state = state * 1664525 + 1013904223;
+        byte = (Uint8)(state >> 24);
+    }
+    std::vector<Uint8> encoded = original;
+    AssetManager::ObfuscateMem(encoded.data(), encoded.size());
+
+    // Le décodage se fait sur place : les itérations suivantes décodent
+    // des octets déjà décodés, ce qui ne change pas le coût
+    std::vector<Uint8> buffer = encoded;
+    PrintThroughput(Run("RetriveMem (scalar)", ITERATION_COUNT, [&]()
+    {
+        simd::RetriveBytesScalar(buffer.data(), buffer.size(), 0x73);
+        DoNotOptimize((float)buffer.back());
+    }), RETRIVE_SIZE);
+
+    buffer = encoded;
+    PrintThroughput(Run("RetriveMem (SIMD)", ITERATION_COUNT, [&]()
+    {
+        simd::RetriveBytes(buffer.data(), buffer.size(), 0x73);
+        DoNotOptimize((float)buffer.back());
+    }), RETRIVE_SIZE);
+
+    buffer = encoded;
+    PrintThroughput(Run("RetriveMem (SIMD + threads)", ITERATION_COUNT, [&]()
+    {
+        AssetManager::RetriveMem(buffer.data(), buffer.size());
+        DoNotOptimize((float)buffer.back());
+    }), RETRIVE_SIZE);
+
+    // Vérification par rapport à la version scalaire
+    std::vector<Uint8> reference = encoded;
+    simd::RetriveBytesScalar(reference.data(), reference.size(), 0x73);
+    buffer = encoded;
+    simd::RetriveBytes(buffer.data(), buffer.size(), 0x73);
+    const bool simdMatch = Check("RetriveMem (SIMD) matches scalar", buffer == reference);
+    buffer = encoded;
+    AssetManager::RetriveMem(buffer.data(), buffer.size());
+    const bool parallelMatch = Check("RetriveMem (SIMD + threads) matches scalar", buffer == reference);
+    Check("RetriveMem (scalar) restores the data", reference == original);
+
+    std::cout << "match: scalar " << (reference == original ? "OK" : "FAILED")
+        << " | SIMD " << (simdMatch ? "OK" : "FAILED")
+        << " | threads " << (parallelMatch ? "OK" : "FAILED") << std::endl;
+}
@@ -0,0 +1,61 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "utils/simd_math.h"
+
+namespace
+{
+    constexpr int ITERATION_COUNT = 200;
+
+    // 8 voix de 1024 trames stéréo, soit un tampon audio typique par voix
+    constexpr int VOICE_COUNT = 8;
+    constexpr size_t SAMPLE_COUNT = 2 * 1024;
+}
+
+void bench::BenchStereoGain()
+{
+    std::cout << "Stereo gain (" << VOICE_COUNT << " voices x " << SAMPLE_COUNT << " samples, "
+        << simd::GetInstructionSetName() << ")" << std::endl;
+
+    std::vector<float> samples(VOICE_COUNT * SAMPLE_COUNT);
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = sinf(0.01f * (float)i);
+    }
+    std::vector<float> reference = samples;
+
+    // Les gains sont proches de 1 pour que les échantillons ne s'annulent pas
+    Result scalarResult = Run("gain (scalar)", ITERATION_COUNT, [&]()
+    {
+        for (int v = 0; v < VOICE_COUNT; v++)
+        {
+            simd::ApplyStereoGainScalar(&reference[v * SAMPLE_COUNT], SAMPLE_COUNT, 0.999f, 1.001f);
+        }
+        DoNotOptimize(reference.back());
+    });
+    Print(scalarResult);
+
+    Result simdResult = Run("gain (SIMD)", ITERATION_COUNT, [&]()
+    {
+        for (int v = 0; v < VOICE_COUNT; v++)
+        {
+            simd::ApplyStereoGain(&samples[v * SAMPLE_COUNT], SAMPLE_COUNT, 0.999f, 1.001f);
+        }
+        DoNotOptimize(samples.back());
+    });
+    Print(simdResult);
+
+    // Les deux versions ont subi le même nombre d'itérations
+    float maxError = 0.f;
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        maxError = std::max(maxError, fabsf(samples[i] - reference[i]));
+    }
+    std::cout << "max error: " << maxError << std::endl;
+    std::cout << "speedup: " << std::setprecision(2)
+        << scalarResult.meanUS / simdResult.meanUS << "x" << std::endl;
+}
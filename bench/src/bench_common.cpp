@@ -0,0 +1,239 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "cJSON.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    volatile float g_sink = 0.f;
+
+    bench::Options g_options;
+    std::vector<bench::Result> g_results;
+    int g_failedCheckCount = 0;
+
+    SDL_Window *g_benchWindow = nullptr;
+    SDL_Renderer *g_benchRenderer = nullptr;
+}
+
+bench::Options &bench::GetOptions()
+{
+    return g_options;
+}
+
+bool bench::ShouldRun(const std::string &name)
+{
+    return g_options.filter.empty() || name.find(g_options.filter) != std::string::npos;
+}
+
+bench::Result bench::Run(const std::string &name, int iterationCount, const std::function<void()> &func)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Echauffement (caches, allocations)
+    func();
+
+    Result result;
+    result.name = name;
+    result.iterationCount = iterationCount;
+    result.minUS = 1e30;
+
+    double totalUS = 0.0;
+    for (int i = 0; i < iterationCount; i++)
+    {
+        const auto start = Clock::now();
+        func();
+        const auto end = Clock::now();
+
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        result.minUS = std::min(result.minUS, us);
+        totalUS += us;
+    }
+    result.meanUS = iterationCount > 0 ? totalUS / iterationCount : 0.0;
+    return result;
+}
+
+void bench::Print(const Result &result)
+{
+    std::cout << std::left << std::setw(40) << result.name
+        << std::right << std::fixed << std::setprecision(2)
+        << " mean " << std::setw(10) << result.meanUS << " us"
+        << " | min " << std::setw(10) << result.minUS << " us"
+        << " | " << result.iterationCount << " iterations" << std::endl;
+
+    g_results.push_back(result);
+}
+
+const std::vector<bench::Result> &bench::GetResults()
+{
+    return g_results;
+}
+
+bool bench::Check(const std::string &name, bool success)
+{
+    if (success == false)
+    {
+        std::cout << "ERROR - Check failed: " << name << std::endl;
+        g_failedCheckCount++;
+    }
+    return success;
+}
+
+bool bench::HasFailedChecks()
+{
+    return g_failedCheckCount > 0;
+}
+
+bool bench::SaveJSON(const std::string &path, const std::vector<Result> &results)
+{
+    cJSON *jRoot = cJSON_CreateObject();
+    cJSON *jResults = cJSON_AddArrayToObject(jRoot, "results");
+    for (const Result &result : results)
+    {
+        cJSON *jResult = cJSON_CreateObject();
+        cJSON_AddStringToObject(jResult, "name", result.name.c_str());
+        cJSON_AddNumberToObject(jResult, "iterations", result.iterationCount);
+        cJSON_AddNumberToObject(jResult, "mean_us", result.meanUS);
+        cJSON_AddNumberToObject(jResult, "min_us", result.minUS);
+        cJSON_AddItemToArray(jResults, jResult);
+    }
+
+    char *text = cJSON_Print(jRoot);
+    cJSON_Delete(jRoot);
+
+    std::ofstream file(path);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't write the benchmark results " << path << std::endl;
+        cJSON_free(text);
+        return false;
+    }
+    file << text << "\n";
+    cJSON_free(text);
+    return true;
+}
+
+bool bench::LoadJSON(const std::string &path, std::vector<Result> &results)
+{
+    std::ifstream file(path);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't read the benchmark results " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    cJSON *jRoot = cJSON_ParseWithLength(text.c_str(), text.size());
+    cJSON *jResults = cJSON_GetObjectItem(jRoot, "results");
+    if (cJSON_IsArray(jResults) == false)
+    {
+        std::cout << "ERROR - Invalid benchmark results " << path << std::endl;
+        cJSON_Delete(jRoot);
+        return false;
+    }
+
+    results.clear();
+    cJSON *jResult = nullptr;
+    cJSON_ArrayForEach(jResult, jResults)
+    {
+        cJSON *jName = cJSON_GetObjectItem(jResult, "name");
+        if (cJSON_IsString(jName) == false) continue;
+
+        Result result;
+        result.name = jName->valuestring;
+        result.iterationCount = (int)cJSON_GetNumberValue(cJSON_GetObjectItem(jResult, "iterations"));
+        result.meanUS = cJSON_GetNumberValue(cJSON_GetObjectItem(jResult, "mean_us"));
+        result.minUS = cJSON_GetNumberValue(cJSON_GetObjectItem(jResult, "min_us"));
+        results.push_back(result);
+    }
+    cJSON_Delete(jRoot);
+    return true;
+}
+
+bool bench::Compare(const std::vector<Result> &baseline, const std::vector<Result> &results, double thresholdPercent)
+{
+    std::map<std::string, const Result *> baselineMap;
+    for (const Result &result : baseline)
+    {
+        baselineMap[result.name] = &result;
+    }
+
+    std::cout << "Comparison (threshold " << thresholdPercent << " %)" << std::endl;
+    int regressionCount = 0;
+    for (const Result &result : results)
+    {
+        auto it = baselineMap.find(result.name);
+        if (it == baselineMap.end())
+        {
+            std::cout << "  " << std::left << std::setw(40) << result.name << " new" << std::endl;
+            continue;
+        }
+
+        const Result &reference = *(it->second);
+        const double change = reference.minUS > 0.0 ?
+            100.0 * (result.minUS - reference.minUS) / reference.minUS : 0.0;
+        const bool regression = change > thresholdPercent;
+        if (regression) regressionCount++;
+
+        std::cout << "  " << std::left << std::setw(40) << result.name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << reference.minUS << " us -> "
+            << std::setw(10) << result.minUS << " us ("
+            << std::showpos << std::setprecision(1) << change << std::noshowpos << " %)"
+            << (regression ? " REGRESSION" : "") << std::endl;
+    }
+    std::cout << regressionCount << " regression(s)" << std::endl;
+    return regressionCount == 0;
+}
+
+bool bench::InitHeadless(int width, int height)
+{
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::cout << "ERROR - SDL_Init " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    g_benchWindow = SDL_CreateWindow("engine_bench", width, height, SDL_WINDOW_HIDDEN);
+    if (g_benchWindow == nullptr)
+    {
+        std::cout << "ERROR - Create window " << SDL_GetError() << std::endl;
+        return false;
+    }
+    g_benchRenderer = SDL_CreateRenderer(g_benchWindow, SDL_SOFTWARE_RENDERER);
+    if (g_benchRenderer == nullptr)
+    {
+        std::cout << "ERROR - Create renderer " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetRenderDrawBlendMode(g_benchRenderer, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void bench::QuitHeadless()
+{
+    if (g_benchRenderer) SDL_DestroyRenderer(g_benchRenderer);
+    if (g_benchWindow) SDL_DestroyWindow(g_benchWindow);
+    g_benchRenderer = nullptr;
+    g_benchWindow = nullptr;
+    SDL_Quit();
+}
+
+SDL_Renderer *bench::GetRenderer()
+{
+    return g_benchRenderer;
+}
+
+void bench::DoNotOptimize(float value)
+{
+    g_sink = g_sink + value;
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <chrono>
+#include <functional>
+
+namespace bench
+{
+    /// @brief Résultat d'une mesure.
+    struct Result
+    {
+        std::string name;
+        int iterationCount = 0;
+        double meanUS = 0.0;
+        double minUS = 0.0;
+    };
+
+    /// @brief Options de la ligne de commande.
+    struct Options
+    {
+        /// @brief Seuls les groupes de mesures dont le nom contient ce texte sont exécutés.
+        std::string filter;
+        std::string assetsPath = "../../assets/";
+    };
+    Options &GetOptions();
+
+    /// @brief Indique si un groupe de mesures doit être exécuté (voir Options::filter).
+    bool ShouldRun(const std::string &name);
+
+    /// @brief Exécute une fonction plusieurs fois et mesure son temps d'exécution.
+    /// @param name le nom de la mesure.
+    /// @param iterationCount le nombre d'exécutions mesurées.
+    /// @param func la fonction à mesurer.
+    /// @return Le résultat de la mesure.
+    Result Run(const std::string &name, int iterationCount, const std::function<void()> &func);
+
+    /// @brief Affiche un résultat sur la sortie standard et l'ajoute
+    /// aux résultats de l'exécution.
+    void Print(const Result &result);
+
+    /// @brief Renvoie les résultats affichés avec Print().
+    const std::vector<Result> &GetResults();
+
+    /// @brief Vérifie le résultat d'un calcul mesuré (par exemple une version
+    /// SIMD comparée à la version scalaire). Un échec est affiché et fait
+    /// échouer l'exécution du programme.
+    /// @return `success`.
+    bool Check(const std::string &name, bool success);
+
+    /// @brief Indique si une vérification a échoué (voir Check()).
+    bool HasFailedChecks();
+
+    /// @brief Écrit des résultats dans un fichier JSON.
+    bool SaveJSON(const std::string &path, const std::vector<Result> &results);
+    bool LoadJSON(const std::string &path, std::vector<Result> &results);
+
+    /// @brief Compare des résultats à une référence.
+    /// Une mesure est une régression si son temps minimal dépasse celui de la
+    /// référence de plus de `thresholdPercent` pourcents. Le temps minimal est
+    /// moins sensible que la moyenne aux interruptions du système.
+    /// @return false si au moins une régression est détectée.
+    bool Compare(const std::vector<Result> &baseline, const std::vector<Result> &results, double thresholdPercent);
+
+    /// @brief Initialise la SDL sans affichage (pilote vidéo "offscreen")
+    /// avec le moteur de rendu logiciel.
+    bool InitHeadless(int width, int height);
+    void QuitHeadless();
+    SDL_Renderer *GetRenderer();
+
+    /// @brief Empêche le compilateur de supprimer un calcul dont le résultat
+    /// n'est pas utilisé.
+    void DoNotOptimize(float value);
+
+    void BenchTransformInterpolation();
+    void BenchViewsAndGroups();
+    void BenchRenderSprites();
+    void BenchParticles();
+    void BenchRayCasts();
+    void BenchCommandBuffer();
+    void BenchUIObjects();
+    void BenchSpriteSheetParse();
+    void BenchRetriveMem();
+    void BenchStereoGain();
+}
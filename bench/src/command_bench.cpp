@@ -0,0 +1,41 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "ecs/command_buffer.h"
+#include "ecs/basic_components.h"
+
+namespace
+{
+    constexpr int ITERATION_COUNT = 100;
+}
+
+void bench::BenchCommandBuffer()
+{
+    for (int entityCount : { 1000, 10000, 50000 })
+    {
+        entt::registry registry;
+        EntityCommandBuffer ecb;
+
+        // Chaque itération détruit les entités de l'itération précédente et en
+        // crée autant avec deux composants, soit trois commandes par entité
+        const std::string name = "EntityCommandBuffer::Flush (" + std::to_string(3 * entityCount) + ")";
+        Print(Run(name, ITERATION_COUNT, [&]()
+        {
+            for (entt::entity entity : registry.view<Transform>())
+            {
+                ecb.DestroyEntity(entity);
+            }
+            for (int i = 0; i < entityCount; i++)
+            {
+                VirtualEntityID id = ecb.CreateEntity();
+                ecb.AddComponent<Transform>(id, Transform(b2Vec2{ (float)i, 0.f }));
+                ecb.AddComponent<RenderSortingLayer>(id, RenderSortingLayer(i % 4, i));
+            }
+            ecb.Flush(registry);
+        }));
+    }
+}
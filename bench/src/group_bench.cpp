@@ -0,0 +1,111 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "ecs/basic_components.h"
+#include "rendering/sprite_anim.h"
+#include "utils/utils.h"
+
+namespace
+{
+    constexpr int ITERATION_COUNT = 200;
+
+    /// @brief Remplit un registre avec un mélange d'entités proche de celui d'un niveau :
+    /// seule une partie des entités possède la combinaison parcourue et les
+    /// composants sont ajoutés dans un ordre différent de celui des entités,
+    /// comme après de nombreuses créations/destructions.
+    void PopulateRegistry(entt::registry &registry, int entityCount)
+    {
+        std::vector<entt::entity> entities(entityCount);
+        for (int i = 0; i < entityCount; i++)
+        {
+            entities[i] = registry.create();
+            registry.emplace<Transform>(entities[i], b2Vec2{ (float)i, 0.f });
+        }
+
+        for (int k = 0; k < entityCount; k++)
+        {
+            // Décors, interface, objets attachés...
+            const int i = (int)(((int64_t)k * 7919) % entityCount);
+            if (i % 4 == 1) continue;
+
+            b2Transform xf = { b2Vec2{ (float)i, 1.f }, b2Rot_identity };
+            registry.emplace<FixedUpdateTransform>(entities[i], xf);
+        }
+
+        for (int k = 0; k < entityCount; k++)
+        {
+            const int i = (int)(((int64_t)k * 104729) % entityCount);
+            if (i % 3 == 0) registry.emplace<Sprite>(entities[i]);
+        }
+        for (int k = 0; k < entityCount; k++)
+        {
+            if (k % 2 == 0) registry.emplace<SpriteAnimState>(entities[k], (AnimID)0);
+        }
+    }
+
+    template <typename Query>
+    void Interpolate(Query &&query, float alpha)
+    {
+        for (auto [entity, transform, fixed] : query.each())
+        {
+            transform.position = math::Lerp(fixed.prevXf.p, fixed.currXf.p, alpha);
+        }
+    }
+
+    template <typename Query>
+    void Animate(Query &&query)
+    {
+        for (auto [entity, sprite, state] : query.each())
+        {
+            state.frameIdx++;
+            sprite.srcRect.x = (float)state.frameIdx;
+        }
+    }
+
+    void BenchEntityCount(int entityCount)
+    {
+        std::cout << "Views vs groups (" << entityCount << " entities)" << std::endl;
+
+        entt::registry viewRegistry;
+        PopulateRegistry(viewRegistry, entityCount);
+
+        // Les groupes sont créés avant les entités, comme au démarrage d'une scène
+        entt::registry groupRegistry;
+        groupRegistry.group<Transform, FixedUpdateTransform>();
+        groupRegistry.group<Sprite, SpriteAnimState>();
+        PopulateRegistry(groupRegistry, entityCount);
+
+        float alpha = 0.f;
+        bench::Print(bench::Run("view  Transform+FixedUpdateTransform", ITERATION_COUNT, [&]()
+        {
+            alpha = fmodf(alpha + 0.37f, 1.f);
+            Interpolate(viewRegistry.view<Transform, FixedUpdateTransform>(), alpha);
+        }));
+        bench::Print(bench::Run("group Transform+FixedUpdateTransform", ITERATION_COUNT, [&]()
+        {
+            alpha = fmodf(alpha + 0.37f, 1.f);
+            Interpolate(groupRegistry.group<Transform, FixedUpdateTransform>(), alpha);
+        }));
+        bench::Print(bench::Run("view  Sprite+SpriteAnimState", ITERATION_COUNT, [&]()
+        {
+            Animate(viewRegistry.view<Sprite, SpriteAnimState>());
+        }));
+        bench::Print(bench::Run("group Sprite+SpriteAnimState", ITERATION_COUNT, [&]()
+        {
+            Animate(groupRegistry.group<Sprite, SpriteAnimState>());
+        }));
+    }
+}
+
+void bench::BenchViewsAndGroups()
+{
+    // Niveau classique puis cas de charge
+    for (int entityCount : { 200, 10000, 100000 })
+    {
+        BenchEntityCount(entityCount);
+    }
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+
+int main(int argc, char *argv[])
+{
+    // Options de la ligne de commande
+    //   --filter <text>   : n'exécute que les groupes dont le nom contient le texte
+    //   --json <file>     : écrit les résultats dans un fichier JSON
+    //   --compare <file>  : compare les résultats à une référence écrite avec --json
+    //   --threshold <pct> : écart toléré avant de signaler une régression (10 % par défaut)
+    //   --assets <dir>    : dossier des assets (../../assets/ par défaut)
+    std::string jsonPath;
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+    bench::Options &options = bench::GetOptions();
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--compare" && i + 1 < argc) baselinePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) thresholdPercent = atof(argv[++i]);
+        else if (arg == "--assets" && i + 1 < argc) options.assetsPath = std::string(argv[++i]) + "/";
+        else std::cout << "ERROR - Unknown argument " << arg << std::endl;
+    }
+
+    if (bench::InitHeadless(1280, 720) == false)
+    {
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<std::pair<std::string, std::function<void()>>> groups = {
+        { "transform", bench::BenchTransformInterpolation },
+        { "group", bench::BenchViewsAndGroups },
+        { "sprites", bench::BenchRenderSprites },
+        { "particles", bench::BenchParticles },
+        { "raycast", bench::BenchRayCasts },
+        { "commands", bench::BenchCommandBuffer },
+        { "ui", bench::BenchUIObjects },
+        { "spritesheet", bench::BenchSpriteSheetParse },
+        { "retrive", bench::BenchRetriveMem },
+        { "mixer", bench::BenchStereoGain },
+    };
+    for (const auto &[name, func] : groups)
+    {
+        if (bench::ShouldRun(name)) func();
+    }
+
+    bench::QuitHeadless();
+
+    // Une vérification échouée est une erreur, même sans comparaison
+    bool success = (bench::HasFailedChecks() == false);
+
+    if (jsonPath.empty() == false)
+    {
+        bench::SaveJSON(jsonPath, bench::GetResults());
+    }
+    if (baselinePath.empty() == false)
+    {
+        std::vector<bench::Result> baseline;
+        if (bench::LoadJSON(baselinePath, baseline) == false)
+        {
+            return EXIT_FAILURE;
+        }
+        if (bench::Compare(baseline, bench::GetResults(), thresholdPercent) == false)
+        {
+            success = false;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,196 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "scene/scene.h"
+#include "ui/visual/ui_fill_rect.h"
+
+namespace
+{
+    constexpr int ITERATION_COUNT = 100;
+
+    /// @brief Crée une scène sans son ni lecture des événements,
+    /// qui dessine avec le moteur de rendu logiciel du benchmark.
+    std::unique_ptr<Scene> CreateScene(InputManager &inputManager)
+    {
+        SceneContext context = SceneContext::Headless();
+        context.renderer = bench::GetRenderer();
+        context.seed = 1;
+        return std::make_unique<Scene>(nullptr, &inputManager, context);
+    }
+
+    std::string MakeName(const std::string &name, int count)
+    {
+        return name + " (" + std::to_string(count) + ")";
+    }
+}
+
+void bench::BenchRenderSprites()
+{
+    SDL_Renderer *renderer = GetRenderer();
+    SDL_Texture *texture = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 32, 32);
+    assert(texture);
+
+    for (int spriteCount : { 1000, 10000 })
+    {
+        InputManager inputManager(false);
+        std::unique_ptr<Scene> scene = CreateScene(inputManager);
+        entt::registry &registry = scene->GetRegistry();
+
+        const entt::entity camera = registry.create();
+        registry.emplace<Camera>(camera);
+        registry.emplace<Transform>(camera, b2Vec2_zero);
+
+        // Sprites répartis dans la vue, sur plusieurs couches
+        RandomStream random(1);
+        for (int i = 0; i < spriteCount; i++)
+        {
+            const entt::entity entity = registry.create();
+            registry.emplace<Transform>(entity, b2Vec2{
+                random.RangeF(-15.f, 15.f), random.RangeF(-8.f, 8.f) });
+            registry.emplace<RenderSortingLayer>(entity, random.RangeI(0, 4), i);
+
+            Sprite &sprite = registry.emplace<Sprite>(entity);
+            sprite.texture = texture;
+            sprite.srcRect = { 0.f, 0.f, 32.f, 32.f };
+        }
+
+        RenderGameSystem system(scene.get());
+        EntityCommandBuffer ecb;
+        Print(Run(MakeName("RenderGameSystem sprites", spriteCount), ITERATION_COUNT, [&]()
+        {
+            SDL_RenderClear(renderer);
+            system.OnUpdate(ecb);
+        }));
+    }
+
+    SDL_DestroyTexture(texture);
+}
+
+void bench::BenchParticles()
+{
+    for (int particleCount : { 1000, 10000, 100000 })
+    {
+        InputManager inputManager(false);
+        std::unique_ptr<Scene> scene = CreateScene(inputManager);
+        ParticleSystem *particleSystem = scene->GetParticleSystem();
+
+        RandomStream random(1);
+        for (int i = 0; i < particleCount; i++)
+        {
+            Particle particle(0);
+            particle.SetLifetime(1e6f);
+            particle.position = { random.RangeF(-15.f, 15.f), random.RangeF(-8.f, 8.f) };
+            particle.velocity = { random.RangeF(-1.f, 1.f), random.RangeF(0.f, 2.f) };
+            particle.gravity = { 0.f, -1.f };
+            particle.damping = { 0.5f, 0.5f };
+            particle.angularVelocity = random.RangeF(-90.f, 90.f);
+            particleSystem->EmitParticle(i % 4, particle);
+        }
+
+        // Écart de temps d'une frame à 60 FPS
+        scene->GetTime().Update(1.f / 60.f);
+
+        Print(Run(MakeName("ParticleSystem update", particleCount), ITERATION_COUNT, [&]()
+        {
+            particleSystem->Update();
+        }));
+    }
+}
+
+void bench::BenchRayCasts()
+{
+    constexpr int BOX_COUNT = 400;
+
+    InputManager inputManager(false);
+    std::unique_ptr<Scene> scene = CreateScene(inputManager);
+    b2WorldId worldId = scene->GetWorld();
+
+    // Grille de boîtes statiques comparable aux plateformes d'un niveau
+    std::vector<BodyUserData> userData(BOX_COUNT, BodyUserData(entt::entity(entt::null)));
+    for (int i = 0; i < BOX_COUNT; i++)
+    {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.position = { (float)(i % 20) - 10.f, (float)(i / 20) - 10.f };
+        bodyDef.userData = &userData[i];
+        b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        b2Polygon box = b2MakeBox(0.25f, 0.25f);
+        b2CreatePolygonShape(bodyId, &shapeDef, &box);
+    }
+
+    for (int rayCount : { 100, 1000, 10000 })
+    {
+        RandomStream random(1);
+        std::vector<b2Vec2> points(2 * rayCount);
+        for (b2Vec2 &point : points)
+        {
+            point = { random.RangeF(-12.f, 12.f), random.RangeF(-12.f, 12.f) };
+        }
+
+        const QueryFilter filter;
+        Print(Run(MakeName("Scene::RayCastFirst", rayCount), ITERATION_COUNT, [&]()
+        {
+            float fraction = 0.f;
+            for (int i = 0; i < rayCount; i++)
+            {
+                RayHit hit = scene->RayCastFirst(points[2 * i], points[2 * i + 1], filter);
+                fraction += hit.fraction;
+            }
+            DoNotOptimize(fraction);
+        }));
+    }
+}
+
+void bench::BenchUIObjects()
+{
+    for (int objectCount : { 100, 1000, 5000 })
+    {
+        InputManager inputManager(false);
+        std::unique_ptr<Scene> scene = CreateScene(inputManager);
+        UIObjectManager *uiManager = scene->GetUIObjectManager();
+
+        // Hiérarchie de profondeur 3, comme les menus et le HUD
+        UIObject *root = nullptr;
+        UIObject *group = nullptr;
+        for (int i = 0; i < objectCount; i++)
+        {
+            UIFillRect *rect = new UIFillRect(scene.get(), Color(255, 255, 255, 32));
+            rect->SetLocalRect(UIRect(
+                b2Vec2{ 0.1f, 0.1f }, b2Vec2{ 0.9f, 0.9f },
+                b2Vec2{ 1.f, 1.f }, b2Vec2{ -1.f, -1.f }
+            ));
+            if (i % 100 == 0)
+            {
+                root = rect;
+            }
+            else if (i % 10 == 0)
+            {
+                rect->SetParent(root);
+                group = rect;
+            }
+            else
+            {
+                rect->SetParent(group);
+            }
+        }
+        uiManager->ProcessObjects();
+
+        RenderUISystem system(scene.get());
+        EntityCommandBuffer ecb;
+        Print(Run(MakeName("UIObjectManager update+render", objectCount), ITERATION_COUNT, [&]()
+        {
+            uiManager->ProcessObjects();
+            for (auto it = uiManager->begin(); it != uiManager->end(); ++it)
+            {
+                (*it)->Update();
+            }
+            system.OnUpdate(ecb);
+        }));
+    }
+}
@@ -0,0 +1,107 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "bench_common.h"
+#include "utils/utils.h"
+#include "utils/simd_math.h"
+
+namespace
+{
+    constexpr int ENTITY_COUNT = 10000;
+    constexpr int ITERATION_COUNT = 1000;
+
+    struct LegacyTransform
+    {
+        b2Vec2 position;
+        float angle;
+    };
+
+    b2Transform MakeTransform(int i, float offset)
+    {
+        const float angle = 0.001f * (float)(i % 6283) - 3.14159f + offset;
+        b2Transform xf = { 0 };
+        xf.p = { (float)(i % 100) + offset, (float)(i / 100) - offset };
+        xf.q = b2MakeRot(angle);
+        return xf;
+    }
+}
+
+void bench::BenchTransformInterpolation()
+{
+    std::vector<b2Transform> prevXf(ENTITY_COUNT);
+    std::vector<b2Transform> currXf(ENTITY_COUNT);
+    for (int i = 0; i < ENTITY_COUNT; i++)
+    {
+        prevXf[i] = MakeTransform(i, 0.f);
+        currXf[i] = MakeTransform(i, 0.1f);
+    }
+
+    std::cout << "Transform interpolation (" << ENTITY_COUNT << " entities, "
+        << simd::GetInstructionSetName() << ")" << std::endl;
+
+    // Ancienne version : Lerp + LerpAngle avec deux atan2 par entité
+    std::vector<LegacyTransform> legacy(ENTITY_COUNT);
+    float alpha = 0.f;
+    Result legacyResult = Run("legacy Lerp/LerpAngle", ITERATION_COUNT, [&]()
+    {
+        alpha = fmodf(alpha + 0.37f, 1.f);
+        for (int i = 0; i < ENTITY_COUNT; i++)
+        {
+            legacy[i].position = math::Lerp(prevXf[i].p, currXf[i].p, alpha);
+            legacy[i].angle = math::LerpAngle(
+                b2Rot_GetAngle(prevXf[i].q), b2Rot_GetAngle(currXf[i].q), alpha
+            );
+        }
+        DoNotOptimize(legacy[ENTITY_COUNT - 1].angle);
+    });
+    Print(legacyResult);
+
+    // Nouvelle version : tableaux compacts
+    simd::TransformArrays arrays;
+    arrays.Resize(ENTITY_COUNT);
+    for (int i = 0; i < ENTITY_COUNT; i++)
+    {
+        arrays.Set(i, prevXf[i], currXf[i]);
+    }
+
+    alpha = 0.f;
+    Result scalarResult = Run("packed nlerp (scalar)", ITERATION_COUNT, [&]()
+    {
+        alpha = fmodf(alpha + 0.37f, 1.f);
+        simd::InterpolateTransformsScalar(arrays, ENTITY_COUNT, alpha);
+        DoNotOptimize(arrays.outAngle[ENTITY_COUNT - 1]);
+    });
+    Print(scalarResult);
+
+    alpha = 0.f;
+    Result simdResult = Run("packed nlerp (SIMD)", ITERATION_COUNT, [&]()
+    {
+        alpha = fmodf(alpha + 0.37f, 1.f);
+        simd::InterpolateTransforms(arrays, ENTITY_COUNT, alpha);
+        DoNotOptimize(arrays.outAngle[ENTITY_COUNT - 1]);
+    });
+    Print(simdResult);
+
+    // Ecart maximal avec l'ancienne version
+    alpha = 0.5f;
+    simd::InterpolateTransforms(arrays, ENTITY_COUNT, alpha);
+    float maxPosError = 0.f;
+    float maxAngleError = 0.f;
+    for (int i = 0; i < ENTITY_COUNT; i++)
+    {
+        b2Vec2 position = math::Lerp(prevXf[i].p, currXf[i].p, alpha);
+        float angle = math::LerpAngle(
+            b2Rot_GetAngle(prevXf[i].q), b2Rot_GetAngle(currXf[i].q), alpha
+        );
+        b2Vec2 delta = { arrays.outX[i] - position.x, arrays.outY[i] - position.y };
+        maxPosError = std::max(maxPosError, b2Length(delta));
+        maxAngleError = std::max(maxAngleError, fabsf(b2UnwindAngle(arrays.outAngle[i] - angle)));
+    }
+    std::cout << "max error: position " << maxPosError
+        << " | angle " << maxAngleError << " rad" << std::endl;
+    std::cout << "speedup: " << std::setprecision(2)
+        << legacyResult.meanUS / simdResult.meanUS << "x" << std::endl;
+}
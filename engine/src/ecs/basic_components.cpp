@@ -26,6 +26,23 @@ void Transform::Set(b2Transform xf)
     angle = b2Rot_GetAngle(xf.q);
 }
 
+bool Transform::Set(b2Vec2 p, float a, Uint64 id)
+{
+    // Tolérance pour ignorer les erreurs d'arrondi de l'interpolation
+    const float epsilon = 1e-5f;
+    if (fabsf(p.x - position.x) <= epsilon &&
+        fabsf(p.y - position.y) <= epsilon &&
+        fabsf(a - angle) <= epsilon)
+    {
+        return false;
+    }
+
+    position = p;
+    angle = a;
+    updateID = id;
+    return true;
+}
+
 void FixedUpdateTransform::Set(b2Vec2 position, float angle)
 {
     currXf = { position, b2MakeRot(angle * B2_PI  / 180.f) };
@@ -68,6 +85,30 @@ void Sprite::Reset()
     offset = b2Vec2_zero;
 }
 
+bool Sprite::SetFrame(SDL_Texture *textureIn, const SDL_FRect &srcRectIn, Uint64 id)
+{
+    if (texture == textureIn &&
+        srcRect.x == srcRectIn.x && srcRect.y == srcRectIn.y &&
+        srcRect.w == srcRectIn.w && srcRect.h == srcRectIn.h)
+    {
+        return false;
+    }
+
+    texture = textureIn;
+    srcRect = srcRectIn;
+    updateID = id;
+    return true;
+}
+
+bool Sprite::SetFlip(SDL_FlipMode flipIn, Uint64 id)
+{
+    if (flip == flipIn) return false;
+
+    flip = flipIn;
+    updateID = id;
+    return true;
+}
+
 void Sprite::SetSprite(SpriteGroup *spriteGroup, int spriteIdx, float pixelsPerUnit)
 {
     const float epsilon = 1e-2f;
@@ -22,14 +22,23 @@ struct Transform
     Transform(b2Vec2 position = b2Vec2_zero, float angle = 0.f)
         : position(position)
         , angle(angle)
+        , updateID(0)
     {}
-    Transform(b2Transform xf) { Set(xf); }
+    Transform(b2Transform xf) : updateID(0) { Set(xf); }
 
     b2Vec2 position;
     float angle;
 
+    /// @brief Numéro de la dernière mise à jour de la scène (Scene::GetUpdateID())
+    /// ayant déplacé l'entité. Il est maintenu par le TransformSystem.
+    Uint64 updateID;
+
     void Set(b2Vec2 position, float angle);
     void Set(b2Transform xf);
+
+    /// @brief Modifie la transformation et met à jour updateID si elle a changé.
+    /// @return true si la transformation a changé.
+    bool Set(b2Vec2 position, float angle, Uint64 updateID);
 };
 
 struct FixedUpdateTransform
@@ -128,6 +137,7 @@ struct Sprite
         , offset(b2Vec2_zero)
         , flip(SDL_FLIP_NONE)
         , flipOffset(true)
+        , updateID(0)
     {}
 
     SDL_Texture *texture;
@@ -138,8 +148,21 @@ struct Sprite
     bool flipOffset;
     b2Vec2 offset;
 
+    /// @brief Numéro de la dernière mise à jour de la scène (Scene::GetUpdateID())
+    /// ayant modifié l'image affichée (texture, rectangle source ou retournement).
+    /// Les caches peuvent ainsi ne traiter que les sprites modifiés.
+    Uint64 updateID;
+
     void Reset();
     void SetSprite(SpriteGroup *spriteGroup, int spriteIdx, float pixelsPerUnit = 24.f);
+
+    /// @brief Modifie l'image affichée et met à jour updateID si elle a changé.
+    /// @return true si l'image a changé.
+    bool SetFrame(SDL_Texture *texture, const SDL_FRect &srcRect, Uint64 updateID);
+
+    /// @brief Modifie le retournement et met à jour updateID s'il a changé.
+    /// @return true si le retournement a changé.
+    bool SetFlip(SDL_FlipMode flip, Uint64 updateID);
 };
 
 struct TiledSprite
@@ -32,11 +32,19 @@ void RenderGameSystem::OnUpdate(EntityCommandBuffer &ecb)
 
     auto cameraView = m_registry.view<Camera, Transform>();
 
+    // Pools des composants optionnels, rcuprs une seule fois par frame
+    auto &sprites = m_registry.storage<Sprite>();
+    auto &blendMods = m_registry.storage<RenderBlendMod>();
+    auto &colorMods = m_registry.storage<RenderColorMod>();
+    auto &tiledSprites = m_registry.storage<TiledSprite>();
+    auto &tilemaps = m_registry.storage<TilemapRenderer>();
+    auto &backgroundLayers = m_registry.storage<BackgroundLayer>();
+
     for (auto [cameraEntity, camera, cameraTransform] : cameraView.each())
     {
         if (camera.isActive == false) continue;
 
-        camera.UpdateViewport(g_renderer);
+        camera.UpdateViewport(m_scene->GetRenderer());
 
         int prevLayer = 0;
         for (auto [entity, renderLayer, transform] : renderableView.each())
@@ -49,24 +57,24 @@ void RenderGameSystem::OnUpdate(EntityCommandBuffer &ecb)
                 prevLayer = renderLayer.layer;
             }
 
-            if (m_registry.all_of<Sprite>(entity))
+            if (sprites.contains(entity))
             {
-                auto &sprite = m_registry.get<Sprite>(entity);
-                if (m_registry.all_of<RenderBlendMod>(entity))
+                auto &sprite = sprites.get(entity);
+                if (blendMods.contains(entity))
                 {
-                    auto &blendMode = m_registry.get<RenderBlendMod>(entity);
+                    auto &blendMode = blendMods.get(entity);
                     SDL_SetTextureBlendMode(sprite.texture, blendMode.blendMode);
                     SDL_SetTextureAlphaModFloat(sprite.texture, blendMode.alpha);
                 }
-                if (m_registry.all_of<RenderColorMod>(entity))
+                if (colorMods.contains(entity))
                 {
-                    auto &colorMod = m_registry.get<RenderColorMod>(entity);
+                    auto &colorMod = colorMods.get(entity);
                     SDL_SetTextureColorModFloat(sprite.texture, colorMod.r, colorMod.g, colorMod.b);
                 }
 
-                if (m_registry.all_of<TiledSprite>(entity))
+                if (tiledSprites.contains(entity))
                 {
-                    auto &tiledSprite = m_registry.get<TiledSprite>(entity);
+                    auto &tiledSprite = tiledSprites.get(entity);
                     RenderSprite(
                         camera, cameraTransform, sprite, transform,
                         1.f, tiledSprite.tiledCountX, tiledSprite.tiledCountY
@@ -78,17 +86,17 @@ void RenderGameSystem::OnUpdate(EntityCommandBuffer &ecb)
                 }
             }
 
-            if (m_registry.all_of<TilemapRenderer>(entity))
+            if (tilemaps.contains(entity))
             {
-                auto &tilemap = m_registry.get<TilemapRenderer>(entity);
+                auto &tilemap = tilemaps.get(entity);
                 for (Sprite &sprite : tilemap.tiles)
                 {
                     RenderSprite(camera, cameraTransform, sprite, transform, tilemap.scale);
                 }
             }
-            if (m_registry.all_of<BackgroundLayer>(entity))
+            if (backgroundLayers.contains(entity))
             {
-                auto &layer = m_registry.get<BackgroundLayer>(entity);
+                auto &layer = backgroundLayers.get(entity);
                 RenderLayer(camera, cameraTransform, layer, transform);
             }
         }
@@ -177,7 +185,7 @@ void RenderGameSystem::RenderSprite(
 
             SDL_FPoint sdlCenter{ 0.f, 0.f };
             SDL_RenderTextureRotated(
-                g_renderer, sprite.texture, srcRect, &dstRect,
+                m_scene->GetRenderer(), sprite.texture, srcRect, &dstRect,
                 -spriteTransform.angle * RAD_TO_DEG, &sdlCenter, sprite.flip
             );
         }
@@ -227,7 +235,7 @@ void RenderGameSystem::RenderLayer(
             FillLayerBelow(layer.texture, dstRect);
             break;
         }
-        RenderTexture(g_renderer, layer.texture, NULL, &dstRect, Anchor::WEST);
+        RenderTexture(m_scene->GetRenderer(), layer.texture, NULL, &dstRect, Anchor::WEST);
     }
 }
 
@@ -244,14 +252,14 @@ inline void RenderGameSystem::FillLayerAbove(SDL_Texture *layer, SDL_FRect dstRe
 
     if (dstRect.h > 0.f)
     {
-        SDL_RenderTexture(g_renderer, layer, &srcRect, &dstRect);
+        SDL_RenderTexture(m_scene->GetRenderer(), layer, &srcRect, &dstRect);
     }
 }
 
 inline void RenderGameSystem::FillLayerBelow(SDL_Texture *layer, SDL_FRect dstRect)
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(m_scene->GetRenderer(), &viewport);
 
     SDL_FRect srcRect = { 0 };
     srcRect.x = 0;
@@ -264,7 +272,32 @@ inline void RenderGameSystem::FillLayerBelow(SDL_Texture *layer, SDL_FRect dstRe
 
     if (dstRect.h > 0.f)
     {
-        SDL_RenderTexture(g_renderer, layer, &srcRect, &dstRect);
+        SDL_RenderTexture(m_scene->GetRenderer(), layer, &srcRect, &dstRect);
+    }
+}
+
+template <typename Query>
+void TransformSystem::Interpolate(Query &query, float alpha)
+{
+    const Uint64 updateID = m_scene->GetUpdateID();
+
+    // Copie les transformations dans des tableaux compacts
+    size_t count = 0;
+    m_arrays.Resize(m_registry.storage<FixedUpdateTransform>().size());
+    for (auto [entity, transform, fixed] : query.each())
+    {
+        m_arrays.Set(count++, fixed.prevXf, fixed.currXf);
+    }
+
+    // Interpolation par paquets (SIMD)
+    simd::InterpolateTransforms(m_arrays, count, alpha);
+
+    // Le second parcours visite les entits dans le mme ordre
+    size_t i = 0;
+    for (auto [entity, transform, fixed] : query.each())
+    {
+        transform.Set(b2Vec2{ m_arrays.outX[i], m_arrays.outY[i] }, m_arrays.outAngle[i], updateID);
+        i++;
     }
 }
 
@@ -272,14 +305,17 @@ void TransformSystem::OnUpdate(EntityCommandBuffer &ecb)
 {
     const float alpha = m_scene->GetAlpha();
 
-    auto view = m_registry.view<Transform, FixedUpdateTransform>(
-        entt::exclude<LocalTransform>);
-    for (auto [entity, transform, fixed] : view.each())
+    if (m_scene->HasGroup<Transform, FixedUpdateTransform>(entt::get<>, entt::exclude<LocalTransform>))
     {
-        transform.position = math::Lerp(fixed.prevXf.p, fixed.currXf.p, alpha);
-        transform.angle = math::LerpAngle(
-            b2Rot_GetAngle(fixed.prevXf.q), b2Rot_GetAngle(fixed.currXf.q), alpha
-        );
+        auto group = m_registry.group<Transform, FixedUpdateTransform>(
+            entt::get<>, entt::exclude<LocalTransform>);
+        Interpolate(group, alpha);
+    }
+    else
+    {
+        auto view = m_registry.view<Transform, FixedUpdateTransform>(
+            entt::exclude<LocalTransform>);
+        Interpolate(view, alpha);
     }
 
     auto viewLocal = m_registry.view<LocalTransform, Transform>();
@@ -288,22 +324,38 @@ void TransformSystem::OnUpdate(EntityCommandBuffer &ecb)
         if (m_registry.valid(local.parent) && m_registry.all_of<Transform>(local.parent))
         {
             Transform &parentTransform = m_registry.get<Transform>(local.parent);
-            transform.position = parentTransform.position + local.position;
-            transform.angle = fmodf(parentTransform.angle + local.angle, (float)TAU);
+            transform.Set(
+                parentTransform.position + local.position,
+                fmodf(parentTransform.angle + local.angle, (float)TAU),
+                m_scene->GetUpdateID()
+            );
         }
     }
 }
 
 void TransformSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
 {
-    auto view = m_registry.view<Rigidbody, FixedUpdateTransform>();
+    auto view = m_registry.view<const Rigidbody, FixedUpdateTransform>();
     for (auto [entity, rigidBody, fixedTransform] : view.each())
     {
-        b2BodyId bodyId = rigidBody.bodyId;
-        if (b2Body_IsValid(bodyId) == false) continue;
-
         fixedTransform.prevXf = fixedTransform.currXf;
-        fixedTransform.currXf = b2Body_GetTransform(bodyId);
+    }
+
+    // Lecture groupe des corps qui ont boug pendant le dernier pas
+    // Les autres corps conservent leur transformation courante
+    b2BodyEvents bodyEvents = b2World_GetBodyEvents(m_scene->GetWorld());
+    for (int i = 0; i < bodyEvents.moveCount; i++)
+    {
+        const b2BodyMoveEvent &moveEvent = bodyEvents.moveEvents[i];
+        if (b2Body_IsValid(moveEvent.bodyId) == false) continue;
+
+        const BodyUserData *userData = static_cast<BodyUserData *>(moveEvent.userData);
+        if (userData == nullptr) continue;
+
+        FixedUpdateTransform *fixedTransform = m_registry.try_get<FixedUpdateTransform>(userData->entity);
+        if (fixedTransform == nullptr) continue;
+
+        fixedTransform->currXf = moveEvent.transform;
     }
 }
 
@@ -330,20 +382,29 @@ void WorldBoundsSystem::OnFixedUpdate(EntityCommandBuffer &ecb)
 void AnimatorSystem::OnUpdate(EntityCommandBuffer &ecb)
 {
     const float delta = m_scene->GetDelta();
+    const Uint64 updateID = m_scene->GetUpdateID();
 
     SpriteAnimManager *animManager = m_scene->GetAnimManager();
-    auto view = m_registry.view<Sprite, SpriteAnimState>();
-    for (auto [entity, sprite, state] : view.each())
+    auto updateAnim = [&](Sprite &sprite, SpriteAnimState &state)
     {
         SpriteAnim *spriteAnim = animManager->GetSpriteAnim(state);
-        if (spriteAnim == nullptr) continue;
+        if (spriteAnim == nullptr) return;
         SpriteGroup *spriteGroup = spriteAnim->GetSpriteGroup();
-        if (spriteGroup == nullptr) continue;
+        if (spriteGroup == nullptr) return;
 
         spriteAnim->Update(state, delta);
 
-        sprite.texture = spriteGroup->GetTexture();
-        sprite.srcRect = *(spriteGroup->GetSourceRect(state.frameIdx));
+        // Le sprite n'est modifi que si l'image affiche change
+        sprite.SetFrame(spriteGroup->GetTexture(), *(spriteGroup->GetSourceRect(state.frameIdx)), updateID);
+    };
+
+    if (m_scene->HasGroup<Sprite, SpriteAnimState>())
+    {
+        m_registry.group<Sprite, SpriteAnimState>().each(updateAnim);
+    }
+    else
+    {
+        m_registry.view<Sprite, SpriteAnimState>().each(updateAnim);
     }
 }
 
@@ -354,18 +415,8 @@ void RenderQuerySystem::OnUpdate(EntityCommandBuffer &ecb)
     {
         if (camera.isActive == false) continue;
 
-        auto &queryGizmos = m_scene->GetQueryGizmos();
-        for (auto &gizmos : queryGizmos)
-        {
-            SDL_SetRenderDrawColor(
-                g_renderer,
-                gizmos->m_color.r,
-                gizmos->m_color.g,
-                gizmos->m_color.b,
-                gizmos->m_color.a
-            );
-            gizmos->m_shape.Render(g_renderer, camera, cameraTransform);
-        }
+        m_scene->GetQueryGizmos().Render(m_lineBatch, camera, cameraTransform);
+        m_lineBatch.Render(m_scene->GetRenderer());
     }
 }
 
@@ -375,15 +426,21 @@ bool RenderPhysicsSystem::DrawQueryCallback(b2ShapeId shapeId, void *context)
     b2BodyId bodyId = b2Shape_GetBody(shapeId);
     b2Transform xf = b2Body_GetTransform(bodyId);
 
-    GizmosShape gizmos(shapeId, xf);
-    gizmos.Render(g_renderer, ctx->camera, ctx->cameraTransform);
+    const Color color(128, 255, 255);
+    ctx->shape.Set(shapeId, xf);
+    ctx->shape.Render(ctx->lineBatch, color, ctx->camera, ctx->cameraTransform);
 
+    // Croix sur la position du corps, en une ligne brise qui repasse par le centre
     const b2Vec2 position = b2Body_GetPosition(bodyId);
     const float x = ctx->camera.WorldToViewX(ctx->cameraTransform.position.x, position.x);
     const float y = ctx->camera.WorldToViewY(ctx->cameraTransform.position.y, position.y);
     const float w = 3.f;
-    SDL_RenderLine(g_renderer, x - w, y - w, x + w, y + w);
-    SDL_RenderLine(g_renderer, x + w, y - w, x - w, y + w);
+    SDL_FPoint *points = ctx->lineBatch.AddPolyline(color, 5);
+    points[0] = { x - w, y - w };
+    points[1] = { x + w, y + w };
+    points[2] = { x, y };
+    points[3] = { x + w, y - w };
+    points[4] = { x - w, y + w };
 
     // On continue la recherche
     return true;
@@ -396,15 +453,15 @@ void RenderPhysicsSystem::OnUpdate(EntityCommandBuffer &ecb)
     {
         if (camera.isActive == false) continue;
 
-        SDL_SetRenderDrawColor(g_renderer, 128, 255, 255, 255);
-
         b2AABB worldView = camera.GetWorldView(cameraTransform.position);
 
-        CallbackContext context{ m_registry, camera, cameraTransform };
+        CallbackContext context{ m_registry, camera, cameraTransform, m_lineBatch, m_shape };
         b2QueryFilter filter = b2DefaultQueryFilter();
         filter.categoryBits = (uint64_t)(-1);
         filter.maskBits = (uint64_t)(-1);
         b2World_OverlapAABB(m_scene->GetWorld(), worldView, filter, DrawQueryCallback, &context);
+
+        m_lineBatch.Render(m_scene->GetRenderer());
     }
 }
 
@@ -415,33 +472,38 @@ void RenderGridSystem::OnUpdate(EntityCommandBuffer &ecb)
     {
         if (camera.isActive == false) continue;
 
+        // Axes, lignes toutes les 10 units et autres lignes
+        const std::array<Color, 3> colors = {
+            Color(255, 255, 255, 255), Color(0, 255, 255, 255), Color(0, 255, 255, 63)
+        };
+        auto getColorIndex = [](int i) { return (i == 0) ? 0 : ((i % 10) == 0) ? 1 : 2; };
+
         b2AABB worldView = camera.GetWorldView(cameraTransform.position);
-        for (int i = (int)worldView.lowerBound.y; i < worldView.upperBound.y; i++)
-        {
-            if (i == 0)
-                SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
-            else if ((i % 10) == 0)
-                SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 255);
-            else
-                SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 63);
-
-            float x, y;
-            camera.WorldToView(cameraTransform.position, b2Vec2(0.f, (float)i), x, y);
-            SDL_RenderLine(g_renderer, 0.f, y, camera.viewport.w, y);
-        }
-        for (int i = (int)worldView.lowerBound.x; i < worldView.upperBound.x; i++)
+        const int yFirst = (int)worldView.lowerBound.y;
+        const int xFirst = (int)worldView.lowerBound.x;
+
+        // Les axes sont dessins par-dessus les autres lignes
+        for (int c = (int)colors.size() - 1; c >= 0; c--)
         {
-            if (i == 0)
-                SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
-            else if ((i % 10) == 0)
-                SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 255);
-            else
-                SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 63);
-
-            float x, y;
-            camera.WorldToView(cameraTransform.position, b2Vec2((float)i, 0.f), x, y);
-            SDL_RenderLine(g_renderer, x, 0.f, x, camera.viewport.h);
+            for (int i = yFirst; i < worldView.upperBound.y; i++)
+            {
+                if (getColorIndex(i) != c) continue;
+
+                float x, y;
+                camera.WorldToView(cameraTransform.position, b2Vec2(0.f, (float)i), x, y);
+                m_lineBatch.AddLine(colors[c], 0.f, y, camera.viewport.w, y);
+            }
+            for (int i = xFirst; i < worldView.upperBound.x; i++)
+            {
+                if (getColorIndex(i) != c) continue;
+
+                float x, y;
+                camera.WorldToView(cameraTransform.position, b2Vec2((float)i, 0.f), x, y);
+                m_lineBatch.AddLine(colors[c], x, 0.f, x, camera.viewport.h);
+            }
         }
+
+        m_lineBatch.Render(m_scene->GetRenderer());
     }
 }
 
@@ -484,7 +546,7 @@ void RenderImGuiSystem::OnUpdate(EntityCommandBuffer &ecb)
         ImGui_ImplSDL3_NewFrame();
         m_manager->Render();
         ImGui::Render();
-        ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), g_renderer);
+        ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), m_scene->GetRenderer());
     }
 }
 
@@ -11,6 +11,9 @@
 #include "ecs/command_buffer.h"
 #include "ecs/basic_components.h"
 #include "imgui/imgui_manager_base.h"
+#include "utils/simd_math.h"
+#include "utils/gizmos_shape.h"
+#include "rendering/line_batch.h"
 
 class Scene;
 
@@ -67,6 +70,13 @@ public:
     TransformSystem(Scene *scene) : System(scene, "Transform system") {}
     virtual void OnUpdate(EntityCommandBuffer &ecb) override;
     virtual void OnFixedUpdate(EntityCommandBuffer &ecb) override;
+
+private:
+    /// @brief Tableaux compacts réutilisés d'une frame à l'autre pour l'interpolation.
+    simd::TransformArrays m_arrays;
+
+    template <typename Query>
+    void Interpolate(Query &query, float alpha);
 };
 
 class WorldBoundsSystem : public System
@@ -99,7 +109,12 @@ public:
         enabled = false;
     }
 
+    /// @brief Dessine les formes enregistrées par la scène.
+    /// L'enregistrement est activé séparément avec Scene::SetQueryGizmosEnabled().
     virtual void OnUpdate(EntityCommandBuffer &ecb) override;
+
+private:
+    LineBatch m_lineBatch;
 };
 
 class RenderPhysicsSystem : public System
@@ -117,9 +132,15 @@ public:
         entt::registry &registry;
         Camera &camera;
         Transform &cameraTransform;
+        LineBatch &lineBatch;
+        GizmosShape &shape;
     };
 
     static bool DrawQueryCallback(b2ShapeId shapeId, void *context);
+
+private:
+    LineBatch m_lineBatch;
+    GizmosShape m_shape;
 };
 
 class RenderGridSystem : public System
@@ -130,7 +151,11 @@ public:
         enabled = false;
     }
 
+    /// @brief Dessine la grille en un seul appel de rendu (voir LineBatch).
     virtual void OnUpdate(EntityCommandBuffer &ecb) override;
+
+private:
+    LineBatch m_lineBatch;
 };
 
 class ImGuiManagerBase;
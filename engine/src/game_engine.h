@@ -11,6 +11,8 @@
 
 #include "utils/timer.h"
 #include "utils/utils.h"
+#include "utils/random.h"
+#include "utils/thread_pool.h"
 #include "utils/color.h"
 #include "utils/gizmos_shape.h"
 
@@ -19,6 +21,9 @@
 #include "rendering/easing_fct.h"
 #include "rendering/anim.h"
 #include "rendering/sprite_anim.h"
+#include "rendering/frame_pacer.h"
+#include "rendering/glyph_atlas.h"
+#include "rendering/line_batch.h"
 
 #include "input/input_manager.h"
 #include "input/input_group.h"
@@ -29,9 +34,19 @@
 #include "ecs/basic_systems.h"
 
 #include "scene/asset_manager.h"
+#include "scene/asset_pack.h"
+#include "scene/asset_cache.h"
+#include "scene/asset_stream.h"
+#include "scene/sound_mixer.h"
+#include "scene/scene_context.h"
 #include "scene/scene.h"
 #include "scene/scene_manager.h"
 #include "scene/particle_system.h"
+#include "scene/scene_snapshot.h"
+#include "scene/state_hash.h"
+#include "scene/system_profiler.h"
+
+#include "net/transport.h"
 
 #include "imgui/imgui_component_base.h"
 #include "imgui/imgui_basic_components.h"
@@ -50,3 +65,4 @@
 #include "ui/visual/ui_fill_rect.h"
 #include "ui/visual/ui_image.h"
 #include "ui/visual/ui_text.h"
+#include "ui/visual/ui_number_text.h"
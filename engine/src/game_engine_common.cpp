@@ -5,6 +5,8 @@
 */
 
 #include "game_engine_common.h"
+#include "rendering/frame_pacer.h"
+#include "scene/asset_cache.h"
 //#include "utils/asset_manager.h"
 
 #ifndef AssertNew
@@ -15,6 +17,8 @@ Timer *g_time = nullptr;
 SDL_Renderer *g_renderer = NULL;
 SDL_Window *g_window = NULL;
 TTF_TextEngine *g_textEngine = NULL;
+FramePacer *g_framePacer = nullptr;
+AssetCache *g_assetCache = nullptr;
 
 static int g_rendererW = 0;
 static int g_rendererH = 0;
@@ -134,10 +138,11 @@ SDL_AppResult game::CreateRenderer(int width, int height)
     success = SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
     assert(success);
 
-    if (!SDL_SetRenderVSync(g_renderer, 1))
-    {
-        std::cout << "ERROR - Render VSync " << SDL_GetError() << std::endl;
-    }
+    // Synchronisation verticale par défaut
+    g_framePacer = new FramePacer(g_renderer);
+
+    // Les assets sont conservés d'une scène à l'autre
+    g_assetCache = new AssetCache(g_renderer);
 
     // Setup Platform/Renderer backends
     ImGui_ImplSDL3_InitForSDLRenderer(g_window, g_renderer);
@@ -160,6 +165,8 @@ void game::DestroyRenderer()
     if (!g_renderer) return;
     assert(g_textEngine);
 
+    delete g_assetCache; g_assetCache = nullptr;
+    delete g_framePacer; g_framePacer = nullptr;
     TTF_DestroyRendererTextEngine(g_textEngine);
     g_textEngine = NULL;
     SDL_DestroyRenderer(g_renderer);
@@ -11,6 +11,8 @@
 
 #define MIX_CHANNEL_COUNT 16
 class AssetManager;
+class AssetCache;
+class FramePacer;
 
 /// @brief Temps global du jeu.
 extern Timer *g_time;
@@ -24,6 +26,12 @@ extern SDL_Renderer *g_renderer;
 /// @brief Moteur de rendu des textes.
 extern TTF_TextEngine *g_textEngine;
 
+/// @brief Cadence d'affichage du jeu (créée avec le moteur de rendu).
+extern FramePacer *g_framePacer;
+
+/// @brief Cache des assets partagé par les scènes (créé avec le moteur de rendu).
+extern AssetCache *g_assetCache;
+
 struct BodyUserData
 {
     BodyUserData(entt::entity e) : entity(e) {}
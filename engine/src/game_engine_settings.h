@@ -13,6 +13,7 @@
 #include <list>
 #include <set>
 #include <map>
+#include <functional>
 
 #include <iostream>
 #include <iomanip>
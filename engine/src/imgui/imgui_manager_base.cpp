@@ -13,11 +13,11 @@ ImGuiManagerBase::ImGuiManagerBase(Scene *scene)
     : m_scene(scene)
     , m_registry(scene->GetRegistry())
     , m_selectedEntity{ entt::null }
+    , m_selectedUI()
     , m_showImGui(false)
     , m_showEntityInspector(true)
     , m_showEntityFilter(false)
     , m_showSystems(false)
-    , m_selectedUI(nullptr)
     , m_showUIExplorer(false)
 {
 }
@@ -102,13 +102,14 @@ void ImGuiManagerBase::RenderUIExplorer()
 
     ImGui::SameLine();
     ImGui::BeginGroup();
-    if (m_scene->Contains(m_selectedUI))
+    UIObject *selectedUI = GetSelectedUI();
+    if (selectedUI)
     {
-        m_selectedUI->DrawImGui();
+        selectedUI->DrawImGui();
     }
     else
     {
-        m_selectedUI = nullptr;
+        m_selectedUI = UIObjectHandle();
         ImGui::TextUnformatted("No UIObject selected");
     }
     ImGui::EndGroup();
@@ -128,7 +129,7 @@ void ImGuiManagerBase::RenderUIExplorerRec(UIObject *uiOject)
     tree_flags |= ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
     tree_flags |= ImGuiTreeNodeFlags_SpanFullWidth;
 
-    if (uiOject == m_selectedUI)
+    if (uiOject == GetSelectedUI())
     {
         tree_flags |= ImGuiTreeNodeFlags_Selected;
     }
@@ -140,7 +141,7 @@ void ImGuiManagerBase::RenderUIExplorerRec(UIObject *uiOject)
     bool nodeOpen = ImGui::TreeNodeEx(GetUIName(uiOject).c_str(), tree_flags);
     if (ImGui::IsItemFocused())
     {
-        m_selectedUI = uiOject;
+        m_selectedUI = uiOject->GetHandle();
     }
     if (ImGui::IsItemHovered()) uiOject->SetGizmosEnabled(true);
     if (nodeOpen)
@@ -279,19 +280,25 @@ void ImGuiManagerBase::SetSelected(UIObject *uiObject)
 {
     if (m_scene->Contains(uiObject))
     {
-        m_selectedUI = uiObject;
+        m_selectedUI = uiObject->GetHandle();
     }
 }
 
+UIObject *ImGuiManagerBase::GetSelectedUI() const
+{
+    return m_scene->GetUIObjectManager()->Get(m_selectedUI);
+}
+
 void ImGuiManagerBase::Update()
 {
     if (m_registry.valid(m_selectedEntity) == false)
     {
         m_selectedEntity = entt::null;
     }
-    if (m_scene->Contains(m_selectedUI) == false)
+    if (GetSelectedUI() == nullptr)
     {
-        m_selectedUI = dynamic_cast<UIObject *>(m_scene->GetCanvas());
+        UIObject *canvas = dynamic_cast<UIObject *>(m_scene->GetCanvas());
+        m_selectedUI = canvas ? canvas->GetHandle() : UIObjectHandle();
     }
 }
 
@@ -10,6 +10,7 @@
 #include "game_engine_common.h"
 #include "imgui/imgui_component_base.h"
 #include "utils/gizmos_shape.h"
+#include "ui/ui_object_manager.h"
 
 class Scene;
 class UIObject;
@@ -30,10 +31,7 @@ public:
         return m_selectedEntity;
     }
     void SetSelected(UIObject *uiObject);
-    UIObject *GetSelectedUI() const
-    {
-        return m_selectedUI;
-    }
+    UIObject *GetSelectedUI() const;
 
     static std::string GetEntityName(entt::registry &registry, entt::entity entity);
     static std::string GetUIName(UIObject *uiObject);
@@ -55,7 +53,8 @@ protected:
     std::vector<std::pair<std::unique_ptr<ImGuiBaseComponent>, bool>> m_imGuiComponents;
     std::vector<std::pair<std::unique_ptr<ImGuiBaseTag>, bool>> m_imGuiTags;
     entt::entity m_selectedEntity;
-    UIObject *m_selectedUI;
+    /// @brief Objet sélectionné, qui peut être détruit par la scène.
+    UIObjectHandle m_selectedUI;
 
     bool m_showImGui;
     bool m_showEntityFilter;
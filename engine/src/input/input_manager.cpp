@@ -7,13 +7,20 @@
 #include "input/input_manager.h"
 #include "utils/utils.h"
 
-InputManager::InputManager()
+InputManager::InputManager(bool useGamepads)
     : m_inputMap()
     , m_gamepads()
     , m_keyboardIsPlayer(false)
     , m_playerCount(0)
     , m_maxPlayerCount(4)
+    , m_useGamepads(useGamepads)
 {
+    if (m_useGamepads == false)
+    {
+        UpdatePlayerCount();
+        return;
+    }
+
     int gamepadCount = 0;
     SDL_JoystickID *joysticks = SDL_GetGamepads(&gamepadCount);
     if (joysticks)
@@ -118,6 +125,8 @@ void InputManager::ProcessEvents()
 
 void InputManager::AddGameController(SDL_JoystickID joystickID)
 {
+    if (m_useGamepads == false) return;
+
     bool *playerIDs = new bool[m_maxPlayerCount];
     std::fill_n(playerIDs, m_maxPlayerCount, false);
 
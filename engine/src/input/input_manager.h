@@ -12,7 +12,9 @@
 class InputManager
 {
 public:
-    InputManager();
+    /// @param useGamepads false pour ne pas ouvrir ni renuméroter les manettes,
+    /// partagées par tous les threads (matchs sans rendu des workers).
+    explicit InputManager(bool useGamepads = true);
     InputManager(InputManager const&) = delete;
     InputManager& operator=(InputManager const&) = delete;
     ~InputManager();
@@ -43,6 +45,7 @@ protected:
     int m_playerCount;
     bool m_keyboardIsPlayer;
     std::set<SDL_Gamepad *> m_gamepads;
+    bool m_useGamepads;
 };
 
 inline void InputManager::SetKeyboardIsPlayer(bool keyboardIsPlayer)
@@ -0,0 +1,69 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "net/transport.h"
+
+LoopbackLink::LoopbackLink(const LoopbackConfig &config)
+    : m_config(config)
+    , m_generator(config.seed)
+    , m_timeNS(0)
+    , m_sequence(0)
+    , m_sentCount(0)
+    , m_lostCount(0)
+    , m_endpoints{ Endpoint(*this, 0), Endpoint(*this, 1) }
+    , m_queues()
+{
+}
+
+void LoopbackLink::Endpoint::Send(const std::vector<uint8_t> &packet)
+{
+    LoopbackLink &link = m_link;
+    link.m_sentCount++;
+
+    std::uniform_real_distribution<float> lossDist(0.f, 1.f);
+    if (lossDist(link.m_generator) < link.m_config.lossRate)
+    {
+        link.m_lostCount++;
+        return;
+    }
+
+    Uint64 delayMS = link.m_config.latencyMS;
+    if (link.m_config.jitterMS > 0)
+    {
+        std::uniform_int_distribution<Uint64> jitterDist(0, link.m_config.jitterMS);
+        delayMS += jitterDist(link.m_generator);
+    }
+
+    Pending pending;
+    pending.deliveryNS = link.m_timeNS + SDL_MS_TO_NS(delayMS);
+    pending.sequence = link.m_sequence++;
+    pending.data = packet;
+    link.m_queues[1 - m_index].push_back(std::move(pending));
+}
+
+bool LoopbackLink::Endpoint::Receive(std::vector<uint8_t> &packet)
+{
+    std::vector<Pending> &queue = m_link.m_queues[m_index];
+
+    // Premier paquet arrivé (date de livraison puis ordre d'envoi)
+    auto first = queue.end();
+    for (auto it = queue.begin(); it != queue.end(); ++it)
+    {
+        if (it->deliveryNS > m_link.m_timeNS) continue;
+        if (first == queue.end() ||
+            it->deliveryNS < first->deliveryNS ||
+            (it->deliveryNS == first->deliveryNS && it->sequence < first->sequence))
+        {
+            first = it;
+        }
+    }
+    if (first == queue.end()) return false;
+
+    packet = std::move(first->data);
+    if (first != queue.end() - 1) *first = std::move(queue.back());
+    queue.pop_back();
+    return true;
+}
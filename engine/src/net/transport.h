@@ -0,0 +1,132 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <random>
+
+/// @brief Interface d'envoi de paquets non fiables (pertes, retards et
+/// désordre possibles), comme de l'UDP.
+class Transport
+{
+public:
+    virtual ~Transport() = default;
+
+    virtual void Send(const std::vector<uint8_t> &packet) = 0;
+
+    /// @brief Récupère le prochain paquet reçu.
+    /// @param[out] packet le paquet.
+    /// @return false si aucun paquet n'est disponible.
+    virtual bool Receive(std::vector<uint8_t> &packet) = 0;
+};
+
+struct LoopbackConfig
+{
+    LoopbackConfig()
+        : latencyMS(0), jitterMS(0), lossRate(0.f), seed(0)
+    {}
+
+    /// @brief Délai minimal d'acheminement d'un paquet.
+    Uint64 latencyMS;
+
+    /// @brief Délai supplémentaire aléatoire (les paquets peuvent être désordonnés).
+    Uint64 jitterMS;
+
+    /// @brief Probabilité de perte d'un paquet (entre 0 et 1).
+    float lossRate;
+
+    /// @brief Graine du générateur utilisé pour la gigue et les pertes.
+    /// Il est indépendant des générateurs de la scène pour ne pas modifier la simulation.
+    uint32_t seed;
+};
+
+/// @brief Liaison simulée entre deux extrémités d'un même processus.
+/// L'horloge de la liaison avance explicitement avec Advance() pour que
+/// les tests soient reproductibles. Elle compte en nanosecondes pour suivre
+/// exactement le pas fixe de la scène.
+class LoopbackLink
+{
+public:
+    LoopbackLink(const LoopbackConfig &config);
+    LoopbackLink(LoopbackLink const&) = delete;
+    LoopbackLink& operator=(LoopbackLink const&) = delete;
+
+    /// @brief Renvoie l'extrémité 0 ou 1 de la liaison.
+    Transport *GetEndpoint(int index);
+
+    void Advance(Uint64 deltaNS);
+    Uint64 GetTimeMS() const;
+
+    const LoopbackConfig &GetConfig() const;
+    int GetSentCount() const;
+    int GetLostCount() const;
+
+private:
+    struct Pending
+    {
+        Uint64 deliveryNS;
+        uint64_t sequence;
+        std::vector<uint8_t> data;
+    };
+
+    class Endpoint : public Transport
+    {
+    public:
+        Endpoint(LoopbackLink &link, int index) : m_link(link), m_index(index) {}
+
+        virtual void Send(const std::vector<uint8_t> &packet) override;
+        virtual bool Receive(std::vector<uint8_t> &packet) override;
+
+    private:
+        LoopbackLink &m_link;
+        int m_index;
+    };
+
+    LoopbackConfig m_config;
+    std::mt19937 m_generator;
+    Uint64 m_timeNS;
+    uint64_t m_sequence;
+    int m_sentCount;
+    int m_lostCount;
+
+    std::array<Endpoint, 2> m_endpoints;
+
+    /// @brief Paquets en transit vers chaque extrémité.
+    std::array<std::vector<Pending>, 2> m_queues;
+};
+
+inline Transport *LoopbackLink::GetEndpoint(int index)
+{
+    assert(0 <= index && index < 2);
+    return &m_endpoints[index];
+}
+
+inline void LoopbackLink::Advance(Uint64 deltaNS)
+{
+    m_timeNS += deltaNS;
+}
+
+inline Uint64 LoopbackLink::GetTimeMS() const
+{
+    return SDL_NS_TO_MS(m_timeNS);
+}
+
+inline const LoopbackConfig &LoopbackLink::GetConfig() const
+{
+    return m_config;
+}
+
+inline int LoopbackLink::GetSentCount() const
+{
+    return m_sentCount;
+}
+
+inline int LoopbackLink::GetLostCount() const
+{
+    return m_lostCount;
+}
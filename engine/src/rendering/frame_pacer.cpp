@@ -0,0 +1,180 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "rendering/frame_pacer.h"
+
+#define DEFAULT_TARGET_FPS 60.f
+#define DEFAULT_SPIN_TAIL_NS SDL_US_TO_NS(500)
+
+FramePacer::FrameStats::FrameStats()
+    : cpuNS(0), waitNS(0), presentNS(0), frameNS(0)
+{
+}
+
+FramePacer::FramePacer(SDL_Renderer *renderer)
+    : m_renderer(renderer)
+    , m_mode(Mode::VSYNC)
+    , m_targetFPS(DEFAULT_TARGET_FPS)
+    , m_targetNS(0)
+    , m_spinTailNS(DEFAULT_SPIN_TAIL_NS)
+    , m_frameStartNS(0)
+    , m_lastPresentNS(0)
+    , m_deadlineNS(0)
+    , m_history()
+    , m_frameCount(0)
+    , m_log()
+{
+    assert(m_renderer);
+    SetMode(Mode::VSYNC);
+}
+
+FramePacer::~FramePacer()
+{
+    CloseLog();
+}
+
+void FramePacer::SetMode(Mode mode, float targetFPS)
+{
+    if (targetFPS > 0.f) m_targetFPS = targetFPS;
+
+    if (mode == Mode::VSYNC && !SDL_SetRenderVSync(m_renderer, 1))
+    {
+        std::cout << "ERROR - Render VSync " << SDL_GetError() << std::endl;
+        mode = Mode::CAPPED;
+        m_targetFPS = GetDisplayRefreshRate();
+    }
+    if (mode != Mode::VSYNC)
+    {
+        SDL_SetRenderVSync(m_renderer, 0);
+    }
+
+    m_mode = mode;
+    m_targetNS = (Uint64)llround(1e9 / (double)m_targetFPS);
+    m_deadlineNS = SDL_GetTicksNS();
+}
+
+void FramePacer::EndFrame()
+{
+    FrameStats stats;
+    const Uint64 cpuEndNS = SDL_GetTicksNS();
+    stats.cpuNS = cpuEndNS - m_frameStartNS;
+
+    if (m_mode == Mode::CAPPED)
+    {
+        // Une frame en retard ne crée pas de rafale de frames pour rattraper le retard
+        m_deadlineNS = std::max(m_deadlineNS + m_targetNS, cpuEndNS);
+        WaitUntil(m_deadlineNS);
+    }
+    const Uint64 presentStartNS = SDL_GetTicksNS();
+    stats.waitNS = presentStartNS - cpuEndNS;
+
+    SDL_RenderPresent(m_renderer);
+
+    const Uint64 presentEndNS = SDL_GetTicksNS();
+    stats.presentNS = presentEndNS - presentStartNS;
+    stats.frameNS = (m_lastPresentNS > 0) ? presentEndNS - m_lastPresentNS : 0;
+    m_lastPresentNS = presentEndNS;
+
+    m_history[m_frameCount % HISTORY_SIZE] = stats;
+    if (m_log.is_open())
+    {
+        m_log << m_frameCount << ","
+            << (double)stats.cpuNS / 1e6 << ","
+            << (double)stats.waitNS / 1e6 << ","
+            << (double)stats.presentNS / 1e6 << ","
+            << (double)stats.frameNS / 1e6 << "\n";
+    }
+    m_frameCount++;
+}
+
+bool FramePacer::OpenLog(const std::string &path)
+{
+    CloseLog();
+    m_log.open(path);
+    if (m_log.is_open() == false)
+    {
+        std::cout << "ERROR - Can't write the frame log " << path << std::endl;
+        return false;
+    }
+    m_log << "frame,cpu_ms,wait_ms,present_ms,frame_ms\n" << std::fixed << std::setprecision(4);
+    return true;
+}
+
+void FramePacer::CloseLog()
+{
+    if (m_log.is_open()) m_log.close();
+}
+
+FramePacer::FrameStats FramePacer::GetAverage() const
+{
+    FrameStats average;
+    const int count = (int)std::min<Uint64>(m_frameCount, HISTORY_SIZE);
+    if (count == 0) return average;
+
+    for (int i = 0; i < count; i++)
+    {
+        average.cpuNS += m_history[i].cpuNS;
+        average.waitNS += m_history[i].waitNS;
+        average.presentNS += m_history[i].presentNS;
+        average.frameNS += m_history[i].frameNS;
+    }
+    average.cpuNS /= count;
+    average.waitNS /= count;
+    average.presentNS /= count;
+    average.frameNS /= count;
+    return average;
+}
+
+FramePacer::FrameStats FramePacer::GetMaximum() const
+{
+    FrameStats maximum;
+    const int count = (int)std::min<Uint64>(m_frameCount, HISTORY_SIZE);
+    for (int i = 0; i < count; i++)
+    {
+        maximum.cpuNS = std::max(maximum.cpuNS, m_history[i].cpuNS);
+        maximum.waitNS = std::max(maximum.waitNS, m_history[i].waitNS);
+        maximum.presentNS = std::max(maximum.presentNS, m_history[i].presentNS);
+        maximum.frameNS = std::max(maximum.frameNS, m_history[i].frameNS);
+    }
+    return maximum;
+}
+
+int FramePacer::GetFrameTimesMS(float times[HISTORY_SIZE]) const
+{
+    const int count = (int)std::min<Uint64>(m_frameCount, HISTORY_SIZE);
+    const Uint64 first = m_frameCount - count;
+    for (int i = 0; i < count; i++)
+    {
+        times[i] = (float)((double)m_history[(first + i) % HISTORY_SIZE].frameNS / 1e6);
+    }
+    return count;
+}
+
+void FramePacer::WaitUntil(Uint64 deadlineNS)
+{
+    // Endormissement jusqu'à peu avant la date puis attente active
+    Uint64 nowNS = SDL_GetTicksNS();
+    if (deadlineNS > nowNS + m_spinTailNS)
+    {
+        SDL_DelayPrecise(deadlineNS - nowNS - m_spinTailNS);
+    }
+    while (SDL_GetTicksNS() < deadlineNS)
+    {
+        SDL_CPUPauseInstruction();
+    }
+}
+
+float FramePacer::GetDisplayRefreshRate() const
+{
+    SDL_Window *window = SDL_GetRenderWindow(m_renderer);
+    const SDL_DisplayMode *displayMode = window ?
+        SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window)) : nullptr;
+    if (displayMode && displayMode->refresh_rate > 0.f)
+    {
+        return displayMode->refresh_rate;
+    }
+    return DEFAULT_TARGET_FPS;
+}
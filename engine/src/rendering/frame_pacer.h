@@ -0,0 +1,142 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <fstream>
+
+/// @brief Cadence l'affichage des frames et mesure leurs temps.
+///
+/// Chaque frame est découpée en trois parties :
+/// - le temps CPU (mise à jour et rendu de la scène) ;
+/// - l'attente imposée par le limiteur (mode CAPPED) ;
+/// - l'appel à SDL_RenderPresent() (qui attend la synchronisation verticale en mode VSYNC).
+class FramePacer
+{
+public:
+    enum class Mode : int
+    {
+        /// @brief Synchronisation verticale.
+        VSYNC = 0,
+        /// @brief Limité à une fréquence cible, sans synchronisation verticale.
+        CAPPED,
+        /// @brief Aucune limite (pour les mesures de performances).
+        UNCAPPED
+    };
+
+    struct FrameStats
+    {
+        FrameStats();
+
+        Uint64 cpuNS;
+        Uint64 waitNS;
+        Uint64 presentNS;
+        /// @brief Temps entre les deux derniers affichages.
+        Uint64 frameNS;
+    };
+
+    /// @brief Nombre de frames conservées dans l'historique.
+    static constexpr int HISTORY_SIZE = 240;
+
+    FramePacer(SDL_Renderer *renderer);
+    FramePacer(FramePacer const&) = delete;
+    FramePacer& operator=(FramePacer const&) = delete;
+    ~FramePacer();
+
+    /// @brief Change le mode de cadence.
+    /// Si la synchronisation verticale n'est pas disponible, le mode VSYNC
+    /// est remplacé par le mode CAPPED à la fréquence de l'écran.
+    /// @param mode le mode.
+    /// @param targetFPS la fréquence cible en mode CAPPED (0 pour conserver la fréquence courante).
+    void SetMode(Mode mode, float targetFPS = 0.f);
+    Mode GetMode() const;
+    float GetTargetFPS() const;
+
+    /// @brief Définit la durée de l'attente active qui termine chaque attente
+    /// du mode CAPPED. Elle compense l'imprécision de l'endormissement du thread.
+    void SetSpinTailNS(Uint64 spinTailNS);
+    Uint64 GetSpinTailNS() const;
+
+    /// @brief Marque le début du travail CPU de la frame.
+    /// Doit être appelée au début de chaque tour de la boucle de rendu.
+    void BeginFrame();
+
+    /// @brief Attend éventuellement la date d'affichage puis affiche le rendu.
+    /// Remplace l'appel à SDL_RenderPresent().
+    void EndFrame();
+
+    /// @brief Écrit les temps de chaque frame dans un fichier CSV.
+    /// @return false si le fichier ne peut pas être ouvert.
+    bool OpenLog(const std::string &path);
+    void CloseLog();
+
+    const FrameStats &GetLastFrame() const;
+    /// @brief Renvoie la moyenne des temps sur l'historique.
+    FrameStats GetAverage() const;
+    /// @brief Renvoie les maxima des temps sur l'historique.
+    FrameStats GetMaximum() const;
+    Uint64 GetFrameCount() const;
+
+    /// @brief Copie les temps des frames (en millisecondes) de la plus ancienne
+    /// à la plus récente, pour les graphiques.
+    /// @return Le nombre de valeurs écrites.
+    int GetFrameTimesMS(float times[HISTORY_SIZE]) const;
+
+private:
+    SDL_Renderer *m_renderer;
+    Mode m_mode;
+    float m_targetFPS;
+    Uint64 m_targetNS;
+    Uint64 m_spinTailNS;
+
+    Uint64 m_frameStartNS;
+    Uint64 m_lastPresentNS;
+    Uint64 m_deadlineNS;
+
+    std::array<FrameStats, HISTORY_SIZE> m_history;
+    Uint64 m_frameCount;
+    std::ofstream m_log;
+
+    void WaitUntil(Uint64 deadlineNS);
+    float GetDisplayRefreshRate() const;
+};
+
+inline FramePacer::Mode FramePacer::GetMode() const
+{
+    return m_mode;
+}
+
+inline float FramePacer::GetTargetFPS() const
+{
+    return m_targetFPS;
+}
+
+inline void FramePacer::SetSpinTailNS(Uint64 spinTailNS)
+{
+    m_spinTailNS = spinTailNS;
+}
+
+inline Uint64 FramePacer::GetSpinTailNS() const
+{
+    return m_spinTailNS;
+}
+
+inline void FramePacer::BeginFrame()
+{
+    m_frameStartNS = SDL_GetTicksNS();
+}
+
+inline const FramePacer::FrameStats &FramePacer::GetLastFrame() const
+{
+    return m_history[(m_frameCount + HISTORY_SIZE - 1) % HISTORY_SIZE];
+}
+
+inline Uint64 FramePacer::GetFrameCount() const
+{
+    return m_frameCount;
+}
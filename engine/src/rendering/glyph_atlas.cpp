@@ -0,0 +1,89 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "rendering/glyph_atlas.h"
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font, const char *charset)
+    : m_texture(nullptr)
+    , m_rects()
+    , m_hasGlyph()
+    , m_height(0.f)
+    , m_fontSize(font ? TTF_GetFontSize(font) : 0.f)
+{
+    m_hasGlyph.fill(false);
+    if (renderer == nullptr || font == nullptr) return;
+
+    // Chaque caractère est rendu seul : sa surface a la hauteur de la police
+    // et la largeur de son avance, les caractères s'alignent donc sur la ligne de base
+    const SDL_Color white = { 255, 255, 255, 255 };
+    std::vector<std::pair<char, SDL_Surface *>> glyphs;
+    int width = 0;
+    int height = 0;
+    for (const char *c = charset; *c != '\0'; c++)
+    {
+        const unsigned char index = (unsigned char)*c;
+        if (index >= m_rects.size() || m_hasGlyph[index]) continue;
+
+        SDL_Surface *glyph = TTF_RenderText_Blended(font, c, 1, white);
+        if (glyph == nullptr) continue;
+
+        // Un pixel d'écart évite que le filtrage ne mélange deux caractères
+        m_rects[index] = { (float)width, 0.f, (float)glyph->w, (float)glyph->h };
+        m_hasGlyph[index] = true;
+        width += glyph->w + 1;
+        height = std::max(height, glyph->h);
+        glyphs.push_back(std::make_pair(*c, glyph));
+    }
+    m_height = (float)height;
+
+    SDL_Surface *surface = nullptr;
+    if (width > 0 && height > 0)
+    {
+        surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    }
+    if (surface)
+    {
+        SDL_FillSurfaceRect(surface, nullptr, 0);
+        for (auto &[c, glyph] : glyphs)
+        {
+            const SDL_FRect &rect = m_rects[(unsigned char)c];
+            SDL_Rect dstRect = { (int)rect.x, 0, glyph->w, glyph->h };
+            SDL_SetSurfaceBlendMode(glyph, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyph, nullptr, surface, &dstRect);
+        }
+        m_texture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_DestroySurface(surface);
+    }
+    for (auto &[c, glyph] : glyphs)
+    {
+        SDL_DestroySurface(glyph);
+    }
+
+    if (m_texture == nullptr)
+    {
+        std::cout << "ERROR - Create glyph atlas" << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        m_hasGlyph.fill(false);
+        return;
+    }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    if (m_texture) SDL_DestroyTexture(m_texture);
+}
+
+float GlyphAtlas::GetTextWidth(const char *text) const
+{
+    float width = 0.f;
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        const SDL_FRect *rect = GetGlyphRect(*c);
+        if (rect) width += rect->w;
+    }
+    return width;
+}
@@ -0,0 +1,69 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Texture contenant quelques caractères d'une police, rendus une fois
+/// en blanc. Elle permet d'afficher des nombres qui changent à chaque frame
+/// sans mise en page SDL_ttf (voir UINumberText).
+/// La couleur est appliquée au rendu avec SDL_SetTextureColorMod().
+class GlyphAtlas
+{
+public:
+    static constexpr const char *DEFAULT_CHARSET = "0123456789%+-.,:/ ";
+
+    /// @param renderer le moteur de rendu de la texture.
+    /// @param font la police, à sa taille courante.
+    /// @param charset les caractères ASCII de l'atlas.
+    GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font, const char *charset = DEFAULT_CHARSET);
+    GlyphAtlas(GlyphAtlas const&) = delete;
+    GlyphAtlas& operator=(GlyphAtlas const&) = delete;
+    ~GlyphAtlas();
+
+    SDL_Texture *GetTexture() const;
+
+    /// @brief Renvoie le rectangle source d'un caractère,
+    /// ou nullptr si le caractère n'est pas dans l'atlas.
+    const SDL_FRect *GetGlyphRect(char c) const;
+
+    /// @brief Renvoie la largeur d'un texte en pixels.
+    float GetTextWidth(const char *text) const;
+    float GetHeight() const;
+
+    /// @brief Renvoie la taille de la police lors de la création de l'atlas.
+    float GetFontSize() const;
+
+private:
+    SDL_Texture *m_texture;
+    std::array<SDL_FRect, 128> m_rects;
+    std::array<bool, 128> m_hasGlyph;
+    float m_height;
+    float m_fontSize;
+};
+
+inline SDL_Texture *GlyphAtlas::GetTexture() const
+{
+    return m_texture;
+}
+
+inline const SDL_FRect *GlyphAtlas::GetGlyphRect(char c) const
+{
+    const unsigned char index = (unsigned char)c;
+    if (index >= m_rects.size() || m_hasGlyph[index] == false) return nullptr;
+    return &m_rects[index];
+}
+
+inline float GlyphAtlas::GetHeight() const
+{
+    return m_height;
+}
+
+inline float GlyphAtlas::GetFontSize() const
+{
+    return m_fontSize;
+}
@@ -0,0 +1,110 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "rendering/line_batch.h"
+
+LineBatch::LineBatch()
+    : m_points()
+    , m_polylines()
+    , m_vertices()
+    , m_indices()
+    , m_lastCallCount(0)
+{
+}
+
+void LineBatch::Clear()
+{
+    m_points.clear();
+    m_polylines.clear();
+}
+
+SDL_FPoint *LineBatch::AddPolyline(Color color, int pointCount)
+{
+    assert(pointCount >= 0);
+
+    Polyline polyline = { 0 };
+    polyline.color = SDL_FColor{
+        color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f
+    };
+    polyline.firstPoint = (int)m_points.size();
+    polyline.pointCount = pointCount;
+    m_polylines.push_back(polyline);
+
+    m_points.resize(m_points.size() + pointCount);
+    return m_points.data() + polyline.firstPoint;
+}
+
+void LineBatch::AddLine(Color color, float x1, float y1, float x2, float y2)
+{
+    SDL_FPoint *points = AddPolyline(color, 2);
+    points[0] = { x1, y1 };
+    points[1] = { x2, y2 };
+}
+
+void LineBatch::Render(SDL_Renderer *renderer)
+{
+    m_lastCallCount = 0;
+    m_vertices.clear();
+    m_indices.clear();
+
+    // Un quadrilatère d'un pixel d'épaisseur par segment
+    for (const Polyline &polyline : m_polylines)
+    {
+        const SDL_FPoint *points = m_points.data() + polyline.firstPoint;
+        for (int i = 0; i + 1 < polyline.pointCount; i++)
+        {
+            const SDL_FPoint a = points[i];
+            const SDL_FPoint b = points[i + 1];
+            float dx = b.x - a.x;
+            float dy = b.y - a.y;
+            const float length = sqrtf(dx * dx + dy * dy);
+            if (length > 0.f)
+            {
+                dx /= length;
+                dy /= length;
+            }
+            else
+            {
+                dx = 1.f;
+                dy = 0.f;
+            }
+
+            // Demi-épaisseur le long de la normale, demi-pixel aux extrémités
+            const float nx = -0.5f * dy;
+            const float ny = +0.5f * dx;
+            const float tx = 0.5f * dx;
+            const float ty = 0.5f * dy;
+
+            const int first = (int)m_vertices.size();
+            const SDL_FPoint corners[4] = {
+                { a.x - tx + nx, a.y - ty + ny },
+                { a.x - tx - nx, a.y - ty - ny },
+                { b.x + tx - nx, b.y + ty - ny },
+                { b.x + tx + nx, b.y + ty + ny }
+            };
+            for (const SDL_FPoint &corner : corners)
+            {
+                m_vertices.push_back(SDL_Vertex{ corner, polyline.color, SDL_FPoint{ 0.f, 0.f } });
+            }
+            const int quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int index : quadIndices)
+            {
+                m_indices.push_back(first + index);
+            }
+        }
+    }
+
+    if (m_indices.empty() == false)
+    {
+        SDL_RenderGeometry(
+            renderer, nullptr,
+            m_vertices.data(), (int)m_vertices.size(),
+            m_indices.data(), (int)m_indices.size()
+        );
+        m_lastCallCount = 1;
+    }
+    Clear();
+}
@@ -0,0 +1,55 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "utils/color.h"
+
+/// @brief Lignes brisées de debug, dessinées en un seul appel.
+///
+/// Chaque segment est converti en un quadrilatère d'un pixel d'épaisseur,
+/// coloré par sommet : toutes les lignes, quelles que soient leurs couleurs,
+/// sont soumises en un seul appel à SDL_RenderGeometry(). Les tableaux sont
+/// conservés entre deux rendus : le remplissage n'alloue plus une fois la
+/// capacité atteinte.
+class LineBatch
+{
+public:
+    LineBatch();
+
+    void Clear();
+
+    /// @brief Ajoute une ligne brisée de `pointCount` points (en pixels de la vue).
+    /// @return Les points à remplir, valides jusqu'au prochain ajout.
+    SDL_FPoint *AddPolyline(Color color, int pointCount);
+    void AddLine(Color color, float x1, float y1, float x2, float y2);
+
+    /// @brief Dessine les lignes puis vide le lot.
+    void Render(SDL_Renderer *renderer);
+
+    /// @brief Renvoie le nombre d'appels à SDL_RenderGeometry() du dernier rendu.
+    int GetLastCallCount() const;
+
+private:
+    struct Polyline
+    {
+        SDL_FColor color;
+        int firstPoint;
+        int pointCount;
+    };
+
+    std::vector<SDL_FPoint> m_points;
+    std::vector<Polyline> m_polylines;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+    int m_lastCallCount;
+};
+
+inline int LineBatch::GetLastCallCount() const
+{
+    return m_lastCallCount;
+}
@@ -8,6 +8,7 @@
 #include "game_engine_settings.h"
 #include "game_engine_common.h"
 #include "scene/asset_manager.h"
+#include "scene/asset_pack.h"
 #include <cstdio>
 
 #ifndef AssertNew
@@ -52,235 +53,494 @@ char *Parser_MakePath(const char *dir, const char *fname)
 }
 
 
-void SpriteSheet::LoadRect(cJSON *jRect, int i)
+namespace
 {
-    SDL_FRect *rect = m_rects + i;
-    cJSON *jTmp = NULL;
+    constexpr Uint32 SHEET_MAGIC = 0x42485353; // "SSHB"
+    constexpr Uint32 SHEET_VERSION = 1;
+    constexpr size_t SHEET_HEADER_SIZE = 8 * sizeof(Uint32);
+    constexpr size_t SHEET_GROUP_SIZE = 5 * sizeof(Uint32);
 
-    jTmp = cJSON_GetObjectItem(jRect, "x");
-    if (cJSON_IsNumber(jTmp))
+    /// @brief Contenu d'une sprite sheet lu dans un fichier JSON.
+    struct SheetDesc
     {
-        rect->x = static_cast<float>(jTmp->valueint);
-    }
-
-    jTmp = cJSON_GetObjectItem(jRect, "y");
-    if (cJSON_IsNumber(jTmp))
+        std::string texture;
+        std::vector<SDL_FRect> rects;
+        std::vector<std::string> groupNames;
+        std::vector<std::vector<int>> groupFrames;
+    };
+
+    /// @brief Indique si un fichier binaire existe et n'est pas plus ancien
+    /// que le fichier JSON dont il est issu (ou si le JSON est absent).
+    bool IsBinaryFileUpToDate(const std::string &binaryPath, const std::string &jsonPath)
     {
-        rect->y = static_cast<float>(jTmp->valueint);
-    }
+        SDL_PathInfo binaryInfo = { };
+        if (SDL_GetPathInfo(binaryPath.c_str(), &binaryInfo) == false) return false;
 
-    jTmp = cJSON_GetObjectItem(jRect, "w");
-    if (cJSON_IsNumber(jTmp))
-    {
-        rect->w = static_cast<float>(jTmp->valueint);
+        SDL_PathInfo jsonInfo = { };
+        if (SDL_GetPathInfo(jsonPath.c_str(), &jsonInfo) == false) return true;
+
+        return binaryInfo.modify_time >= jsonInfo.modify_time;
     }
 
-    jTmp = cJSON_GetObjectItem(jRect, "h");
-    if (cJSON_IsNumber(jTmp))
+    float GetRectValue(cJSON *jRect, const char *name)
     {
-        rect->h = static_cast<float>(jTmp->valueint);
+        cJSON *jTmp = cJSON_GetObjectItem(jRect, name);
+        return cJSON_IsNumber(jTmp) ? static_cast<float>(jTmp->valueint) : 0.f;
     }
-}
-
-void SpriteSheet::LoadPart(cJSON *jPart, int i)
-{
-    SpriteGroup *part = new SpriteGroup(*this);
-    m_groups[i] = part;
-    cJSON *jTmp = NULL;
 
-    jTmp = cJSON_GetObjectItem(jPart, "name");
-    if (cJSON_IsString(jTmp))
+    int GetGeometryValue(cJSON *jGeo, const char *name, int defaultValue)
     {
-        part->m_name.assign(cJSON_GetStringValue(jTmp));
+        cJSON *jTmp = cJSON_GetObjectItem(jGeo, name);
+        return cJSON_IsNumber(jTmp) ? jTmp->valueint : defaultValue;
     }
 
-    jTmp = cJSON_GetObjectItem(jPart, "frames");
-    if (cJSON_IsArray(jTmp))
+    bool LoadGeometry(cJSON *jGeo, SheetDesc &desc)
     {
-        int frameCount = cJSON_GetArraySize(jTmp);
-        part->m_spriteCount = frameCount;
-        part->m_spriteIndices = (int *)calloc(frameCount, sizeof(int));
-        AssertNew(part->m_spriteIndices);
-
-        int i = 0;
-        cJSON *jIdx = NULL;
-        cJSON_ArrayForEach(jIdx, jTmp)
+        cJSON *jRow = cJSON_GetObjectItem(jGeo, "rowCount");
+        cJSON *jCol = cJSON_GetObjectItem(jGeo, "colCount");
+        cJSON *jWidth = cJSON_GetObjectItem(jGeo, "width");
+        cJSON *jHeight = cJSON_GetObjectItem(jGeo, "height");
+        if (!(cJSON_IsNumber(jRow) && cJSON_IsNumber(jCol)
+            && cJSON_IsNumber(jWidth) && cJSON_IsNumber(jHeight)))
         {
-            if (cJSON_IsNumber(jIdx))
-            {
-                (part->m_spriteIndices)[i] = jIdx->valueint;
-            }
-            i++;
+            return false;
         }
-    }
-}
 
-void SpriteSheet::LoadGeometry(cJSON *jGeo)
-{
-    cJSON *jRow = cJSON_GetObjectItem(jGeo, "rowCount");
-    cJSON *jCol = cJSON_GetObjectItem(jGeo, "colCount");
-    cJSON *jWidth = cJSON_GetObjectItem(jGeo, "width");
-    cJSON *jHeight = cJSON_GetObjectItem(jGeo, "height");
-    cJSON *jOffset = cJSON_GetObjectItem(jGeo, "padding");
-    cJSON *jBorder = cJSON_GetObjectItem(jGeo, "spacing");
-    cJSON *jOffsetX = cJSON_GetObjectItem(jGeo, "paddingX");
-    cJSON *jOffsetY = cJSON_GetObjectItem(jGeo, "paddingY");
-    cJSON *jBorderX = cJSON_GetObjectItem(jGeo, "spacingX");
-    cJSON *jBorderY = cJSON_GetObjectItem(jGeo, "spacingY");
-
-    if (cJSON_IsNumber(jRow) && cJSON_IsNumber(jCol)
-        && cJSON_IsNumber(jWidth) && cJSON_IsNumber(jHeight))
-    {
         int rowCount = jRow->valueint;
         int colCount = jCol->valueint;
         int w = jWidth->valueint;
         int h = jHeight->valueint;
-        int offsetX = cJSON_IsNumber(jOffsetX) ? jOffsetX->valueint : 0;
-        int offsetY = cJSON_IsNumber(jOffsetY) ? jOffsetY->valueint : 0;
-        int borderX = cJSON_IsNumber(jBorderX) ? jBorderX->valueint : 0;
-        int borderY = cJSON_IsNumber(jBorderY) ? jBorderY->valueint : 0;
-
-        if (cJSON_IsNumber(jOffset))
-        {
-            offsetX = jOffset->valueint;
-            offsetY = jOffset->valueint;
-        }
-        if (cJSON_IsNumber(jBorder))
-        {
-            borderX = jBorder->valueint;
-            borderY = jBorder->valueint;
-        }
-
-        int rectCount = rowCount * colCount;
-
-        m_rectCount = rectCount;
-        m_rects = (SDL_FRect *)calloc(rectCount, sizeof(SDL_FRect));
-        AssertNew(m_rects);
-
+        // "padding" et "spacing" remplacent les valeurs par axe
+        int offsetX = GetGeometryValue(jGeo, "paddingX", 0);
+        int offsetY = GetGeometryValue(jGeo, "paddingY", 0);
+        int borderX = GetGeometryValue(jGeo, "spacingX", 0);
+        int borderY = GetGeometryValue(jGeo, "spacingY", 0);
+        offsetX = GetGeometryValue(jGeo, "padding", offsetX);
+        offsetY = GetGeometryValue(jGeo, "padding", offsetY);
+        borderX = GetGeometryValue(jGeo, "spacing", borderX);
+        borderY = GetGeometryValue(jGeo, "spacing", borderY);
+
+        desc.rects.resize((size_t)std::max(0, rowCount * colCount));
         for (int i = 0; i < rowCount; ++i)
         {
             for (int j = 0; j < colCount; ++j)
             {
-                SDL_FRect *rect = &(m_rects[i * colCount + j]);
+                SDL_FRect *rect = &(desc.rects[i * colCount + j]);
                 rect->x = static_cast<float>(offsetX + j * (w + borderX));
                 rect->y = static_cast<float>(offsetY + i * (h + borderY));
                 rect->w = static_cast<float>(w);
                 rect->h = static_cast<float>(h);
             }
         }
+        return true;
     }
-}
 
-char *SpriteSheet::ParseJSON(cJSON *json)
-{
-    char *fname = NULL;
+    bool ParseJSON(cJSON *json, SheetDesc &desc)
+    {
+        cJSON *jTex = cJSON_GetObjectItem(json, "texture");
+        if (cJSON_IsString(jTex))
+        {
+            desc.texture = cJSON_GetStringValue(jTex);
+        }
+
+        cJSON *jRects = cJSON_GetObjectItem(json, "rectangles");
+        if (cJSON_IsArray(jRects))
+        {
+            cJSON *jRect = NULL;
+            cJSON_ArrayForEach(jRect, jRects)
+            {
+                SDL_FRect rect = {
+                    GetRectValue(jRect, "x"), GetRectValue(jRect, "y"),
+                    GetRectValue(jRect, "w"), GetRectValue(jRect, "h")
+                };
+                desc.rects.push_back(rect);
+            }
+        }
+        else
+        {
+            cJSON *jGeo = cJSON_GetObjectItem(json, "geometry");
+            if (jGeo == NULL || LoadGeometry(jGeo, desc) == false) return false;
+        }
 
-    cJSON *jTex = cJSON_GetObjectItem(json, "texture");
-    if (cJSON_IsString(jTex))
+        cJSON *jParts = cJSON_GetObjectItem(json, "parts");
+        cJSON *jPart = NULL;
+        cJSON_ArrayForEach(jPart, jParts)
+        {
+            cJSON *jName = cJSON_GetObjectItem(jPart, "name");
+            cJSON *jFrames = cJSON_GetObjectItem(jPart, "frames");
+            desc.groupNames.push_back(cJSON_IsString(jName) ? cJSON_GetStringValue(jName) : "");
+            desc.groupFrames.emplace_back();
+
+            cJSON *jIdx = NULL;
+            cJSON_ArrayForEach(jIdx, jFrames)
+            {
+                desc.groupFrames.back().push_back(cJSON_IsNumber(jIdx) ? jIdx->valueint : 0);
+            }
+        }
+        return true;
+    }
+
+    void WriteU32(std::vector<Uint8> &binary, size_t offset, Uint32 value)
     {
-        fname = cJSON_GetStringValue(jTex);
+        value = SDL_Swap32LE(value);
+        memcpy(binary.data() + offset, &value, sizeof(Uint32));
     }
 
-    cJSON *jRects = cJSON_GetObjectItem(json, "rectangles");
+    Uint32 ReadU32(const Uint8 *binary, size_t offset)
+    {
+        Uint32 value = 0;
+        memcpy(&value, binary + offset, sizeof(Uint32));
+        return SDL_Swap32LE(value);
+    }
+
+    size_t Align4(size_t size)
+    {
+        return (size + 3) & ~(size_t)3;
+    }
+}
 
-    if (cJSON_IsArray(jRects))
+bool SpriteSheet::ConvertJSON(const char *text, size_t size, std::vector<Uint8> &binary)
+{
+    cJSON *json = cJSON_ParseWithLength(text, size);
+    if (json == NULL) return false;
+
+    SheetDesc desc;
+    const bool success = ParseJSON(json, desc);
+    cJSON_Delete(json);
+    if (success == false) return false;
+
+    const Uint32 rectCount = (Uint32)desc.rects.size();
+    const Uint32 groupCount = (Uint32)desc.groupNames.size();
+    Uint32 indexCount = 0;
+    for (const std::vector<int> &frames : desc.groupFrames) indexCount += (Uint32)frames.size();
+
+    // Table de hachage  adressage ouvert, remplie au plus  moiti
+    Uint32 tableSize = 1;
+    while (tableSize < 2 * groupCount) tableSize *= 2;
+
+    size_t stringsSize = desc.texture.size() + 1;
+    for (const std::string &name : desc.groupNames) stringsSize += name.size() + 1;
+
+    const size_t rectsOffset = SHEET_HEADER_SIZE;
+    const size_t groupsOffset = rectsOffset + rectCount * 4 * sizeof(float);
+    const size_t indicesOffset = groupsOffset + groupCount * SHEET_GROUP_SIZE;
+    const size_t tableOffset = indicesOffset + indexCount * sizeof(Sint32);
+    const size_t stringsOffset = tableOffset + tableSize * sizeof(Uint32);
+    binary.assign(Align4(stringsOffset + stringsSize), 0);
+
+    WriteU32(binary, 0, SHEET_MAGIC);
+    WriteU32(binary, 4, SHEET_VERSION);
+    WriteU32(binary, 8, rectCount);
+    WriteU32(binary, 12, groupCount);
+    WriteU32(binary, 16, indexCount);
+    WriteU32(binary, 20, tableSize);
+    WriteU32(binary, 24, (Uint32)stringsSize);
+    WriteU32(binary, 28, 0);
+
+    for (Uint32 i = 0; i < rectCount; i++)
     {
-        int rectCount = cJSON_GetArraySize(jRects);
-        m_rectCount = rectCount;
-        m_rects = (SDL_FRect *)calloc(rectCount, sizeof(SDL_FRect));
-        AssertNew(m_rects);
-
-        int i = 0;
-        cJSON *jRect = NULL;
-        cJSON_ArrayForEach(jRect, jRects)
+        const SDL_FRect &rect = desc.rects[i];
+        const float values[4] = { rect.x, rect.y, rect.w, rect.h };
+        for (int k = 0; k < 4; k++)
         {
-            LoadRect(jRect, i++);
+            Uint32 value = 0;
+            memcpy(&value, &values[k], sizeof(Uint32));
+            WriteU32(binary, rectsOffset + (4 * i + k) * sizeof(Uint32), value);
         }
     }
-    else
-    {
-        cJSON *jGeo = cJSON_GetObjectItem(json, "geometry");
 
-        if (jGeo)
+    // Nom de la texture en premier, puis les noms des groupes
+    size_t stringOffset = 0;
+    memcpy(binary.data() + stringsOffset, desc.texture.c_str(), desc.texture.size() + 1);
+    stringOffset += desc.texture.size() + 1;
+
+    Uint32 firstIndex = 0;
+    for (Uint32 i = 0; i < groupCount; i++)
+    {
+        const std::string &name = desc.groupNames[i];
+        const std::vector<int> &frames = desc.groupFrames[i];
+        const Uint32 nameHash = HashName(name);
+        const size_t groupOffset = groupsOffset + i * SHEET_GROUP_SIZE;
+        WriteU32(binary, groupOffset + 0, nameHash);
+        WriteU32(binary, groupOffset + 4, (Uint32)stringOffset);
+        WriteU32(binary, groupOffset + 8, (Uint32)name.size());
+        WriteU32(binary, groupOffset + 12, firstIndex);
+        WriteU32(binary, groupOffset + 16, (Uint32)frames.size());
+
+        memcpy(binary.data() + stringsOffset + stringOffset, name.c_str(), name.size() + 1);
+        stringOffset += name.size() + 1;
+
+        for (int frame : frames)
         {
-            LoadGeometry(jGeo);
+            WriteU32(binary, indicesOffset + firstIndex * sizeof(Sint32), (Uint32)frame);
+            firstIndex++;
         }
-        else
+
+        // Le premier groupe d'un nom reste prioritaire, comme avec une recherche linaire
+        Uint32 slot = nameHash & (tableSize - 1);
+        while (ReadU32(binary.data(), tableOffset + slot * sizeof(Uint32)) != 0)
         {
-            assert(false);
+            slot = (slot + 1) & (tableSize - 1);
         }
+        WriteU32(binary, tableOffset + slot * sizeof(Uint32), i + 1);
+    }
+    return true;
+}
 
+bool SpriteSheet::ConvertFile(const std::string &jsonPath, const std::string &binaryPath)
+{
+    size_t size = 0;
+    void *text = SDL_LoadFile(jsonPath.c_str(), &size);
+    if (text == NULL)
+    {
+        std::cout << "ERROR - The file " << jsonPath << " cannot be opened" << std::endl;
+        return false;
     }
 
-    cJSON *jParts = cJSON_GetObjectItem(json, "parts");
+    std::vector<Uint8> binary;
+    const bool converted = ConvertJSON((const char *)text, size, binary);
+    SDL_free(text);
+    if (converted == false)
+    {
+        std::cout << "ERROR - Invalid sprite sheet " << jsonPath << std::endl;
+        return false;
+    }
 
-    if (cJSON_IsArray(jParts))
+    if (SDL_SaveFile(binaryPath.c_str(), binary.data(), binary.size()) == false)
     {
-        int partCount = cJSON_GetArraySize(jParts);
-        m_groupCount = partCount;
-        m_groups = (SpriteGroup **)calloc(partCount, sizeof(SpriteGroup *));
-        AssertNew(m_groups);
+        std::cout
+            << "ERROR - Write sprite sheet " << binaryPath << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
 
-        int i = 0;
-        cJSON *jPart = NULL;
-        cJSON_ArrayForEach(jPart, jParts)
+std::string SpriteSheet::GetBinaryPath(const std::string &jsonPath)
+{
+    const size_t dot = jsonPath.find_last_of('.');
+    const size_t slash = jsonPath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return jsonPath + ".sheet";
+    }
+    return jsonPath.substr(0, dot) + ".sheet";
+}
+
+std::string SpriteSheet::LoadBinary(Uint8 *binary, size_t size)
+{
+    assert(m_binary == nullptr);
+    m_binary = binary;
+
+    bool valid = (size >= SHEET_HEADER_SIZE)
+        && ((uintptr_t)binary % alignof(Uint32) == 0)
+        && ReadU32(binary, 0) == SHEET_MAGIC
+        && ReadU32(binary, 4) == SHEET_VERSION;
+
+    const Uint32 rectCount = valid ? ReadU32(binary, 8) : 0;
+    const Uint32 groupCount = valid ? ReadU32(binary, 12) : 0;
+    const Uint32 indexCount = valid ? ReadU32(binary, 16) : 0;
+    const Uint32 tableSize = valid ? ReadU32(binary, 20) : 0;
+    const Uint32 stringsSize = valid ? ReadU32(binary, 24) : 0;
+
+    const size_t rectsOffset = SHEET_HEADER_SIZE;
+    const size_t groupsOffset = rectsOffset + (size_t)rectCount * 4 * sizeof(float);
+    const size_t indicesOffset = groupsOffset + (size_t)groupCount * SHEET_GROUP_SIZE;
+    const size_t tableOffset = indicesOffset + (size_t)indexCount * sizeof(Sint32);
+    const size_t stringsOffset = tableOffset + (size_t)tableSize * sizeof(Uint32);
+    valid = valid && stringsOffset + stringsSize <= size && stringsSize > 0
+        && tableSize > groupCount && (tableSize & (tableSize - 1)) == 0
+        && binary[stringsOffset + stringsSize - 1] == '\0';
+    if (valid == false)
+    {
+        printf("ERROR - Invalid binary sprite sheet\n");
+        assert(false);
+        abort();
+    }
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    // Les rectangles et les indices sont lus sur place : ils sont convertis une fois
+    for (size_t offset = rectsOffset; offset < stringsOffset; offset += sizeof(Uint32))
+    {
+        Uint32 value = ReadU32(binary, offset);
+        memcpy(binary + offset, &value, sizeof(Uint32));
+    }
+#endif
+
+    // Les tableaux pointent directement dans le fichier charg
+    m_rects = (SDL_FRect *)(binary + rectsOffset);
+    m_rectCount = (int)rectCount;
+    m_groupTable = (const Uint32 *)(binary + tableOffset);
+    m_groupTableSize = tableSize;
+
+    const int *indices = (const int *)(binary + indicesOffset);
+    const char *strings = (const char *)(binary + stringsOffset);
+    m_groups.reserve(groupCount);
+    for (Uint32 i = 0; i < groupCount; i++)
+    {
+        const size_t groupOffset = groupsOffset + i * SHEET_GROUP_SIZE;
+        const Uint32 nameOffset = ReadU32(binary, groupOffset + 4);
+        const Uint32 nameLength = ReadU32(binary, groupOffset + 8);
+        const Uint32 firstIndex = ReadU32(binary, groupOffset + 12);
+        const Uint32 spriteCount = ReadU32(binary, groupOffset + 16);
+        if ((size_t)nameOffset + nameLength >= stringsSize
+            || strings[nameOffset + nameLength] != '\0'
+            || (size_t)firstIndex + spriteCount > indexCount)
         {
-            LoadPart(jPart, i++);
+            printf("ERROR - Invalid group in a binary sprite sheet\n");
+            assert(false);
+            abort();
+        }
+
+        // Le nom et les indices sont utiliss sur place
+        m_groups.emplace_back(
+            *this, ReadU32(binary, groupOffset + 0),
+            std::string_view(strings + nameOffset, nameLength),
+            indices + firstIndex, (int)spriteCount
+        );
+    }
+    for (Uint32 slot = 0; slot < tableSize; slot++)
+    {
+        if (m_groupTable[slot] > groupCount)
+        {
+            printf("ERROR - Invalid group table in a binary sprite sheet\n");
+            assert(false);
+            abort();
         }
     }
 
-    return fname;
+    return std::string(strings);
 }
 
 SpriteSheet::SpriteSheet(SDL_Renderer *renderer, const std::string &path)
-    : m_renderer(renderer)
+    : SpriteSheet(path, renderer != nullptr)
 {
-    // Lit le fichier et rcupre le contenu dans un buffer
-    FILE *file = fopen(path.c_str(), "rb");
-    AssertNew(file);
+    if (renderer) CreateTexture(renderer);
+}
 
-    fseek(file, 0, SEEK_END);
-    long fileSize = ftell(file);
+SpriteSheet::SpriteSheet(const std::string &path, bool loadImage)
+    : m_renderer(nullptr)
+    , m_texture(nullptr)
+    , m_surface(nullptr)
+    , m_groups()
+    , m_groupTable(nullptr)
+    , m_groupTableSize(0)
+    , m_rects(nullptr)
+    , m_rectCount(0)
+    , m_binary(nullptr)
+{
+    // Cherche d'abord la version binaire (archive puis fichier).
+    // Un fichier binaire plus ancien que le JSON est ignor.
+    const std::string binaryPath = GetBinaryPath(path);
+    AssetPack *assetPack = AssetManager::GetAssetPack();
+    const Uint8 *packData = nullptr;
+    size_t size = 0;
+    Uint8 *binary = NULL;
+    if (assetPack && assetPack->GetData(binaryPath, &packData, &size))
+    {
+        binary = (Uint8 *)SDL_malloc(size);
+        AssertNew(binary);
+        memcpy(binary, packData, size);
+    }
+    else if (IsBinaryFileUpToDate(binaryPath, path))
+    {
+        binary = (Uint8 *)SDL_LoadFile(binaryPath.c_str(), &size);
+    }
 
-    char *buffer = (char *)calloc(fileSize, sizeof(char));
-    AssertNew(buffer);
+    if (binary == NULL)
+    {
+        // Sinon, convertit le fichier JSON en mmoire
+        const char *text = NULL;
+        void *fileData = NULL;
+        if (assetPack && assetPack->GetData(path, &packData, &size))
+        {
+            text = (const char *)packData;
+        }
+        else
+        {
+            fileData = SDL_LoadFile(path.c_str(), &size);
+            text = (const char *)fileData;
+        }
+        AssertNew(text);
 
-    rewind(file);
-    fread(buffer, 1, fileSize, file);
+        std::vector<Uint8> converted;
+        bool success = ConvertJSON(text, size, converted);
+        SDL_free(fileData);
+        if (success == false)
+        {
+            printf("ERROR - Invalid sprite sheet %s\n", path.c_str());
+            assert(false);
+            abort();
+        }
 
-    fclose(file);
+        size = converted.size();
+        binary = (Uint8 *)SDL_malloc(size);
+        AssertNew(binary);
+        memcpy(binary, converted.data(), size);
+    }
 
-    // Parse le buffer et cre une structure json
-    cJSON *json = cJSON_ParseWithLength(buffer, fileSize);
-    AssertNew(json);
+    const std::string textureName = LoadBinary(binary, size);
 
-    // Parse la structure json
-    char *fname = ParseJSON(json);
+    // Dcode l'image sans crer la texture (possible hors du thread de rendu)
+    if (loadImage)
+    {
+        char *dir = Parser_GetDir(path.c_str());
+        char *texPath = Parser_MakePath(dir, textureName.c_str());
 
-    char *dir = Parser_GetDir(path.c_str());
-    char *texPath = Parser_MakePath(dir, fname);
+        void *ioStreamBuffer = NULL;
+        SDL_IOStream *ioStream = NULL;
+        AssetManager::CreateIOStream(std::string(texPath), &ioStream, &ioStreamBuffer);
 
-    void *ioStreamBuffer = NULL;
-    SDL_IOStream *ioStream = NULL;
-    AssetManager::CreateIOStream(std::string(texPath), &ioStream, &ioStreamBuffer);
+        m_surface = IMG_Load_IO(ioStream, false);
+        if (!m_surface)
+        {
+            printf("ERROR - Loading image %s\n", texPath);
+            printf("      - %s\n", SDL_GetError());
+            assert(false);
+            abort();
+        }
+        free(texPath);
+        free(dir);
 
-    SDL_Texture *texture = IMG_LoadTexture_IO(renderer, ioStream, 0);
+        AssetManager::DestroyIOStream(ioStream, ioStreamBuffer);
+    }
+}
+
+SpriteSheet::SpriteSheet(const void *binary, size_t size)
+    : m_renderer(nullptr)
+    , m_texture(nullptr)
+    , m_surface(nullptr)
+    , m_groups()
+    , m_groupTable(nullptr)
+    , m_groupTableSize(0)
+    , m_rects(nullptr)
+    , m_rectCount(0)
+    , m_binary(nullptr)
+{
+    Uint8 *copy = (Uint8 *)SDL_malloc(size);
+    AssertNew(copy);
+    memcpy(copy, binary, size);
+    LoadBinary(copy, size);
+}
+
+bool SpriteSheet::CreateTexture(SDL_Renderer *renderer)
+{
+    if (m_surface == nullptr) return false;
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, m_surface);
     if (!texture)
     {
-        printf("ERROR - Loading texture %s\n", texPath);
+        printf("ERROR - Creating texture from image\n");
         printf("      - %s\n", SDL_GetError());
         assert(false);
         abort();
     }
-    m_texture = texture;
-    free(texPath);
-    free(dir);
-
-    AssetManager::DestroyIOStream(ioStream, ioStreamBuffer);
+    SDL_DestroySurface(m_surface);
+    m_surface = nullptr;
 
-    // Libre la mmoire temporaire
-    cJSON_Delete(json); json = NULL;
-    free(buffer); buffer = NULL;
+    m_renderer = renderer;
+    m_texture = texture;
+    return true;
 }
 
 SpriteSheet::~SpriteSheet()
@@ -289,27 +549,47 @@ SpriteSheet::~SpriteSheet()
     {
         SDL_DestroyTexture(m_texture);
     }
-
-    if (m_groups)
+    if (m_surface)
     {
-        for (int i = 0; i < m_groupCount; ++i)
-        {
-            delete m_groups[i];
-        }
-        free(m_groups);
+        SDL_DestroySurface(m_surface);
     }
 
-    free(m_rects);
+    SDL_free(m_binary);
 }
 
 
 SpriteGroup *SpriteSheet::GetGroup(const std::string &name)
 {
-    for (int i = 0; i < m_groupCount; ++i)
+    const Uint32 nameHash = HashName(name);
+    const Uint32 mask = m_groupTableSize - 1;
+    Uint32 slot = nameHash & mask;
+    for (Uint32 i = 0; i < m_groupTableSize; i++, slot = (slot + 1) & mask)
     {
-        if (name == m_groups[i]->m_name)
+        const Uint32 entry = m_groupTable[slot];
+        if (entry == 0) break;
+
+        SpriteGroup &group = m_groups[entry - 1];
+        if (group.m_nameHash == nameHash && group.m_name == name)
         {
-            return m_groups[i];
+            return &group;
+        }
+    }
+    return nullptr;
+}
+
+SpriteGroup *SpriteSheet::GetGroupByHash(Uint32 nameHash)
+{
+    const Uint32 mask = m_groupTableSize - 1;
+    Uint32 slot = nameHash & mask;
+    for (Uint32 i = 0; i < m_groupTableSize; i++, slot = (slot + 1) & mask)
+    {
+        const Uint32 entry = m_groupTable[slot];
+        if (entry == 0) break;
+
+        SpriteGroup &group = m_groups[entry - 1];
+        if (group.m_nameHash == nameHash)
+        {
+            return &group;
         }
     }
     return nullptr;
@@ -317,25 +597,23 @@ SpriteGroup *SpriteSheet::GetGroup(const std::string &name)
 
 SpriteGroup *SpriteSheet::GetGroup(int i)
 {
-    assert(0 <= i && i < m_groupCount);
-    return m_groups[i];
+    assert(0 <= i && i < (int)m_groups.size());
+    return &m_groups[i];
 }
 
 int SpriteSheet::GetGroupCount() const
 {
-    return m_groupCount;
+    return (int)m_groups.size();
 }
 
-const std::string &SpriteGroup::GetName() const
+const char *SpriteGroup::GetName() const
 {
-    return m_name;
+    return m_name.data();
 }
 
-SpriteGroup::SpriteGroup(SpriteSheet &spriteSheet) :
-    m_spriteSheet(spriteSheet), m_spriteCount(0), m_spriteIndices(nullptr), m_name("")
+SpriteGroup::SpriteGroup(
+    SpriteSheet &spriteSheet, Uint32 nameHash, std::string_view name,
+    const int *spriteIndices, int spriteCount) :
+    m_spriteSheet(spriteSheet), m_name(name), m_nameHash(nameHash),
+    m_spriteIndices(spriteIndices), m_spriteCount(spriteCount)
 {}
-
-SpriteGroup::~SpriteGroup()
-{
-    if (m_spriteIndices) free(m_spriteIndices);
-}
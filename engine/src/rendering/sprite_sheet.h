@@ -10,12 +10,19 @@
 #include "renderer.h"
 #include "cJSON.h"
 
+#include <string_view>
+
 class SpriteSheet;
 
 class SpriteGroup
 {
 public:
-    ~SpriteGroup();
+    /// @brief Crée un groupe dont le nom et les indices pointent dans les
+    /// données de la sprite sheet (construit sur place par SpriteSheet).
+    SpriteGroup(
+        SpriteSheet &spriteSheet, Uint32 nameHash, std::string_view name,
+        const int *spriteIndices, int spriteCount
+    );
 
     bool RenderTexture(int idx, const SDL_FRect *dstRect, Anchor anchor);
     bool RenderTextureRotated(
@@ -26,61 +33,106 @@ public:
     int GetSpriteCount() const;
     SDL_Texture *GetTexture();
     const SDL_FRect *GetSourceRect(int spriteIdx);
-    const std::string &GetName() const;
+    /// @brief Renvoie le nom du groupe (terminé par un zéro).
+    const char *GetName() const;
 
 protected:
     friend class SpriteSheet;
 
-    SpriteGroup(SpriteSheet &spriteSheet);
-
     SpriteSheet &m_spriteSheet;
-    std::string m_name;
-    int *m_spriteIndices;
+    /// @brief Nom du groupe, dans les données de la sprite sheet.
+    std::string_view m_name;
+    Uint32 m_nameHash;
+    /// @brief Indices des rectangles, dans les données de la sprite sheet.
+    const int *m_spriteIndices;
     int m_spriteCount;
 
 private:
 };
 
+/// @brief Ensemble de sprites regroupés dans une même texture.
+///
+/// La géométrie est lue dans un fichier binaire (.sheet) produit hors ligne
+/// par ConvertFile() à partir du fichier JSON. Le fichier est chargé en une
+/// seule lecture ; les rectangles, les indices et la table de hachage des noms
+/// des groupes sont utilisés sur place. Si le fichier binaire est absent,
+/// le fichier JSON est converti en mémoire au chargement.
 class SpriteSheet
 {
 public:
 
+    /// @param path le chemin du fichier JSON. Le fichier binaire de même nom
+    /// (extension .sheet) est utilisé à la place s'il existe.
     SpriteSheet(SDL_Renderer *renderer, const std::string &path);
+
+    /// @brief Charge la géométrie et, si demandé, décode l'image dans une surface.
+    /// Ce constructeur n'utilise pas le moteur de rendu : il peut être appelé
+    /// depuis un autre thread. La texture est ensuite créée avec CreateTexture().
+    SpriteSheet(const std::string &path, bool loadImage);
+
+    /// @brief Charge uniquement la géométrie depuis le contenu d'un fichier binaire.
+    SpriteSheet(const void *binary, size_t size);
     SpriteSheet(SpriteSheet const&) = delete;
     SpriteSheet& operator=(SpriteSheet const&) = delete;
     ~SpriteSheet();
 
     SDL_Texture *GetTexture();
 
+    /// @brief Crée la texture à partir de l'image décodée puis libère l'image.
+    /// Doit être appelée depuis le thread du moteur de rendu.
+    /// @return false si aucune image n'a été décodée.
+    bool CreateTexture(SDL_Renderer *renderer);
+
     SpriteGroup *GetGroup(const std::string &name);
+    /// @brief Cherche un groupe à partir du hachage de son nom, qui peut être
+    /// calculé à la compilation avec HashName().
+    SpriteGroup *GetGroupByHash(Uint32 nameHash);
     SpriteGroup *GetGroup(int i);
     int GetGroupCount() const;
 
     int GetSourceRectCount() const;
     const SDL_FRect *GetSourceRect(int index) const;
 
+    /// @brief Hachage FNV-1a des noms des groupes.
+    static constexpr Uint32 HashName(std::string_view name);
+
+    /// @brief Convertit le contenu d'un fichier JSON au format binaire.
+    /// @return false si le JSON est invalide.
+    static bool ConvertJSON(const char *text, size_t size, std::vector<Uint8> &binary);
+
+    /// @brief Convertit un fichier JSON et écrit le fichier binaire.
+    static bool ConvertFile(const std::string &jsonPath, const std::string &binaryPath);
+
+    /// @brief Renvoie le chemin du fichier binaire associé à un fichier JSON.
+    static std::string GetBinaryPath(const std::string &jsonPath);
+
 protected:
 
     friend class SpriteGroup;
 
     SDL_Renderer *m_renderer;
     SDL_Texture *m_texture;
+    SDL_Surface *m_surface;
 
-    SpriteGroup **m_groups;
-    int m_groupCount;
-    
-    // TODO
-    //std::map<std::string, SpriteGroup *> m_groupMap;
+    std::vector<SpriteGroup> m_groups;
+
+    /// @brief Table de hachage des noms des groupes (adressage ouvert).
+    /// Chaque case contient l'indice du groupe plus un, ou zéro si elle est vide.
+    const Uint32 *m_groupTable;
+    Uint32 m_groupTableSize;
 
     SDL_FRect *m_rects;
     int m_rectCount;
 
+    /// @brief Contenu du fichier binaire, dans lequel pointent les tableaux.
+    Uint8 *m_binary;
+
 private:
 
-    void LoadRect(cJSON *jRect, int i);
-    void LoadPart(cJSON *jPart, int i);
-    void LoadGeometry(cJSON *jGeo);
-    char *ParseJSON(cJSON *json);
+    /// @brief Prend possession du contenu d'un fichier binaire et initialise
+    /// les pointeurs vers ses tableaux.
+    /// @return Le nom du fichier de la texture.
+    std::string LoadBinary(Uint8 *binary, size_t size);
 };
 
 inline bool SpriteGroup::RenderTexture(
@@ -119,6 +171,17 @@ inline const SDL_FRect *SpriteGroup::GetSourceRect(int i)
     return &(m_spriteSheet.m_rects[rectIndex]);
 }
 
+constexpr Uint32 SpriteSheet::HashName(std::string_view name)
+{
+    Uint32 hash = 2166136261u;
+    for (char c : name)
+    {
+        hash ^= (Uint8)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 inline SDL_Texture *SpriteSheet::GetTexture()
 {
     return m_texture;
@@ -0,0 +1,185 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/asset_cache.h"
+#include "scene/asset_manager.h"
+#include "rendering/sprite_sheet.h"
+
+AssetCache::Entry::Entry()
+    : m_type(Type::TEXTURE)
+    , m_key()
+    , m_asset(nullptr)
+    , m_ioStream(nullptr)
+    , m_ioStreamBuffer(nullptr)
+    , m_size(0)
+    , m_refCount(0)
+    , m_lruIt()
+{
+}
+
+AssetCache::Stats::Stats()
+    : hitCount(0), missCount(0), evictionCount(0)
+{
+}
+
+AssetCache::AssetCache(SDL_Renderer *renderer, size_t budget)
+    : m_renderer(renderer)
+    , m_budget(budget)
+    , m_residentSize(0)
+    , m_unusedSize(0)
+    , m_entries()
+    , m_lru()
+    , m_stats()
+{
+}
+
+AssetCache::~AssetCache()
+{
+    for (auto &it : m_entries)
+    {
+        Entry *entry = it.second.get();
+        if (entry->m_refCount > 0)
+        {
+            std::cout << "ERROR - The asset " << entry->m_key
+                << " is still used by " << entry->m_refCount << " scene(s)" << std::endl;
+            assert(false);
+        }
+        Destroy(entry);
+    }
+}
+
+AssetCache::Entry *AssetCache::Acquire(Type type, const std::string &key)
+{
+    auto it = m_entries.find(std::make_pair(type, key));
+    if (it == m_entries.end())
+    {
+        m_stats.missCount++;
+        return nullptr;
+    }
+
+    Entry *entry = it->second.get();
+    if (entry->m_refCount == 0)
+    {
+        m_lru.erase(entry->m_lruIt);
+        m_unusedSize -= entry->m_size;
+    }
+    entry->m_refCount++;
+    m_stats.hitCount++;
+    return entry;
+}
+
+AssetCache::Entry *AssetCache::Insert(
+    Type type, const std::string &key, void *asset, size_t size,
+    SDL_IOStream *ioStream, void *ioStreamBuffer)
+{
+    assert(asset);
+    assert(m_entries.find(std::make_pair(type, key)) == m_entries.end());
+
+    std::unique_ptr<Entry> entry(new Entry());
+    entry->m_type = type;
+    entry->m_key = key;
+    entry->m_asset = asset;
+    entry->m_ioStream = ioStream;
+    entry->m_ioStreamBuffer = ioStreamBuffer;
+    entry->m_size = size;
+    entry->m_refCount = 1;
+
+    Entry *entryPtr = entry.get();
+    m_entries.emplace(std::make_pair(type, key), std::move(entry));
+    m_residentSize += size;
+
+    // Un nouvel asset peut faire dépasser le budget
+    Trim();
+    return entryPtr;
+}
+
+void AssetCache::Release(Entry *entry)
+{
+    if (entry == nullptr) return;
+    assert(entry->m_refCount > 0);
+
+    entry->m_refCount--;
+    if (entry->m_refCount > 0) return;
+
+    m_lru.push_front(entry);
+    entry->m_lruIt = m_lru.begin();
+    m_unusedSize += entry->m_size;
+    Trim();
+}
+
+void AssetCache::Clear()
+{
+    while (m_lru.empty() == false)
+    {
+        Entry *entry = m_lru.back();
+        m_lru.pop_back();
+        m_unusedSize -= entry->m_size;
+        m_residentSize -= entry->m_size;
+
+        Destroy(entry);
+        m_entries.erase(std::make_pair(entry->m_type, entry->m_key));
+    }
+}
+
+void AssetCache::SetBudget(size_t budget)
+{
+    m_budget = budget;
+    Trim();
+}
+
+void AssetCache::Trim()
+{
+    while (m_residentSize > m_budget && m_lru.empty() == false)
+    {
+        Entry *entry = m_lru.back();
+        m_lru.pop_back();
+        m_unusedSize -= entry->m_size;
+        m_residentSize -= entry->m_size;
+        m_stats.evictionCount++;
+
+        Destroy(entry);
+        m_entries.erase(std::make_pair(entry->m_type, entry->m_key));
+    }
+}
+
+void AssetCache::Destroy(Entry *entry)
+{
+    switch (entry->m_type)
+    {
+    case Type::TEXTURE:
+        SDL_DestroyTexture((SDL_Texture *)entry->m_asset);
+        break;
+    case Type::SPRITE_SHEET:
+        delete (SpriteSheet *)entry->m_asset;
+        break;
+    case Type::FONT:
+        TTF_CloseFont((TTF_Font *)entry->m_asset);
+        break;
+    case Type::SOUND:
+        Mix_FreeChunk((Mix_Chunk *)entry->m_asset);
+        break;
+    case Type::MUSIC:
+        Mix_FreeMusic((Mix_Music *)entry->m_asset);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+    AssetManager::DestroyIOStream(entry->m_ioStream, entry->m_ioStreamBuffer);
+
+    entry->m_asset = nullptr;
+    entry->m_ioStream = nullptr;
+    entry->m_ioStreamBuffer = nullptr;
+}
+
+size_t AssetCache::GetTextureSize(SDL_Texture *texture)
+{
+    if (texture == nullptr) return 0;
+
+    float w = 0.f, h = 0.f;
+    SDL_GetTextureSize(texture, &w, &h);
+    return (size_t)w * (size_t)h * 4;
+}
@@ -0,0 +1,204 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+class SpriteSheet;
+
+/// @brief Cache des assets partagé par toutes les scènes du processus.
+///
+/// Les gestionnaires de ressources (AssetManager) des scènes y cherchent
+/// leurs assets par chemin avant de les charger, et y ajoutent ceux qu'ils
+/// chargent. Chaque asset possède un compteur de références : une scène qui
+/// est détruite libère ses références, mais les assets restent en mémoire
+/// pour la scène suivante. Les assets qui ne sont plus référencés sont
+/// détruits du moins récemment utilisé au plus récent dès que la mémoire
+/// occupée dépasse le budget.
+///
+/// Les textures appartiennent au moteur de rendu du cache : le cache ne
+/// doit être utilisé que depuis le thread de rendu.
+class AssetCache
+{
+public:
+    enum class Type : Uint8
+    {
+        TEXTURE, SPRITE_SHEET, FONT, SOUND, MUSIC
+    };
+
+    /// @brief Asset présent dans le cache. Sert de poignée aux scènes.
+    class Entry
+    {
+    public:
+        Type GetType() const;
+        const std::string &GetKey() const;
+        size_t GetSize() const;
+        int GetRefCount() const;
+
+        SDL_Texture *GetTexture() const;
+        SpriteSheet *GetSpriteSheet() const;
+        TTF_Font *GetFont() const;
+        Mix_Chunk *GetSound() const;
+        Mix_Music *GetMusic() const;
+
+    private:
+        friend class AssetCache;
+
+        Entry();
+
+        Type m_type;
+        std::string m_key;
+        void *m_asset;
+        /// @brief Flux lus par la police ou la musique pendant toute leur durée de vie.
+        SDL_IOStream *m_ioStream;
+        void *m_ioStreamBuffer;
+        size_t m_size;
+        int m_refCount;
+        std::list<Entry *>::iterator m_lruIt;
+    };
+
+    struct Stats
+    {
+        Stats();
+
+        int hitCount;
+        int missCount;
+        int evictionCount;
+    };
+
+    /// @brief Budget mémoire par défaut (en octets).
+    static constexpr size_t DEFAULT_BUDGET = (size_t)256 << 20;
+
+    /// @param renderer le moteur de rendu des textures mises en cache.
+    AssetCache(SDL_Renderer *renderer, size_t budget = DEFAULT_BUDGET);
+    AssetCache(AssetCache const&) = delete;
+    AssetCache& operator=(AssetCache const&) = delete;
+    ~AssetCache();
+
+    /// @brief Cherche un asset et prend une référence dessus.
+    /// @return L'entrée ou nullptr si l'asset n'est pas dans le cache.
+    Entry *Acquire(Type type, const std::string &key);
+
+    /// @brief Ajoute un asset chargé par l'appelant, qui en prend une référence.
+    /// Le cache devient propriétaire de l'asset et de son flux.
+    /// @param size la mémoire occupée par l'asset (estimation en octets).
+    Entry *Insert(
+        Type type, const std::string &key, void *asset, size_t size,
+        SDL_IOStream *ioStream = nullptr, void *ioStreamBuffer = nullptr);
+
+    /// @brief Libère une référence. Un asset qui n'est plus référencé
+    /// reste en mémoire tant que le budget le permet.
+    void Release(Entry *entry);
+
+    /// @brief Détruit tous les assets qui ne sont plus référencés.
+    void Clear();
+
+    void SetBudget(size_t budget);
+    size_t GetBudget() const;
+    size_t GetResidentSize() const;
+    size_t GetUnusedSize() const;
+    int GetEntryCount() const;
+    const Stats &GetStats() const;
+    SDL_Renderer *GetRenderer() const;
+
+    /// @brief Estime la mémoire occupée par une texture (4 octets par pixel).
+    static size_t GetTextureSize(SDL_Texture *texture);
+
+private:
+    SDL_Renderer *m_renderer;
+    size_t m_budget;
+    size_t m_residentSize;
+    size_t m_unusedSize;
+    std::map<std::pair<Type, std::string>, std::unique_ptr<Entry>> m_entries;
+
+    /// @brief Assets non référencés, du plus récemment utilisé au plus ancien.
+    std::list<Entry *> m_lru;
+    Stats m_stats;
+
+    void Trim();
+    void Destroy(Entry *entry);
+};
+
+inline AssetCache::Type AssetCache::Entry::GetType() const
+{
+    return m_type;
+}
+
+inline const std::string &AssetCache::Entry::GetKey() const
+{
+    return m_key;
+}
+
+inline size_t AssetCache::Entry::GetSize() const
+{
+    return m_size;
+}
+
+inline int AssetCache::Entry::GetRefCount() const
+{
+    return m_refCount;
+}
+
+inline SDL_Texture *AssetCache::Entry::GetTexture() const
+{
+    assert(m_type == Type::TEXTURE);
+    return (SDL_Texture *)m_asset;
+}
+
+inline SpriteSheet *AssetCache::Entry::GetSpriteSheet() const
+{
+    assert(m_type == Type::SPRITE_SHEET);
+    return (SpriteSheet *)m_asset;
+}
+
+inline TTF_Font *AssetCache::Entry::GetFont() const
+{
+    assert(m_type == Type::FONT);
+    return (TTF_Font *)m_asset;
+}
+
+inline Mix_Chunk *AssetCache::Entry::GetSound() const
+{
+    assert(m_type == Type::SOUND);
+    return (Mix_Chunk *)m_asset;
+}
+
+inline Mix_Music *AssetCache::Entry::GetMusic() const
+{
+    assert(m_type == Type::MUSIC);
+    return (Mix_Music *)m_asset;
+}
+
+inline size_t AssetCache::GetBudget() const
+{
+    return m_budget;
+}
+
+inline size_t AssetCache::GetResidentSize() const
+{
+    return m_residentSize;
+}
+
+inline size_t AssetCache::GetUnusedSize() const
+{
+    return m_unusedSize;
+}
+
+inline int AssetCache::GetEntryCount() const
+{
+    return (int)m_entries.size();
+}
+
+inline const AssetCache::Stats &AssetCache::GetStats() const
+{
+    return m_stats;
+}
+
+inline SDL_Renderer *AssetCache::GetRenderer() const
+{
+    return m_renderer;
+}
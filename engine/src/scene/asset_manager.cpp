@@ -5,26 +5,54 @@
 */
 
 #include "scene/asset_manager.h"
+#include "scene/asset_pack.h"
+#include "scene/asset_stream.h"
+#include "utils/thread_pool.h"
+#include "utils/simd_math.h"
 #include "game_engine_common.h"
 #include "utils/utils.h"
 
+#include <latch>
+
 #ifndef AssertNew
 #define AssertNew(ptr) { if (ptr == NULL) { assert(false); abort(); } }
 #endif
 
-AssetManager::AssetManager()
+namespace
+{
+    /// Taille  partir de laquelle le dcodage est rparti sur plusieurs threads.
+    constexpr size_t PARALLEL_RETRIVE_SIZE = (size_t)1 << 20;
+    constexpr size_t MIN_RETRIVE_CHUNK_SIZE = (size_t)256 << 10;
+
+    ThreadPool &GetRetriveThreadPool()
+    {
+        // Cr au premier fichier volumineux, distinct du pool de
+        // LoadSpriteSheets() dont les tches peuvent dcoder des fichiers
+        static ThreadPool threadPool;
+        return threadPool;
+    }
+}
+
+AssetPack *AssetManager::s_assetPack = nullptr;
+
+AssetManager::AssetManager(SDL_Renderer *renderer, bool audioEnabled, AssetCache *cache)
     : m_sheetMap()
     , m_fontMap()
     , m_soundMap()
     , m_musicMap()
     , m_textureMap()
-    , m_sfxChannels()
-    , m_sfxIndex(0)
+    , m_glyphAtlasMap()
+    , m_glyphAtlasUseCount(0)
+    , m_fontScale(0.f)
+    , m_fontGeneration(0)
+    , m_soundMixer(audioEnabled)
+    , m_renderer(renderer)
+    , m_audioEnabled(audioEnabled)
+    , m_cache((cache && renderer && cache->GetRenderer() == renderer) ? cache : nullptr)
+    , m_loadRecords()
+    , m_loadTimeNS(0)
 {
-    for (int i = 4; i < 8; i++)
-    {
-        m_sfxChannels.push_back(i);
-    }
+    m_soundMixer.SetChannels(4, 7);
 }
 
 AssetManager::~AssetManager()
@@ -68,7 +96,7 @@ void AssetManager::AddSpriteSheet(int sheetID, const std::string &assetsPath, co
         return;
     }
 
-    m_sheetMap.insert(std::make_pair(sheetID, new SheetData(path, pixelArt)));
+    m_sheetMap.insert(std::make_pair(sheetID, new SheetData(path, pixelArt, m_cache)));
 }
 
 void AssetManager::AddFont(int fontID, const std::string &assetsPath, const std::string &fileName, float size)
@@ -83,7 +111,20 @@ void AssetManager::AddFont(int fontID, const std::string &assetsPath, const std:
         return;
     }
 
-    m_fontMap.insert(std::make_pair(fontID, new FontData(path, size)));
+    // Sans moteur de rendu, aucun texte n'est affich
+    if (m_renderer == nullptr) return;
+
+    FontData *fontData = new FontData(path, size, m_cache);
+    m_fontMap.insert(std::make_pair(fontID, fontData));
+
+    if (m_fontScale > 0.f)
+    {
+        const float pixelSize = std::max(1.f, roundf(size * m_fontScale));
+        if (TTF_GetFontSize(fontData->GetFont()) != pixelSize)
+        {
+            TTF_SetFontSize(fontData->GetFont(), pixelSize);
+        }
+    }
 }
 
 void AssetManager::AddSound(int soundID, const std::string &assetsPath, const std::string &fileName)
@@ -98,7 +139,9 @@ void AssetManager::AddSound(int soundID, const std::string &assetsPath, const st
         return;
     }
 
-    m_soundMap.insert(std::make_pair(soundID, new SoundData(path)));
+    if (m_audioEnabled == false) return;
+
+    m_soundMap.insert(std::make_pair(soundID, new SoundData(path, m_cache)));
 }
 
 void AssetManager::AddMusic(int musicID, const std::string &assetsPath, const std::string &fileName)
@@ -113,7 +156,9 @@ void AssetManager::AddMusic(int musicID, const std::string &assetsPath, const st
         return;
     }
 
-    m_musicMap.insert(std::make_pair(musicID, new MusicData(path)));
+    if (m_audioEnabled == false) return;
+
+    m_musicMap.insert(std::make_pair(musicID, new MusicData(path, m_cache)));
 }
 
 void AssetManager::AddTexture(int textureID, const std::string &assetsPath, const std::string &fileName, bool pixelArt)
@@ -128,17 +173,105 @@ void AssetManager::AddTexture(int textureID, const std::string &assetsPath, cons
         return;
     }
 
-    m_textureMap.insert(std::make_pair(textureID, new TextureData(path, pixelArt)));
+    m_textureMap.insert(std::make_pair(textureID, new TextureData(path, pixelArt, m_cache)));
 }
 
-int AssetManager::LoadSpriteSheets(const std::vector<int> &sheetIDs)
+int AssetManager::LoadSpriteSheets(const std::vector<int> &sheetIDs, LoadingCallback callback)
 {
+    const Uint64 startNS = SDL_GetTicksNS();
+
     int exitStatus = EXIT_SUCCESS;
+    std::vector<SheetData *> sheets;
     for (int sheetID : sheetIDs)
     {
-        SpriteSheet *spriteSheet = GetSpriteSheet(sheetID);
-        if (spriteSheet == nullptr) exitStatus = EXIT_FAILURE;
+        auto it = m_sheetMap.find(sheetID);
+        if (it == m_sheetMap.end())
+        {
+            exitStatus = EXIT_FAILURE;
+            continue;
+        }
+        SheetData *sheetData = it->second;
+        if (sheetData->IsLoaded()) continue;
+        if (std::find(sheets.begin(), sheets.end(), sheetData) != sheets.end()) continue;
+
+        // Dj charge par une autre scne
+        if (sheetData->AcquireFromCache()) continue;
+
+        sheets.push_back(sheetData);
     }
+
+    const int totalCount = (int)sheets.size();
+    if (totalCount == 0) return exitStatus;
+
+    struct DecodedSheet
+    {
+        int index;
+        SpriteSheet *sheet;
+        Uint64 decodeNS;
+    };
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<DecodedSheet> decodedSheets;
+
+    const bool loadImage = (m_renderer != nullptr);
+    auto decode = [&](int index)
+    {
+        const Uint64 decodeStartNS = SDL_GetTicksNS();
+        SpriteSheet *sheet = new SpriteSheet(sheets[index]->GetPath(), loadImage);
+        DecodedSheet decoded = { index, sheet, SDL_GetTicksNS() - decodeStartNS };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decodedSheets.push_back(decoded);
+        }
+        condition.notify_one();
+    };
+
+    // Sans moteur de rendu, seule la gomtrie est lue : elle est rapide 
+    // charger et les matchs sans rendu sont dj excuts en parallle.
+    std::unique_ptr<ThreadPool> threadPool;
+    if (loadImage && totalCount > 1)
+    {
+        threadPool = std::make_unique<ThreadPool>(
+            std::min(totalCount, (int)std::thread::hardware_concurrency()));
+        for (int i = 0; i < totalCount; i++)
+        {
+            threadPool->Submit([&decode, i]() { decode(i); });
+        }
+    }
+    else
+    {
+        for (int i = 0; i < totalCount; i++) decode(i);
+    }
+
+    // Cre les textures dans l'ordre de fin du dcodage
+    LoadingProgress progress = { 0, totalCount, std::string() };
+    for (int loadedCount = 1; loadedCount <= totalCount; loadedCount++)
+    {
+        DecodedSheet decoded = { 0 };
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&decodedSheets]() { return decodedSheets.empty() == false; });
+            decoded = decodedSheets.front();
+            decodedSheets.pop_front();
+        }
+
+        const Uint64 uploadStartNS = SDL_GetTicksNS();
+        SheetData *sheetData = sheets[decoded.index];
+        sheetData->SetSpriteSheet(m_renderer, decoded.sheet);
+
+        LoadRecord record = { sheetData->GetPath(), decoded.decodeNS, SDL_GetTicksNS() - uploadStartNS };
+        m_loadRecords.push_back(record);
+
+        if (callback)
+        {
+            progress.loadedCount = loadedCount;
+            progress.path = record.path;
+            callback(progress);
+        }
+    }
+    threadPool.reset();
+
+    m_loadTimeNS += SDL_GetTicksNS() - startNS;
     return exitStatus;
 }
 
@@ -147,7 +280,7 @@ SDL_Texture *AssetManager::GetTexture(int textureID)
     auto it = m_textureMap.find(textureID);
     if (it != m_textureMap.end())
     {
-        return it->second->GetTexture();
+        return it->second->GetTexture(m_renderer);
     }
     return nullptr;
 }
@@ -157,7 +290,7 @@ SpriteSheet *AssetManager::GetSpriteSheet(int sheetID)
     auto it = m_sheetMap.find(sheetID);
     if (it != m_sheetMap.end())
     {
-        return it->second->GetSpriteSheet();
+        return it->second->GetSpriteSheet(m_renderer);
     }
     return nullptr;
 }
@@ -172,6 +305,88 @@ TTF_Font *AssetManager::GetFont(int fontID)
     return nullptr;
 }
 
+GlyphAtlas *AssetManager::GetGlyphAtlas(int fontID)
+{
+    if (m_renderer == nullptr) return nullptr;
+
+    TTF_Font *font = GetFont(fontID);
+    if (font == nullptr) return nullptr;
+
+    const int pixelSize = (int)roundf(TTF_GetFontSize(font));
+    auto it = m_glyphAtlasMap.find(std::make_pair(font, pixelSize));
+    m_glyphAtlasUseCount++;
+    if (it != m_glyphAtlasMap.end())
+    {
+        it->second.lastUse = m_glyphAtlasUseCount;
+        return it->second.atlas.get();
+    }
+
+    // Supprime les atlas de cette police utiliss le moins rcemment
+    // au-del de GLYPH_ATLAS_SIZE_COUNT tailles
+    auto first = m_glyphAtlasMap.lower_bound(std::make_pair(font, INT_MIN));
+    auto last = m_glyphAtlasMap.upper_bound(std::make_pair(font, INT_MAX));
+    while (std::distance(first, last) >= GLYPH_ATLAS_SIZE_COUNT)
+    {
+        auto oldest = first;
+        for (auto curr = first; curr != last; ++curr)
+        {
+            if (curr->second.lastUse < oldest->second.lastUse) oldest = curr;
+        }
+        if (oldest == first) first = m_glyphAtlasMap.erase(oldest);
+        else m_glyphAtlasMap.erase(oldest);
+    }
+
+    GlyphAtlasEntry &entry = m_glyphAtlasMap[std::make_pair(font, pixelSize)];
+    entry.atlas = std::make_unique<GlyphAtlas>(m_renderer, font);
+    entry.lastUse = m_glyphAtlasUseCount;
+    return entry.atlas.get();
+}
+
+bool AssetManager::SetFontScale(float scale)
+{
+    if (scale <= 0.f || scale == m_fontScale) return false;
+    m_fontScale = scale;
+    m_fontGeneration++;
+
+    for (auto it = m_fontMap.begin(); it != m_fontMap.end(); ++it)
+    {
+        FontData *fontData = it->second;
+        TTF_Font *font = fontData->GetFont();
+        if (font == nullptr) continue;
+
+        // Une police du cache peut dj avoir t redimensionne par un autre identifiant
+        const float pixelSize = std::max(1.f, roundf(fontData->m_size * scale));
+        if (TTF_GetFontSize(font) == pixelSize) continue;
+
+        TTF_SetFontSize(font, pixelSize);
+    }
+    return true;
+}
+
+void AssetManager::PrewarmFonts(TTF_TextEngine *textEngine, const char *charset)
+{
+    for (auto it = m_fontMap.begin(); it != m_fontMap.end(); ++it)
+    {
+        TTF_Font *font = it->second->GetFont();
+        if (font == nullptr) continue;
+
+        GetGlyphAtlas(it->first);
+        if (textEngine == nullptr) continue;
+
+        // Les glyphes restent dans l'atlas du moteur aprs la destruction du texte
+        TTF_Text *text = TTF_CreateText(textEngine, font, charset, 0);
+        if (text == nullptr)
+        {
+            std::cout
+                << "ERROR - Prewarm font " << it->second->m_path << std::endl
+                << "      - " << SDL_GetError() << std::endl;
+            continue;
+        }
+        TTF_UpdateText(text);
+        TTF_DestroyText(text);
+    }
+}
+
 float AssetManager::GetFontInitialSize(int fontID) const
 {
     auto it = m_fontMap.find(fontID);
@@ -204,16 +419,13 @@ Mix_Music *AssetManager::GetMusic(int musicID)
 
 void AssetManager::InitSoundFXChannels(int startID, int endID)
 {
-    m_sfxChannels.clear();
-    for (int i = startID; i <= endID; i++)
-    {
-        m_sfxChannels.push_back(i);
-    }
-    m_sfxIndex = 0;
+    m_soundMixer.SetChannels(startID, endID);
 }
 
 void AssetManager::SetSoundVolume(int soundID, float volume)
 {
+    if (m_audioEnabled == false) return;
+
     volume = math::Clamp(volume, 0.f, 1.f);
     Mix_Chunk *chunk = GetSound(soundID);
     if (chunk == nullptr)
@@ -227,24 +439,36 @@ void AssetManager::SetSoundVolume(int soundID, float volume)
 
 void AssetManager::SetMusicVolume(float volume)
 {
+    if (m_audioEnabled == false) return;
+
     volume = math::Clamp(volume, 0.f, 1.f);
     Mix_VolumeMusic((int)(volume * MIX_MAX_VOLUME));
 }
 
 void AssetManager::SetSoundFXVolume(float volume)
 {
+    if (m_audioEnabled == false) return;
+
     volume = math::Clamp(volume, 0.f, 1.f);
     int v = (int)(volume * MIX_MAX_VOLUME);
-    for (int channel : m_sfxChannels)
+    for (int i = 0; i < m_soundMixer.GetVoiceCount(); i++)
     {
-        Mix_Volume(channel, v);
+        Mix_Volume(m_soundMixer.GetChannel(i), v);
     }
 }
 
 void AssetManager::PlaySoundFX(int soundID, int loop)
 {
-    assert(m_sfxChannels.size() > 0);
-    assert(m_sfxIndex < m_sfxChannels.size());
+    SoundParams params;
+    params.loops = loop;
+    PlaySoundFX(soundID, params);
+}
+
+void AssetManager::PlaySoundFX(int soundID, const SoundParams &params)
+{
+    if (m_audioEnabled == false) return;
+
+    assert(m_soundMixer.GetVoiceCount() > 0);
 
     Mix_Chunk *chunk = GetSound(soundID);
     if (chunk == nullptr)
@@ -253,14 +477,13 @@ void AssetManager::PlaySoundFX(int soundID, int loop)
         return;
     }
 
-    int channelID = m_sfxChannels[m_sfxIndex];
-    int exitStatus = Mix_PlayChannel(channelID, chunk, loop);
-
-    m_sfxIndex = ((size_t)m_sfxIndex + 1) % m_sfxChannels.size();
+    m_soundMixer.Play(soundID, chunk, params);
 }
 
 void AssetManager::PlaySound(int soundID, int channelID, int loops)
 {
+    if (m_audioEnabled == false) return;
+
     Mix_Chunk *chunk = GetSound(soundID);
     if (chunk == nullptr)
     {
@@ -273,6 +496,8 @@ void AssetManager::PlaySound(int soundID, int channelID, int loops)
 
 void AssetManager::PlayMusic(int musicID, int loops)
 {
+    if (m_audioEnabled == false) return;
+
     Mix_Music *music = GetMusic(musicID);
     if (music == nullptr)
     {
@@ -286,6 +511,8 @@ void AssetManager::PlayMusic(int musicID, int loops)
 
 void AssetManager::FadeInMusic(int musicID, int loops, int ms, double position)
 {
+    if (m_audioEnabled == false) return;
+
     Mix_Music *music = GetMusic(musicID);
     if (music == nullptr)
     {
@@ -299,11 +526,24 @@ void AssetManager::FadeInMusic(int musicID, int loops, int ms, double position)
 
 void AssetManager::FadeOutMusic(int ms)
 {
+    if (m_audioEnabled == false) return;
+
     Mix_FadeOutMusic(ms);
 }
 
 void AssetManager::CreateIOStream(const std::string &path, SDL_IOStream **ioStream, void **buffer)
 {
+    if (s_assetPack)
+    {
+        // Lecture sans copie dans l'archive, sinon dans le fichier
+        *ioStream = s_assetPack->OpenIOStream(path);
+        if (*ioStream)
+        {
+            *buffer = nullptr;
+            return;
+        }
+    }
+
     FILE *file = fopen(path.c_str(), "rb");
     if (file == nullptr)
     {
@@ -365,25 +605,60 @@ void AssetManager::ObfuscateMem(void *memory, size_t size)
 void AssetManager::RetriveMem(void *memory, size_t size)
 {
     Uint8 *buffer = (Uint8 *)memory;
-    for (size_t i = size - 1; i > 0; i--)
+    if (size < PARALLEL_RETRIVE_SIZE)
     {
-        buffer[i] = 0x73 * (buffer[i] + 0x37);
-        buffer[i] ^= buffer[i - 1];
+        simd::RetriveBytes(buffer, size, 0x73);
+        return;
     }
-    buffer[0] = 0x73 * (buffer[0] + 0x37);
-    buffer[0] ^= 0x73;
+
+    ThreadPool &threadPool = GetRetriveThreadPool();
+    const size_t chunkCount = std::min(
+        (size_t)threadPool.GetThreadCount() + 1, size / MIN_RETRIVE_CHUNK_SIZE);
+    const size_t chunkSize = (size + chunkCount - 1) / chunkCount;
+
+    // Les octets qui prcdent chaque morceau sont lus avant que
+    // le morceau prcdent ne soit dcod par un autre thread
+    std::vector<Uint8> prevBytes(chunkCount);
+    prevBytes[0] = 0x73;
+    for (size_t i = 1; i < chunkCount; i++)
+    {
+        prevBytes[i] = buffer[i * chunkSize - 1];
+    }
+
+    std::latch done((ptrdiff_t)chunkCount - 1);
+    for (size_t i = 1; i < chunkCount; i++)
+    {
+        const size_t begin = i * chunkSize;
+        const size_t end = std::min(size, begin + chunkSize);
+        threadPool.Submit([&, i, begin, end]()
+        {
+            simd::RetriveBytes(buffer + begin, end - begin, prevBytes[i]);
+            done.count_down();
+        });
+    }
+
+    // Le thread appelant dcode le premier morceau
+    simd::RetriveBytes(buffer, chunkSize, prevBytes[0]);
+    done.wait();
 }
 
-AssetManager::MusicData::MusicData(const std::string &path)
+AssetManager::MusicData::MusicData(const std::string &path, AssetCache *cache)
     : m_path(path)
     , m_music(nullptr)
     , m_ioStream(nullptr)
     , m_ioStreamBuffer(nullptr)
+    , m_cache(cache)
+    , m_cacheEntry(nullptr)
 {
 }
 
 AssetManager::MusicData::~MusicData()
 {
+    if (m_cacheEntry)
+    {
+        m_cache->Release(m_cacheEntry);
+        return;
+    }
     if (m_music) Mix_FreeMusic(m_music);
     DestroyIOStream(m_ioStream, m_ioStreamBuffer);
 }
@@ -392,7 +667,22 @@ Mix_Music *AssetManager::MusicData::GetMusic()
 {
     if (m_music != nullptr) return m_music;
 
-    CreateIOStream(m_path, &m_ioStream, &m_ioStreamBuffer);
+    if (m_cache && (m_cacheEntry = m_cache->Acquire(AssetCache::Type::MUSIC, m_path)))
+    {
+        m_music = m_cacheEntry->GetMusic();
+        return m_music;
+    }
+
+    // La musique est lue et dcode par blocs pendant sa lecture,
+    // le fichier n'est jamais charg en entier
+    m_ioStream = AssetStream::Open(m_path);
+    m_ioStreamBuffer = nullptr;
+    if (m_ioStream == nullptr)
+    {
+        assert(false);
+        abort();
+    }
+
     m_music = Mix_LoadMUS_IO(m_ioStream, 0);
     if (m_music == NULL)
     {
@@ -403,17 +693,37 @@ Mix_Music *AssetManager::MusicData::GetMusic()
         abort();
     }
 
+    if (m_cache)
+    {
+        // Le cache devient propritaire de la musique et de son flux
+        m_cacheEntry = m_cache->Insert(
+            AssetCache::Type::MUSIC, m_path, m_music, AssetStream::BUFFER_SIZE,
+            m_ioStream, m_ioStreamBuffer);
+        m_ioStream = nullptr;
+        m_ioStreamBuffer = nullptr;
+    }
     return m_music;
 }
 
-AssetManager::FontData::FontData(const std::string &path, float size)
+AssetManager::FontData::FontData(const std::string &path, float size, AssetCache *cache)
     : m_path(path)
     , m_font(nullptr)
     , m_size(size)
     , m_ioStream(nullptr)
     , m_ioStreamBuffer(nullptr)
+    , m_cache(cache)
+    , m_cacheEntry(nullptr)
 {
+    // Une mme police peut tre utilise avec plusieurs tailles
+    const std::string key = m_path + "@" + std::to_string(size);
+    if (m_cache && (m_cacheEntry = m_cache->Acquire(AssetCache::Type::FONT, key)))
+    {
+        m_font = m_cacheEntry->GetFont();
+        return;
+    }
+
     CreateIOStream(m_path, &m_ioStream, &m_ioStreamBuffer);
+    const Sint64 fileSize = SDL_GetIOSize(m_ioStream);
     m_font = TTF_OpenFontIO(m_ioStream, false, size);
     if (m_font == NULL)
     {
@@ -423,10 +733,24 @@ AssetManager::FontData::FontData(const std::string &path, float size)
         assert(false);
         abort();
     }
+
+    if (m_cache)
+    {
+        m_cacheEntry = m_cache->Insert(
+            AssetCache::Type::FONT, key, m_font, (size_t)std::max<Sint64>(fileSize, 0),
+            m_ioStream, m_ioStreamBuffer);
+        m_ioStream = nullptr;
+        m_ioStreamBuffer = nullptr;
+    }
 }
 
 AssetManager::FontData::~FontData()
 {
+    if (m_cacheEntry)
+    {
+        m_cache->Release(m_cacheEntry);
+        return;
+    }
     if (m_font) TTF_CloseFont(m_font);
     DestroyIOStream(m_ioStream, m_ioStreamBuffer);
 }
@@ -436,9 +760,17 @@ TTF_Font *AssetManager::FontData::GetFont()
     return m_font;
 }
 
-AssetManager::SoundData::SoundData(const std::string &path) :
-    m_chunk(nullptr)
+AssetManager::SoundData::SoundData(const std::string &path, AssetCache *cache)
+    : m_chunk(nullptr)
+    , m_cache(cache)
+    , m_cacheEntry(nullptr)
 {
+    if (m_cache && (m_cacheEntry = m_cache->Acquire(AssetCache::Type::SOUND, path)))
+    {
+        m_chunk = m_cacheEntry->GetSound();
+        return;
+    }
+
     void *ioStreamBuffer = nullptr;
     SDL_IOStream *ioStream = nullptr;
     CreateIOStream(path, &ioStream, &ioStreamBuffer);
@@ -454,10 +786,20 @@ AssetManager::SoundData::SoundData(const std::string &path) :
     }
 
     DestroyIOStream(ioStream, ioStreamBuffer);
+
+    if (m_cache)
+    {
+        m_cacheEntry = m_cache->Insert(AssetCache::Type::SOUND, path, m_chunk, m_chunk->alen);
+    }
 }
 
 AssetManager::SoundData::~SoundData()
 {
+    if (m_cacheEntry)
+    {
+        m_cache->Release(m_cacheEntry);
+        return;
+    }
     if (m_chunk) Mix_FreeChunk(m_chunk);
 }
 
@@ -466,53 +808,106 @@ Mix_Chunk *AssetManager::SoundData::GetSound()
     return m_chunk;
 }
 
-AssetManager::SheetData::SheetData(const std::string &path, bool pixelArt)
+AssetManager::SheetData::SheetData(const std::string &path, bool pixelArt, AssetCache *cache)
     : m_path(path)
     , m_sheet(nullptr)
     , m_pixelArt(pixelArt)
+    , m_cache(cache)
+    , m_cacheEntry(nullptr)
 {
 }
 
 AssetManager::SheetData::~SheetData()
 {
+    if (m_cacheEntry)
+    {
+        m_cache->Release(m_cacheEntry);
+        return;
+    }
     if (m_sheet) delete m_sheet;
 }
 
-SpriteSheet *AssetManager::SheetData::GetSpriteSheet()
+SpriteSheet *AssetManager::SheetData::GetSpriteSheet(SDL_Renderer *renderer)
 {
     if (m_sheet) return m_sheet;
+    if (AcquireFromCache()) return m_sheet;
+
+    SetSpriteSheet(renderer, new SpriteSheet(m_path, renderer != nullptr));
+    return m_sheet;
+}
+
+bool AssetManager::SheetData::AcquireFromCache()
+{
+    if (m_cache == nullptr || m_sheet) return false;
 
-    m_sheet = new SpriteSheet(g_renderer, m_path);
+    m_cacheEntry = m_cache->Acquire(AssetCache::Type::SPRITE_SHEET, m_path);
+    if (m_cacheEntry == nullptr) return false;
 
+    m_sheet = m_cacheEntry->GetSpriteSheet();
+    return true;
+}
+
+void AssetManager::SheetData::SetSpriteSheet(SDL_Renderer *renderer, SpriteSheet *sheet)
+{
+    assert(m_sheet == nullptr);
+    if (AcquireFromCache())
+    {
+        // Le mme fichier a t dcod pour un autre identifiant
+        delete sheet;
+        return;
+    }
+    m_sheet = sheet;
+    if (renderer == nullptr) return;
+
+    m_sheet->CreateTexture(renderer);
     if (m_pixelArt)
     {
         SDL_Texture *texture = m_sheet->GetTexture();
         SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
     }
-    return m_sheet;
+
+    if (m_cache)
+    {
+        const size_t size = AssetCache::GetTextureSize(m_sheet->GetTexture());
+        m_cacheEntry = m_cache->Insert(AssetCache::Type::SPRITE_SHEET, m_path, m_sheet, size);
+    }
 }
 
-AssetManager::TextureData::TextureData(const std::string &path, bool pixelArt)
+AssetManager::TextureData::TextureData(const std::string &path, bool pixelArt, AssetCache *cache)
     : m_path(path)
     , m_texture(nullptr)
     , m_pixelArt(pixelArt)
+    , m_cache(cache)
+    , m_cacheEntry(nullptr)
 {
 }
 
 AssetManager::TextureData::~TextureData()
 {
+    if (m_cacheEntry)
+    {
+        m_cache->Release(m_cacheEntry);
+        return;
+    }
     if (m_texture) SDL_DestroyTexture(m_texture);
 }
 
-SDL_Texture *AssetManager::TextureData::GetTexture()
+SDL_Texture *AssetManager::TextureData::GetTexture(SDL_Renderer *renderer)
 {
     if (m_texture) return m_texture;
+    if (renderer == nullptr) return nullptr;
+
+    if (m_cache && (m_cacheEntry = m_cache->Acquire(AssetCache::Type::TEXTURE, m_path)))
+    {
+        m_texture = m_cacheEntry->GetTexture();
+        return m_texture;
+    }
 
     void *ioStreamBuffer = NULL;
     SDL_IOStream *ioStream = NULL;
     CreateIOStream(m_path, &ioStream, &ioStreamBuffer);
 
-    SDL_Texture *m_texture = IMG_LoadTexture_IO(g_renderer, ioStream, 0);
+    m_texture = IMG_LoadTexture_IO(renderer, ioStream, 0);
     if (m_texture == NULL)
     {
         std::cout
@@ -529,5 +924,10 @@ SDL_Texture *AssetManager::TextureData::GetTexture()
 
     DestroyIOStream(ioStream, ioStreamBuffer);
 
+    if (m_cache)
+    {
+        const size_t size = AssetCache::GetTextureSize(m_texture);
+        m_cacheEntry = m_cache->Insert(AssetCache::Type::TEXTURE, m_path, m_texture, size);
+    }
     return m_texture;
 }
@@ -9,12 +9,49 @@
 #include "game_engine_settings.h"
 #include "game_engine_common.h"
 #include "rendering/sprite_sheet.h"
+#include "rendering/glyph_atlas.h"
+#include "scene/asset_cache.h"
+#include "scene/sound_mixer.h"
 #include "utils/color.h"
 
+class AssetPack;
+
 class AssetManager
 {
 public:
-    AssetManager();
+    /// @brief Caractères préchargés par défaut dans les caches de glyphes.
+    static constexpr const char *PREWARM_CHARSET =
+        " !%'()+,-./0123456789:;?ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    static constexpr int GLYPH_ATLAS_SIZE_COUNT = 2;
+
+    /// @brief Avancement d'un chargement, transmis à l'écran de chargement.
+    struct LoadingProgress
+    {
+        int loadedCount;
+        int totalCount;
+        /// @brief Chemin du dernier asset chargé.
+        std::string path;
+    };
+    using LoadingCallback = std::function<void(const LoadingProgress &progress)>;
+
+    /// @brief Temps de chargement d'un asset.
+    struct LoadRecord
+    {
+        std::string path;
+        /// @brief Lecture, décodage du JSON et de l'image (thread de travail).
+        Uint64 decodeNS;
+        /// @brief Création de la texture (thread de rendu).
+        Uint64 uploadNS;
+    };
+
+    /// @brief Crée le gestionnaire des ressources d'une scène.
+    /// @param renderer le moteur de rendu des textures. S'il est nul, les textures
+    /// et les polices ne sont pas chargées ; seule la géométrie des sprite sheets l'est.
+    /// @param audioEnabled indique si les sons et les musiques sont chargés et joués.
+    /// @param cache le cache partagé entre les scènes, utilisé uniquement s'il
+    /// appartient au même moteur de rendu. Sans cache, les assets de la scène
+    /// sont détruits avec elle.
+    AssetManager(SDL_Renderer *renderer, bool audioEnabled, AssetCache *cache = nullptr);
     AssetManager(AssetManager const&) = delete;
     AssetManager& operator=(AssetManager const&) = delete;
     ~AssetManager();
@@ -25,36 +62,95 @@ public:
     void AddSound(int soundID, const std::string &assetsPath, const std::string &fileName);
     void AddMusic(int musicID, const std::string &assetsPath, const std::string &fileName);
 
-    int LoadSpriteSheets(const std::vector<int> &sheetIDs);
+    /// @brief Charge des sprite sheets en parallèle.
+    /// Les fichiers JSON et les images sont décodés par un ensemble de threads ;
+    /// seules les textures sont créées sur le thread appelant, au fur et à mesure.
+    /// Sans moteur de rendu, seule la géométrie est chargée, sur le thread appelant.
+    /// @param sheetIDs les identifiants des sprite sheets. Celles déjà chargées sont ignorées.
+    /// @param callback fonction appelée sur le thread appelant après chaque sprite sheet.
+    /// @return EXIT_FAILURE si un identifiant est inconnu.
+    int LoadSpriteSheets(const std::vector<int> &sheetIDs, LoadingCallback callback = nullptr);
+
+    /// @brief Renvoie le temps de chargement de chaque asset chargé par LoadSpriteSheets().
+    const std::vector<LoadRecord> &GetLoadRecords() const;
+    /// @brief Renvoie le temps total passé dans LoadSpriteSheets().
+    Uint64 GetLoadTimeNS() const;
 
     SDL_Texture *GetTexture(int textureID);
     SpriteSheet *GetSpriteSheet(int sheetID);
     TTF_Font *GetFont(int fontID);
+
+    /// @brief Renvoie l'atlas des chiffres d'une police (voir GlyphAtlas).
+    /// Les atlas sont partagés par police SDL_ttf et par taille en pixels :
+    /// deux identifiants qui utilisent la même police partagent le même atlas,
+    /// et les GLYPH_ATLAS_SIZE_COUNT tailles de chaque police utilisées le plus
+    /// récemment sont conservées pour les changements de taille de la fenêtre.
+    /// @return L'atlas ou nullptr sans moteur de rendu ou si la police est inconnue.
+    GlyphAtlas *GetGlyphAtlas(int fontID);
     Mix_Chunk *GetSound(int soundID);
     Mix_Music *GetMusic(int musicID);
 
     float GetFontInitialSize(int fontID) const;
+
+    /// @brief Adapte la taille des polices à l'échelle de l'affichage.
+    /// Chaque police prend sa taille initiale multipliée par `scale`, arrondie
+    /// au pixel. TTF_SetFontSize() vide les caches de glyphes de SDL_ttf, il
+    /// n'est donc appelé que pour les polices dont la taille en pixels change.
+    /// @return false si l'échelle n'a pas changé depuis le dernier appel.
+    bool SetFontScale(float scale);
+    float GetFontScale() const;
+
+    /// @brief Renvoie un compteur incrémenté à chaque changement d'échelle des
+    /// polices. Un atlas obtenu avec GetGlyphAtlas() reste valide tant que ce
+    /// compteur ne change pas ; il peut ensuite être supprimé par le cache.
+    Uint32 GetFontGeneration() const;
+
+    /// @brief Précharge les glyphes courants des polices à leur taille actuelle,
+    /// dans les atlas de GetGlyphAtlas() et dans le cache du moteur de texte.
+    /// @param textEngine le moteur de texte des UIText, peut être nul.
+    /// @param charset les caractères à précharger (UTF-8).
+    void PrewarmFonts(TTF_TextEngine *textEngine, const char *charset = PREWARM_CHARSET);
     void InitSoundFXChannels(int startID, int endID);
     void SetSoundVolume(int soundID, float volume);
     void SetMusicVolume(float volume);
     void SetSoundFXVolume(float volume);
     void PlaySoundFX(int soundID, int loop = 0);
+
+    /// @brief Joue un effet sonore sur une voix du mixeur (voir SoundMixer).
+    /// Le son est joué au prochain SoundMixer::Flush(), appelé par la scène
+    /// à la fin de chaque pas fixe et de chaque frame.
+    void PlaySoundFX(int soundID, const SoundParams &params);
+    SoundMixer *GetSoundMixer();
     void PlaySound(int soundID, int channelID, int loops = 0);
     void PlayMusic(int musicID, int loops = -1);
     void FadeInMusic(int musicID, int loops = -1, int ms = 500, double position = 0.0);
     void FadeOutMusic(int ms = 500);
 
+    /// @brief Crée un IOStream sur le contenu décodé d'un fichier.
+    /// Si une archive est définie et contient le fichier, l'IOStream pointe
+    /// directement dans l'archive et le buffer renvoyé est nul.
+    /// Sinon, le fichier est lu dans un buffer alloué.
     static void CreateIOStream(const std::string &path, SDL_IOStream **ioStream, void **buffer);
     static void DestroyIOStream(SDL_IOStream *ioStream, void *buffer);
 
     static void ObfuscateMem(void *memory, size_t size);
+
+    /// @brief Décode sur place des données obfusquées avec ObfuscateMem().
+    /// Le décodage est vectorisé (voir simd::RetriveBytes()) et les
+    /// fichiers volumineux sont découpés en morceaux décodés en parallèle.
     static void RetriveMem(void *memory, size_t size);
 
+    /// @brief Définit l'archive dans laquelle les fichiers sont cherchés en priorité.
+    /// L'archive doit rester ouverte tant que des assets chargés l'utilisent.
+    /// @param assetPack l'archive ou nullptr pour ne lire que des fichiers.
+    static void SetAssetPack(AssetPack *assetPack);
+    static AssetPack *GetAssetPack();
+
 private:
     class MusicData
     {
     public:
-        MusicData(const std::string &path);
+        MusicData(const std::string &path, AssetCache *cache);
         ~MusicData();
 
         Mix_Music *GetMusic();
@@ -64,12 +160,14 @@ private:
         Mix_Music *m_music;
         SDL_IOStream *m_ioStream;
         void *m_ioStreamBuffer;
+        AssetCache *m_cache;
+        AssetCache::Entry *m_cacheEntry;
     };
 
     class FontData
     {
     public:
-        FontData(const std::string &path, float size);
+        FontData(const std::string &path, float size, AssetCache *cache);
         ~FontData();
 
         TTF_Font *GetFont();
@@ -79,49 +177,64 @@ private:
         float m_size;
         SDL_IOStream *m_ioStream;
         void *m_ioStreamBuffer;
+        AssetCache *m_cache;
+        AssetCache::Entry *m_cacheEntry;
     };
 
     class SoundData
     {
 
     public:
-        SoundData(const std::string &path);
+        SoundData(const std::string &path, AssetCache *cache);
         ~SoundData();
 
         Mix_Chunk *GetSound();
 
     private:
         Mix_Chunk *m_chunk;
+        AssetCache *m_cache;
+        AssetCache::Entry *m_cacheEntry;
     };
 
     class SheetData
     {
 
     public:
-        SheetData(const std::string &path, bool pixelArt);
+        SheetData(const std::string &path, bool pixelArt, AssetCache *cache);
         ~SheetData();
 
-        SpriteSheet *GetSpriteSheet();
+        SpriteSheet *GetSpriteSheet(SDL_Renderer *renderer);
+
+        /// @brief Associe une sprite sheet décodée et crée sa texture.
+        void SetSpriteSheet(SDL_Renderer *renderer, SpriteSheet *sheet);
+        /// @brief Reprend la sprite sheet du cache si elle y est.
+        bool AcquireFromCache();
+        bool IsLoaded() const;
+        const std::string &GetPath() const;
 
     private:
         SpriteSheet *m_sheet;
         std::string m_path;
         bool m_pixelArt;
+        AssetCache *m_cache;
+        AssetCache::Entry *m_cacheEntry;
     };
 
     class TextureData
     {
 
     public:
-        TextureData(const std::string &path, bool pixelArt);
+        TextureData(const std::string &path, bool pixelArt, AssetCache *cache);
         ~TextureData();
 
-        SDL_Texture *GetTexture();
+        SDL_Texture *GetTexture(SDL_Renderer *renderer);
 
     private:
         SDL_Texture *m_texture;
         std::string m_path;
         bool m_pixelArt;
+        AssetCache *m_cache;
+        AssetCache::Entry *m_cacheEntry;
     };
 
     std::map<int, SheetData *>   m_sheetMap;
@@ -129,7 +242,72 @@ private:
     std::map<int, FontData *>    m_fontMap;
     std::map<int, MusicData *>   m_musicMap;
     std::map<int, SoundData *>   m_soundMap;
+    struct GlyphAtlasEntry
+    {
+        std::unique_ptr<GlyphAtlas> atlas;
+        /// @brief Valeur de m_glyphAtlasUseCount lors de la dernière utilisation.
+        Uint64 lastUse;
+    };
+
+    /// @brief Atlas par police SDL_ttf et par taille en pixels.
+    std::map<std::pair<TTF_Font *, int>, GlyphAtlasEntry> m_glyphAtlasMap;
+    Uint64 m_glyphAtlasUseCount;
+    float m_fontScale;
+    Uint32 m_fontGeneration;
+
+    SoundMixer m_soundMixer;
 
-    std::vector<int> m_sfxChannels;
-    int m_sfxIndex;
+    SDL_Renderer *m_renderer;
+    bool m_audioEnabled;
+    AssetCache *m_cache;
+
+    std::vector<LoadRecord> m_loadRecords;
+    Uint64 m_loadTimeNS;
+
+    static AssetPack *s_assetPack;
 };
+
+inline const std::vector<AssetManager::LoadRecord> &AssetManager::GetLoadRecords() const
+{
+    return m_loadRecords;
+}
+
+inline Uint64 AssetManager::GetLoadTimeNS() const
+{
+    return m_loadTimeNS;
+}
+
+inline float AssetManager::GetFontScale() const
+{
+    return m_fontScale;
+}
+
+inline Uint32 AssetManager::GetFontGeneration() const
+{
+    return m_fontGeneration;
+}
+
+inline SoundMixer *AssetManager::GetSoundMixer()
+{
+    return &m_soundMixer;
+}
+
+inline bool AssetManager::SheetData::IsLoaded() const
+{
+    return m_sheet != nullptr;
+}
+
+inline const std::string &AssetManager::SheetData::GetPath() const
+{
+    return m_path;
+}
+
+inline void AssetManager::SetAssetPack(AssetPack *assetPack)
+{
+    s_assetPack = assetPack;
+}
+
+inline AssetPack *AssetManager::GetAssetPack()
+{
+    return s_assetPack;
+}
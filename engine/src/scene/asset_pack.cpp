@@ -0,0 +1,427 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/asset_pack.h"
+#include "scene/asset_manager.h"
+
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t HEADER_SIZE = 24;
+
+    std::string NormalizePath(const std::string &path)
+    {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    bool HasExtension(const std::string &name, const char *extension)
+    {
+        const size_t length = strlen(extension);
+        if (name.size() < length) return false;
+        return SDL_strcasecmp(name.c_str() + name.size() - length, extension) == 0;
+    }
+}
+
+AssetPack::Entry::Entry()
+    : name(), offset(0), size(0), type(Type::OTHER), flags(0)
+{
+}
+
+AssetPack::AssetPack()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_mapped(false)
+    , m_assetsPath()
+    , m_entries()
+    , m_indices()
+    , m_decoded()
+    , m_decodeMutex()
+{
+}
+
+AssetPack::~AssetPack()
+{
+    Close();
+}
+
+bool AssetPack::Open(const std::string &packPath, const std::string &assetsPath)
+{
+    Close();
+
+    if (MapFile(packPath) == false) return false;
+    if (ReadIndex() == false)
+    {
+        std::cout << "ERROR - Invalid asset pack " << packPath << std::endl;
+        Close();
+        return false;
+    }
+
+    m_assetsPath = NormalizePath(assetsPath);
+    if (m_assetsPath.empty() == false && m_assetsPath.back() != '/')
+    {
+        m_assetsPath.push_back('/');
+    }
+    return true;
+}
+
+void AssetPack::Close()
+{
+    UnmapFile();
+    m_assetsPath.clear();
+    m_entries.clear();
+    m_indices.clear();
+    m_decoded.clear();
+}
+
+bool AssetPack::MapFile(const std::string &packPath)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize = { 0 };
+        GetFileSizeEx(file, &fileSize);
+        HANDLE mapping = fileSize.QuadPart > 0 ?
+            CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr) : nullptr;
+        if (mapping)
+        {
+            // Vue en copie à l'écriture : le décodage ne modifie pas le fichier
+            m_data = (Uint8 *)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+
+        if (m_data)
+        {
+            m_size = (size_t)fileSize.QuadPart;
+            m_mapped = true;
+            return true;
+        }
+    }
+#else
+    const int fd = open(packPath.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat fileStat = { 0 };
+        void *data = MAP_FAILED;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            // Projection privée : le décodage ne modifie pas le fichier
+            data = mmap(nullptr, (size_t)fileStat.st_size,
+                PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+
+        if (data != MAP_FAILED)
+        {
+            m_data = (Uint8 *)data;
+            m_size = (size_t)fileStat.st_size;
+            m_mapped = true;
+            return true;
+        }
+    }
+#endif
+
+    // Sans projection possible, l'archive est lue en une seule fois
+    size_t size = 0;
+    void *data = SDL_LoadFile(packPath.c_str(), &size);
+    if (data == nullptr) return false;
+
+    m_data = (Uint8 *)data;
+    m_size = size;
+    m_mapped = false;
+    return true;
+}
+
+void AssetPack::UnmapFile()
+{
+    if (m_data == nullptr) return;
+
+    if (m_mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(m_data, m_size);
+#endif
+    }
+    else
+    {
+        SDL_free(m_data);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
+
+bool AssetPack::ReadIndex()
+{
+    if (m_size < HEADER_SIZE) return false;
+
+    SDL_IOStream *ioStream = SDL_IOFromConstMem(m_data, m_size);
+    if (ioStream == nullptr) return false;
+
+    Uint32 magic = 0, version = 0, entryCount = 0, reserved = 0;
+    Uint64 dataOffset = 0;
+    bool success = true;
+    success = success && SDL_ReadU32LE(ioStream, &magic);
+    success = success && SDL_ReadU32LE(ioStream, &version);
+    success = success && SDL_ReadU32LE(ioStream, &entryCount);
+    success = success && SDL_ReadU32LE(ioStream, &reserved);
+    success = success && SDL_ReadU64LE(ioStream, &dataOffset);
+    success = success && magic == MAGIC && version == VERSION && dataOffset <= m_size;
+
+    if (success)
+    {
+        m_entries.resize(entryCount);
+        m_indices.reserve(entryCount);
+    }
+
+    for (Uint32 i = 0; success && i < entryCount; i++)
+    {
+        Entry &entry = m_entries[i];
+        Uint16 nameLength = 0;
+        Uint8 type = 0;
+        success = success && SDL_ReadU16LE(ioStream, &nameLength);
+        if (success)
+        {
+            entry.name.resize(nameLength);
+            success = SDL_ReadIO(ioStream, entry.name.data(), nameLength) == nameLength;
+        }
+        success = success && SDL_ReadU8(ioStream, &type);
+        success = success && SDL_ReadU8(ioStream, &entry.flags);
+        success = success && SDL_ReadU64LE(ioStream, &entry.offset);
+        success = success && SDL_ReadU64LE(ioStream, &entry.size);
+        success = success && entry.offset <= m_size && entry.size <= m_size - entry.offset;
+
+        entry.type = (Type)type;
+        m_indices[entry.name] = (int)i;
+    }
+    SDL_CloseIO(ioStream);
+
+    m_decoded.assign(m_entries.size(), 0);
+    return success;
+}
+
+const AssetPack::Entry *AssetPack::Find(const std::string &path) const
+{
+    if (IsOpen() == false) return nullptr;
+
+    std::string name = NormalizePath(path);
+    if (name.compare(0, m_assetsPath.size(), m_assetsPath) != 0) return nullptr;
+    name.erase(0, m_assetsPath.size());
+
+    auto it = m_indices.find(name);
+    if (it == m_indices.end()) return nullptr;
+    return &m_entries[it->second];
+}
+
+void AssetPack::Decode(int index)
+{
+    const Entry &entry = m_entries[index];
+    if ((entry.flags & FLAG_OBFUSCATED) == 0 || entry.size == 0) return;
+
+    // Plusieurs threads peuvent charger des assets en même temps
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    if (m_decoded[index]) return;
+
+    AssetManager::RetriveMem(m_data + entry.offset, (size_t)entry.size);
+    m_decoded[index] = 1;
+}
+
+bool AssetPack::GetData(const std::string &path, const Uint8 **data, size_t *size)
+{
+    const Entry *entry = Find(path);
+    if (entry == nullptr) return false;
+
+    Decode((int)(entry - m_entries.data()));
+
+    *data = m_data + entry->offset;
+    *size = (size_t)entry->size;
+    return true;
+}
+
+bool AssetPack::GetRawData(const std::string &path, const Uint8 **data, size_t *size, bool *obfuscated)
+{
+    const Entry *entry = Find(path);
+    if (entry == nullptr) return false;
+
+    const int index = (int)(entry - m_entries.data());
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        *obfuscated = (entry->flags & FLAG_OBFUSCATED) && m_decoded[index] == 0;
+    }
+
+    *data = m_data + entry->offset;
+    *size = (size_t)entry->size;
+    return true;
+}
+
+SDL_IOStream *AssetPack::OpenIOStream(const std::string &path)
+{
+    const Uint8 *data = nullptr;
+    size_t size = 0;
+    if (GetData(path, &data, &size) == false) return nullptr;
+
+    SDL_IOStream *ioStream = SDL_IOFromConstMem(data, size);
+    if (ioStream == nullptr)
+    {
+        std::cout
+            << "ERROR - Load IOStream " << path << " from the asset pack" << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+    }
+    return ioStream;
+}
+
+AssetPack::Type AssetPack::DetectType(const std::string &name, const Uint8 *data, size_t size)
+{
+    if (HasExtension(name, ".json")) return Type::JSON;
+
+    if (size >= 8 && memcmp(data, "\x89PNG\r\n\x1A\n", 8) == 0) return Type::IMAGE;
+    if (size >= 3 && memcmp(data, "\xFF\xD8\xFF", 3) == 0) return Type::IMAGE;
+    if (size >= 4 && (memcmp(data, "RIFF", 4) == 0 || memcmp(data, "OggS", 4) == 0)) return Type::AUDIO;
+    if (size >= 3 && memcmp(data, "ID3", 3) == 0) return Type::AUDIO;
+    if (size >= 4 && (memcmp(data, "\x00\x01\x00\x00", 4) == 0 || memcmp(data, "OTTO", 4) == 0)) return Type::FONT;
+
+    return Type::OTHER;
+}
+
+bool AssetPack::Build(const std::string &assetsPath, const std::string &packPath)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    const fs::path root(assetsPath);
+    if (fs::is_directory(root, error) == false)
+    {
+        std::cout << "ERROR - The asset directory " << assetsPath << " does not exist" << std::endl;
+        return false;
+    }
+
+    // Liste triée des fichiers pour obtenir une archive reproductible
+    std::vector<fs::path> paths;
+    for (const fs::directory_entry &dirEntry : fs::recursive_directory_iterator(root, error))
+    {
+        if (dirEntry.is_regular_file() == false) continue;
+
+        const std::string fileName = dirEntry.path().filename().string();
+        if (HasExtension(fileName, ".pak") || HasExtension(fileName, ".exe") ||
+            HasExtension(fileName, ".ini") || HasExtension(fileName, ".md"))
+        {
+            continue;
+        }
+        paths.push_back(dirEntry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<Entry> entries(paths.size());
+    std::vector<std::vector<Uint8>> contents(paths.size());
+    Uint64 dataOffset = HEADER_SIZE;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        Entry &entry = entries[i];
+        std::vector<Uint8> &content = contents[i];
+        entry.name = paths[i].lexically_relative(root).generic_string();
+        dataOffset += 2 + entry.name.size() + 2 + 8 + 8;
+
+        std::ifstream file(paths[i], std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad())
+        {
+            std::cout << "ERROR - The file " << paths[i].string() << " cannot be read" << std::endl;
+            return false;
+        }
+
+        if (content.size() > 2 && content[0] == (Uint8)0x0B && content[1] == (Uint8)0xF7)
+        {
+            // Le nombre magique n'est pas conservé, l'entrée est marquée à la place
+            content.erase(content.begin(), content.begin() + 2);
+            entry.flags |= FLAG_OBFUSCATED;
+
+            std::vector<Uint8> decoded(content);
+            AssetManager::RetriveMem(decoded.data(), decoded.size());
+            entry.type = DetectType(entry.name, decoded.data(), decoded.size());
+        }
+        else
+        {
+            entry.type = DetectType(entry.name, content.data(), content.size());
+        }
+        entry.size = content.size();
+    }
+
+    dataOffset = (dataOffset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    Uint64 offset = dataOffset;
+    for (Entry &entry : entries)
+    {
+        entry.offset = offset;
+        offset = (offset + entry.size + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    }
+
+    SDL_IOStream *ioStream = SDL_IOFromFile(packPath.c_str(), "wb");
+    if (ioStream == nullptr)
+    {
+        std::cout
+            << "ERROR - Write asset pack " << packPath << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    bool success = true;
+    success = success && SDL_WriteU32LE(ioStream, MAGIC);
+    success = success && SDL_WriteU32LE(ioStream, VERSION);
+    success = success && SDL_WriteU32LE(ioStream, (Uint32)entries.size());
+    success = success && SDL_WriteU32LE(ioStream, 0);
+    success = success && SDL_WriteU64LE(ioStream, dataOffset);
+    for (const Entry &entry : entries)
+    {
+        success = success && SDL_WriteU16LE(ioStream, (Uint16)entry.name.size());
+        success = success && SDL_WriteIO(ioStream, entry.name.data(), entry.name.size()) == entry.name.size();
+        success = success && SDL_WriteU8(ioStream, (Uint8)entry.type);
+        success = success && SDL_WriteU8(ioStream, entry.flags);
+        success = success && SDL_WriteU64LE(ioStream, entry.offset);
+        success = success && SDL_WriteU64LE(ioStream, entry.size);
+    }
+
+    const Uint8 padding[DATA_ALIGNMENT] = { 0 };
+    Uint64 position = HEADER_SIZE;
+    for (const Entry &entry : entries) position += 2 + entry.name.size() + 2 + 8 + 8;
+    for (size_t i = 0; success && i < entries.size(); i++)
+    {
+        const size_t paddingSize = (size_t)(entries[i].offset - position);
+        success = SDL_WriteIO(ioStream, padding, paddingSize) == paddingSize;
+        success = success && SDL_WriteIO(ioStream, contents[i].data(), contents[i].size()) == contents[i].size();
+        position = entries[i].offset + entries[i].size;
+    }
+    success = SDL_CloseIO(ioStream) && success;
+
+    if (success == false)
+    {
+        std::cout
+            << "ERROR - Write asset pack " << packPath << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    std::cout << "Asset pack " << packPath << " : " << entries.size()
+        << " files, " << offset << " bytes" << std::endl;
+    return true;
+}
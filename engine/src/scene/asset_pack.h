@@ -0,0 +1,144 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <mutex>
+#include <unordered_map>
+
+/// @brief Archive contenant tous les fichiers du dossier des assets.
+///
+/// Le fichier est projeté en mémoire (mmap) à l'ouverture : les assets sont
+/// lus sans appel à fread ni allocation, à travers des IOStreams constants
+/// (SDL_IOFromConstMem) qui pointent directement dans la projection.
+/// La projection est privée (copie à l'écriture) : les fichiers obfusqués
+/// sont décodés sur place à leur première lecture, seules leurs pages sont
+/// alors copiées par le système.
+///
+/// Format (petit boutiste) :
+/// - en-tête : MAGIC, VERSION, nombre d'entrées, réservé (u32), début des données (u64) ;
+/// - index : pour chaque entrée, longueur du nom (u16), nom, type (u8),
+///   flags (u8), position et taille des données (u64) ;
+/// - données alignées sur DATA_ALIGNMENT octets.
+class AssetPack
+{
+public:
+    static constexpr Uint32 MAGIC = 0x4B415053; // "SPAK"
+    static constexpr Uint32 VERSION = 1;
+    static constexpr Uint64 DATA_ALIGNMENT = 16;
+
+    enum class Type : Uint8
+    {
+        OTHER = 0, JSON, IMAGE, FONT, AUDIO
+    };
+
+    enum Flag : Uint8
+    {
+        /// @brief Données obfusquées (voir AssetManager::ObfuscateMem()).
+        /// Le nombre magique 0x0BF7 des fichiers d'origine n'est pas conservé.
+        FLAG_OBFUSCATED = 1 << 0,
+    };
+
+    struct Entry
+    {
+        Entry();
+
+        /// @brief Chemin relatif au dossier des assets, avec des '/'.
+        std::string name;
+        Uint64 offset;
+        Uint64 size;
+        Type type;
+        Uint8 flags;
+    };
+
+    AssetPack();
+    AssetPack(AssetPack const&) = delete;
+    AssetPack& operator=(AssetPack const&) = delete;
+    ~AssetPack();
+
+    /// @brief Projette l'archive en mémoire et lit son index.
+    /// @param packPath le chemin de l'archive.
+    /// @param assetsPath le dossier des assets utilisé par le jeu. Les chemins
+    /// demandés qui commencent par ce dossier sont cherchés dans l'archive.
+    /// @return false si l'archive est absente ou invalide.
+    bool Open(const std::string &packPath, const std::string &assetsPath);
+    void Close();
+    bool IsOpen() const;
+
+    /// @brief Cherche une entrée à partir du chemin complet d'un fichier.
+    /// @return L'entrée ou nullptr si le fichier n'est pas dans l'archive.
+    const Entry *Find(const std::string &path) const;
+
+    /// @brief Renvoie les données décodées d'un fichier, sans copie.
+    /// Les données restent valides jusqu'à la fermeture de l'archive.
+    /// @return false si le fichier n'est pas dans l'archive.
+    bool GetData(const std::string &path, const Uint8 **data, size_t *size);
+
+    /// @brief Renvoie les données d'un fichier telles qu'elles sont stockées,
+    /// sans les décoder ni copier les pages de la projection.
+    /// Les données lues ainsi (voir AssetStream) ne doivent pas être
+    /// demandées en même temps avec GetData(), qui les décode sur place.
+    /// @param obfuscated indique si les données sont encore obfusquées.
+    /// @return false si le fichier n'est pas dans l'archive.
+    bool GetRawData(const std::string &path, const Uint8 **data, size_t *size, bool *obfuscated);
+
+    /// @brief Crée un IOStream constant sur les données décodées d'un fichier.
+    /// @return L'IOStream ou nullptr si le fichier n'est pas dans l'archive.
+    SDL_IOStream *OpenIOStream(const std::string &path);
+
+    int GetEntryCount() const;
+    const Entry &GetEntry(int index) const;
+    size_t GetFileSize() const;
+
+    /// @brief Construit une archive à partir d'un dossier d'assets.
+    /// Les archives existantes (.pak) et les fichiers qui ne sont pas
+    /// des assets (.exe, .ini, .md) sont ignorés.
+    /// @return false en cas d'erreur d'écriture.
+    static bool Build(const std::string &assetsPath, const std::string &packPath);
+
+private:
+    Uint8 *m_data;
+    size_t m_size;
+    bool m_mapped;
+
+    std::string m_assetsPath;
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, int> m_indices;
+
+    /// @brief Indique pour chaque entrée obfusquée si elle a été décodée.
+    std::vector<Uint8> m_decoded;
+    std::mutex m_decodeMutex;
+
+    bool MapFile(const std::string &packPath);
+    void UnmapFile();
+    bool ReadIndex();
+    void Decode(int index);
+
+    static Type DetectType(const std::string &name, const Uint8 *data, size_t size);
+};
+
+inline bool AssetPack::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+inline int AssetPack::GetEntryCount() const
+{
+    return (int)m_entries.size();
+}
+
+inline const AssetPack::Entry &AssetPack::GetEntry(int index) const
+{
+    assert(0 <= index && index < (int)m_entries.size());
+    return m_entries[index];
+}
+
+inline size_t AssetPack::GetFileSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,212 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/asset_stream.h"
+#include "scene/asset_manager.h"
+#include "scene/asset_pack.h"
+#include "utils/simd_math.h"
+
+namespace
+{
+    /// Chaque bloc est précédé de l'octet codé qui sert à décoder son premier octet.
+    constexpr size_t BLOCK_STRIDE = AssetStream::BLOCK_SIZE + 1;
+}
+
+AssetStream::AssetStream()
+    : m_file(nullptr)
+    , m_memory(nullptr)
+    , m_dataOffset(0)
+    , m_size(0)
+    , m_position(0)
+    , m_blocks(BLOCK_STRIDE * BLOCK_COUNT)
+    , m_blockIndices()
+    , m_blockSizes()
+    , m_nextBlock(0)
+{
+    m_blockIndices.fill(-1);
+    m_blockSizes.fill(0);
+}
+
+AssetStream::~AssetStream()
+{
+    if (m_file) SDL_CloseIO(m_file);
+}
+
+SDL_IOStream *AssetStream::Open(const std::string &path)
+{
+    AssetStream *stream = nullptr;
+
+    AssetPack *assetPack = AssetManager::GetAssetPack();
+    const Uint8 *data = nullptr;
+    size_t size = 0;
+    bool obfuscated = false;
+    if (assetPack && assetPack->GetRawData(path, &data, &size, &obfuscated))
+    {
+        if (obfuscated == false)
+        {
+            // La projection est déjà lue à la demande par le système
+            return assetPack->OpenIOStream(path);
+        }
+
+        stream = new AssetStream();
+        stream->m_memory = data;
+        stream->m_size = (Sint64)size;
+    }
+    else
+    {
+        SDL_IOStream *file = SDL_IOFromFile(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            std::cout
+                << "ERROR - The file " << path << " cannot be opened" << std::endl
+                << "      - " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+
+        // Utilisation du magic number 0x0BF7 pour les fichiers obfusqués
+        const Sint64 fileSize = SDL_GetIOSize(file);
+        Uint8 magic[2] = { 0 };
+        if (fileSize <= 2 || SDL_ReadIO(file, magic, 2) != 2 ||
+            magic[0] != (Uint8)0x0B || magic[1] != (Uint8)0xF7)
+        {
+            SDL_SeekIO(file, 0, SDL_IO_SEEK_SET);
+            return file;
+        }
+
+        stream = new AssetStream();
+        stream->m_file = file;
+        stream->m_dataOffset = 2;
+        stream->m_size = fileSize - 2;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = SizeCallback;
+    iface.seek = SeekCallback;
+    iface.read = ReadCallback;
+    iface.close = CloseCallback;
+
+    SDL_IOStream *ioStream = SDL_OpenIO(&iface, stream);
+    if (ioStream == nullptr)
+    {
+        std::cout
+            << "ERROR - Open stream " << path << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        delete stream;
+    }
+    return ioStream;
+}
+
+int AssetStream::GetBlock(Sint64 blockIndex)
+{
+    for (int i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (m_blockIndices[i] == blockIndex) return i;
+    }
+
+    // Les blocs sont remplacés dans l'ordre où ils ont été lus
+    const int slot = m_nextBlock;
+    m_nextBlock = (m_nextBlock + 1) % BLOCK_COUNT;
+    m_blockIndices[slot] = -1;
+
+    const Sint64 start = blockIndex * (Sint64)BLOCK_SIZE;
+    const size_t size = (size_t)std::min<Sint64>((Sint64)BLOCK_SIZE, m_size - start);
+    Uint8 *block = m_blocks.data() + slot * BLOCK_STRIDE;
+
+    bool success = false;
+    if (start == 0)
+    {
+        block[0] = 0x73;
+        success = ReadEncoded(0, block + 1, size);
+    }
+    else
+    {
+        success = ReadEncoded(start - 1, block, size + 1);
+    }
+    if (success == false) return -1;
+
+    simd::RetriveBytes(block + 1, size, block[0]);
+    m_blockIndices[slot] = blockIndex;
+    m_blockSizes[slot] = size;
+    return slot;
+}
+
+bool AssetStream::ReadEncoded(Sint64 position, Uint8 *dst, size_t size)
+{
+    if (m_memory)
+    {
+        memcpy(dst, m_memory + position, size);
+        return true;
+    }
+
+    if (SDL_SeekIO(m_file, m_dataOffset + position, SDL_IO_SEEK_SET) < 0) return false;
+    return SDL_ReadIO(m_file, dst, size) == size;
+}
+
+Sint64 SDLCALL AssetStream::SizeCallback(void *userdata)
+{
+    return ((AssetStream *)userdata)->m_size;
+}
+
+Sint64 SDLCALL AssetStream::SeekCallback(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    AssetStream *stream = (AssetStream *)userdata;
+    Sint64 position = 0;
+    switch (whence)
+    {
+    case SDL_IO_SEEK_SET: position = offset; break;
+    case SDL_IO_SEEK_CUR: position = stream->m_position + offset; break;
+    case SDL_IO_SEEK_END: position = stream->m_size + offset; break;
+    default:
+        SDL_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+    if (position < 0)
+    {
+        SDL_SetError("Seek before the start of the stream");
+        return -1;
+    }
+
+    stream->m_position = std::min(position, stream->m_size);
+    return stream->m_position;
+}
+
+size_t SDLCALL AssetStream::ReadCallback(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    AssetStream *stream = (AssetStream *)userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t readCount = 0;
+
+    while (readCount < size && stream->m_position < stream->m_size)
+    {
+        const Sint64 blockIndex = stream->m_position / (Sint64)BLOCK_SIZE;
+        const int slot = stream->GetBlock(blockIndex);
+        if (slot < 0)
+        {
+            *status = SDL_IO_STATUS_ERROR;
+            return readCount;
+        }
+
+        const size_t offset = (size_t)(stream->m_position - blockIndex * (Sint64)BLOCK_SIZE);
+        const size_t count = std::min(size - readCount, stream->m_blockSizes[slot] - offset);
+        memcpy(dst + readCount, stream->m_blocks.data() + slot * BLOCK_STRIDE + 1 + offset, count);
+
+        readCount += count;
+        stream->m_position += (Sint64)count;
+    }
+
+    if (readCount < size)
+    {
+        *status = SDL_IO_STATUS_EOF;
+    }
+    return readCount;
+}
+
+bool SDLCALL AssetStream::CloseCallback(void *userdata)
+{
+    delete (AssetStream *)userdata;
+    return true;
+}
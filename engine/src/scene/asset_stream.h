@@ -0,0 +1,68 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Flux en lecture seule qui décode un fichier obfusqué à la demande.
+///
+/// Contrairement à AssetManager::CreateIOStream(), le fichier n'est pas lu
+/// en entier : les données sont lues et décodées par blocs de BLOCK_SIZE
+/// octets, et seuls les BLOCK_COUNT derniers blocs lus restent en mémoire.
+/// Chaque octet décodé ne dépend que de l'octet codé qui le précède, un bloc
+/// peut donc être décodé quelle que soit la position de lecture.
+///
+/// Les données sont lues dans l'archive des assets si elle contient le
+/// fichier (sans copier les pages de la projection), sinon dans le fichier.
+/// Un flux ne doit être utilisé que par un thread à la fois.
+class AssetStream
+{
+public:
+    static constexpr size_t BLOCK_SIZE = (size_t)32 << 10;
+    static constexpr int BLOCK_COUNT = 4;
+
+    /// @brief Mémoire occupée par les blocs d'un flux (en octets).
+    static constexpr size_t BUFFER_SIZE = BLOCK_SIZE * BLOCK_COUNT;
+
+    /// @brief Ouvre un flux sur le contenu décodé d'un fichier.
+    /// Les fichiers qui ne sont pas obfusqués sont lus directement
+    /// (SDL_IOFromConstMem ou SDL_IOFromFile).
+    /// @param path le chemin du fichier.
+    /// @return Le flux, à fermer avec SDL_CloseIO(), ou nullptr en cas d'erreur.
+    static SDL_IOStream *Open(const std::string &path);
+
+private:
+    AssetStream();
+    AssetStream(AssetStream const&) = delete;
+    AssetStream& operator=(AssetStream const&) = delete;
+    ~AssetStream();
+
+    /// @brief Fichier source, ou nullptr si les données sont dans l'archive.
+    SDL_IOStream *m_file;
+    /// @brief Données codées dans l'archive.
+    const Uint8 *m_memory;
+    /// @brief Position des données codées dans le fichier source
+    /// (après le nombre magique 0x0BF7).
+    Sint64 m_dataOffset;
+    Sint64 m_size;
+    Sint64 m_position;
+
+    std::vector<Uint8> m_blocks;
+    std::array<Sint64, BLOCK_COUNT> m_blockIndices;
+    std::array<size_t, BLOCK_COUNT> m_blockSizes;
+    int m_nextBlock;
+
+    /// @brief Renvoie le bloc décodé contenant une position, en le lisant si besoin.
+    /// @return L'indice du bloc dans m_blocks ou -1 en cas d'erreur de lecture.
+    int GetBlock(Sint64 blockIndex);
+    bool ReadEncoded(Sint64 position, Uint8 *dst, size_t size);
+
+    static Sint64 SDLCALL SizeCallback(void *userdata);
+    static Sint64 SDLCALL SeekCallback(void *userdata, Sint64 offset, SDL_IOWhence whence);
+    static size_t SDLCALL ReadCallback(void *userdata, void *ptr, size_t size, SDL_IOStatus *status);
+    static bool SDLCALL CloseCallback(void *userdata);
+};
@@ -110,7 +110,7 @@ void Particle::Render(
     assert(success);
 
     RenderTextureRotated(
-        g_renderer, texture, srcRect, &dstRect, anchor,
+        renderer, texture, srcRect, &dstRect, anchor,
         -angle, flip
     );
 }
@@ -161,7 +161,7 @@ void ParticleSystem::renderParticleLayers(
         std::vector<Particle> &particles = it->second;
         for (auto &particle : particles)
         {
-            particle.Render(animManager, g_renderer, camera, cameraTransform);
+            particle.Render(animManager, m_scene->GetRenderer(), camera, cameraTransform);
         }
     }
 }
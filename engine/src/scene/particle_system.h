@@ -17,6 +17,8 @@ struct Particle;
 
 class ParticleSystem
 {
+    friend class SceneSnapshot;
+
 public:
     ParticleSystem(Scene *scene) : m_scene(scene) {}
     virtual ~ParticleSystem();
@@ -10,7 +10,14 @@
 #include "ui/base/ui_canvas.h"
 #include "scene/scene_manager.h"
 
-#define TIME_STEP_MS 16
+#define MAX_STEPS_PER_FRAME 8
+
+// Le hash de l'tat est calcul  chaque pas fixe dans les builds de dveloppement
+#ifdef NDEBUG
+#define STATE_HASH_ENABLED false
+#else
+#define STATE_HASH_ENABLED true
+#endif
 
 RayHit::RayHit()
     : shapeId(b2_nullShapeId)
@@ -31,26 +38,54 @@ OverlapResult::OverlapResult()
     , entity(entt::null)
 {}
 
-Scene::Scene(SceneManager *manager, InputManager *inputManager)
-    : m_sceneManager(manager)
+Scene::FixedStepStats::FixedStepStats()
+    : lastStepCount(0)
+    , maxStepCount(0)
+    , clampedFrameCount(0)
+    , droppedNS(0)
+{}
+
+Scene::Scene(SceneManager *manager, InputManager *inputManager, const SceneContext &context)
+    : m_registry()
+    , m_sceneManager(manager)
+    , m_mode(UpdateMode::REALTIME)
+    , m_time()
+    , m_worldId(b2_nullWorldId)
+    , m_uiObjectManager()
     , m_inputManager(inputManager)
-    , m_stepAccuMS(0)
+    , m_context(context)
+    , m_assetManager(context.renderer, context.headless == false, context.assetCache)
+    , m_particleSystem(this)
+    , m_tickRate(0.f)
+    , m_timeStepNS(0)
+    , m_stepAccuNS(0)
+    , m_maxStepsPerFrame(MAX_STEPS_PER_FRAME)
+    , m_fixedStepStats()
+    , m_fixedStepCount(0)
+    , m_nextDeltaNS(0)
+    , m_hasNextDelta(false)
+    , m_updateID(0)
     , m_alpha(0.f)
     , m_makeStep(false)
-    , m_mode(UpdateMode::REALTIME)
-    , m_uiObjectManager()
     , m_quit(false)
-    , m_timeStepMS(TIME_STEP_MS)
     , m_inFixedUpdate(false)
-    , m_time()
-    , m_assetManager()
-    , m_particleSystem(this)
-    , m_worldId(b2_nullWorldId)
+    , m_resimulating(false)
+    , m_random()
+    , m_cosmeticRandom()
+    , m_stateHashEnabled(STATE_HASH_ENABLED)
+    , m_stateHashNames()
+    , m_stateHashFuncs()
+    , m_stateHash()
+    , m_stateHashTimeMS(0.f)
+    , m_stateHashLog(nullptr)
+    , m_systemProfiler(nullptr)
+    , m_queryGizmosEnabled(false)
     , m_queryGizmos()
-    , m_updateID(0)
+    , m_queryShape()
     , m_entityCommandBuffer()
-    , m_registry()
 {
+    SetTickRate(context.tickRate > 0.f ? context.tickRate : SceneContext::DEFAULT_TICK_RATE);
+
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = { 0.0f, -40.0f };
     worldDef.enableSleep = false;
@@ -60,6 +95,36 @@ Scene::Scene(SceneManager *manager, InputManager *inputManager)
     RigidbodyUtils::AttachConstruct(m_registry);
     RigidbodyUtils::AttachDestroy(m_registry);
 
+    // Graine du contexte ou graine par dfaut, remplace par SeedRandom()
+    // pour une partie reproductible
+    if (context.seed != 0)
+    {
+        SeedRandom(context.seed);
+    }
+    else
+    {
+        SeedRandom(SDL_GetPerformanceCounter() ^ (uint64_t)time(nullptr));
+    }
+
+    AddStateHashCategory("Bodies", [](Scene *scene, StateHasher &hasher)
+    {
+        hasher.AddComponents<Rigidbody>(scene->GetRegistry(),
+            [](StateHasher &bodyHasher, const Rigidbody &rigidbody)
+        {
+            if (b2Body_IsValid(rigidbody.bodyId) == false) return;
+
+            const b2Transform transform = b2Body_GetTransform(rigidbody.bodyId);
+            bodyHasher.Add(transform.p);
+            bodyHasher.Add(transform.q);
+            bodyHasher.Add(b2Body_GetLinearVelocity(rigidbody.bodyId));
+            bodyHasher.Add(b2Body_GetAngularVelocity(rigidbody.bodyId));
+        });
+    });
+    AddStateHashCategory("Random", [](Scene *scene, StateHasher &hasher)
+    {
+        hasher.Add(scene->GetRandom().GetState());
+    });
+
     m_canvas = nullptr;
     m_canvas = new UICanvas(this);
 
@@ -98,38 +163,143 @@ void Scene::Update()
     m_uiObjectManager.ProcessObjects();
 
     // Met  jour les entres de l'utilisateur
-    m_inputManager->ProcessEvents();
+    // Une scne sans rendu ne lit pas les vnements SDL : ils appartiennent
+    // au thread principal. Ses entres sont imposes par le jeu.
+    if (m_context.headless == false)
+    {
+        m_inputManager->ProcessEvents();
+    }
 
     m_particleSystem.Update();
 
     // Met  jour les entits et les UIObjects
     UpdateGameObjects();
+
+    // Sons demands pendant la frame (interface, systmes de prsentation)
+    m_assetManager.GetSoundMixer()->Flush();
 }
 
 void Scene::MakeFixedStep()
 {
-    const float timeStep = (float)m_timeStepMS / 1000.f;
+    const float timeStep = GetTimeStep();
+    const Uint64 stepStartNS = m_systemProfiler ? SDL_GetTicksNS() : 0;
     m_inFixedUpdate = true;
 
-    for (QueryGizmos *autoGizmos : m_queryGizmos) delete autoGizmos;
-    m_queryGizmos.clear();
+    m_queryGizmos.Clear();
 
     // World
     int32_t subSteps = 4;
     b2World_Step(m_worldId, timeStep, subSteps);
+    if (m_systemProfiler)
+    {
+        m_systemProfiler->AddSample("Box2D world step", SDL_GetTicksNS() - stepStartNS);
+    }
 
     // ECS
     for (auto &system : m_simulationSystems)
     {
         if (system->enabled == false) continue;
+        const Uint64 systemStartNS = m_systemProfiler ? SDL_GetTicksNS() : 0;
         system->OnFixedUpdate(m_entityCommandBuffer);
         m_entityCommandBuffer.Flush(m_registry);
+        if (m_systemProfiler)
+        {
+            m_systemProfiler->AddSample(system->name, SDL_GetTicksNS() - systemStartNS);
+        }
     }
 
     // Scene manager
     if (m_sceneManager) m_sceneManager->OnSceneFixedUpdate();
 
+    m_fixedStepCount++;
     m_inFixedUpdate = false;
+
+    // Un mme son n'est jou qu'une fois par pas. Les sons d'une
+    // resimulation ont dj t jous lors de la premire simulation.
+    if (m_resimulating) m_assetManager.GetSoundMixer()->CancelRequests();
+    else m_assetManager.GetSoundMixer()->Flush();
+
+    if (m_stateHashEnabled) UpdateStateHash();
+
+    if (m_systemProfiler)
+    {
+        m_systemProfiler->AddTick(SDL_GetTicksNS() - stepStartNS);
+    }
+}
+
+void Scene::SetTickRate(float ticksPerSecond)
+{
+    if (ticksPerSecond <= 0.f)
+    {
+        std::cout << "ERROR - Invalid tick rate " << ticksPerSecond << std::endl;
+        assert(false);
+        return;
+    }
+    m_tickRate = ticksPerSecond;
+    m_timeStepNS = (Uint64)std::llround(1e9 / (double)ticksPerSecond);
+}
+
+void Scene::SeedRandom(uint64_t seed)
+{
+    m_random.Seed(seed);
+    m_cosmeticRandom.Seed(seed ^ 0x5ca1ab1e0ddba11ULL);
+}
+
+void Scene::AddStateHashCategory(const std::string &name, StateHashFunc hashFunc)
+{
+    if (m_stateHashNames.size() >= MAX_STATE_HASH_CATEGORIES)
+    {
+        std::cout << "ERROR - Too many state hash categories" << std::endl;
+        assert(false);
+        return;
+    }
+    m_stateHashNames.push_back(name);
+    m_stateHashFuncs.push_back(hashFunc);
+}
+
+void Scene::UpdateStateHash()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    StateHasher hasher;
+    m_stateHash.tick = m_fixedStepCount - 1;
+    for (size_t i = 0; i < m_stateHashFuncs.size(); i++)
+    {
+        StateHasher categoryHasher;
+        m_stateHashFuncs[i](this, categoryHasher);
+        m_stateHash.categories[i] = categoryHasher.GetValue();
+        hasher.Add(m_stateHash.categories[i]);
+    }
+    m_stateHash.value = hasher.GetValue();
+
+    if (m_stateHashLog)
+    {
+        if (m_stateHashLog->GetCategories().size() != m_stateHashNames.size())
+        {
+            m_stateHashLog->SetCategories(m_stateHashNames);
+        }
+        m_stateHashLog->Record(m_stateHash);
+    }
+
+    m_stateHashTimeMS = (float)(1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+        / (double)SDL_GetPerformanceFrequency());
+}
+
+void Scene::ResimulateStep()
+{
+    m_resimulating = true;
+
+    MakeFixedStep();
+
+    for (auto &system : m_simulationSystems)
+    {
+        if (system->enabled == false) continue;
+        system->OnUpdate(m_entityCommandBuffer);
+        m_entityCommandBuffer.Flush(m_registry);
+    }
+    m_assetManager.GetSoundMixer()->CancelRequests();
+
+    m_resimulating = false;
 }
 
 void Scene::UpdateGameObjects()
@@ -140,22 +310,45 @@ void Scene::UpdateGameObjects()
     if (m_mode == UpdateMode::REALTIME)
     {
         // Mode temps rel
-        m_time.Update();
+        if (m_hasNextDelta)
+        {
+            m_time.UpdateNS(m_nextDeltaNS);
+            m_hasNextDelta = false;
+        }
+        else
+        {
+            m_time.Update();
+        }
 
-        m_stepAccuMS += m_time.GetDeltaMS();
-        while (m_stepAccuMS >= m_timeStepMS)
+        m_stepAccuNS += m_time.GetDeltaNS();
+        int stepCount = 0;
+        while (m_stepAccuNS >= m_timeStepNS)
         {
+            if (stepCount >= m_maxStepsPerFrame)
+            {
+                // La simulation ne rattrape pas le temps rel :
+                // le retard est abandonn, seule la fraction de pas est conserve
+                const Uint64 droppedNS = m_stepAccuNS - m_stepAccuNS % m_timeStepNS;
+                m_fixedStepStats.clampedFrameCount++;
+                m_fixedStepStats.droppedNS += droppedNS;
+                m_stepAccuNS -= droppedNS;
+                break;
+            }
+
             MakeFixedStep();
-            m_stepAccuMS -= m_timeStepMS;
+            m_stepAccuNS -= m_timeStepNS;
+            stepCount++;
         }
-        m_alpha = (float)m_stepAccuMS / (float)m_timeStepMS;
+        m_fixedStepStats.lastStepCount = stepCount;
+        m_fixedStepStats.maxStepCount = std::max(m_fixedStepStats.maxStepCount, stepCount);
+        m_alpha = (float)((double)m_stepAccuNS / (double)m_timeStepNS);
     }
     else
     {
         // Mode pas  pas
         if (m_makeStep)
         {
-            m_time.Update(m_timeStepMS);
+            m_time.UpdateNS(m_timeStepNS);
             MakeFixedStep();
         }
         else
@@ -173,8 +366,13 @@ void Scene::UpdateGameObjects()
     for (auto &system : m_simulationSystems)
     {
         if (system->enabled == false) continue;
+        const Uint64 systemStartNS = m_systemProfiler ? SDL_GetTicksNS() : 0;
         system->OnUpdate(m_entityCommandBuffer);
         m_entityCommandBuffer.Flush(m_registry);
+        if (m_systemProfiler)
+        {
+            m_systemProfiler->AddSample(system->name + " (update)", SDL_GetTicksNS() - systemStartNS);
+        }
     }
 
     // UIObjects
@@ -283,19 +481,21 @@ RayHit Scene::RayCastFirstGizmos(
 {
     RayHit firstHit = RayCastFirst(point1, point2, filter);
 
-#ifdef SCENE_SAVE_QUERIES
+    if (m_queryGizmosEnabled == false) return firstHit;
+
     b2ShapeId shapeId = firstHit.shapeId;
     if (b2Shape_IsValid(shapeId))
     {
-        m_queryGizmos.insert(new QueryGizmos(hitColor, GizmosShape(shapeId)));
-        m_queryGizmos.insert(new QueryGizmos(hitColor, GizmosShape(point1, point2)));
+        m_queryShape.Set(shapeId);
+        m_queryGizmos.Add(hitColor, m_queryShape);
+        m_queryShape.Set(point1, point2);
+        m_queryGizmos.Add(hitColor, m_queryShape);
     }
     else
     {
-        m_queryGizmos.insert(new QueryGizmos(defaultColor, GizmosShape(point1, point2)));
-
+        m_queryShape.Set(point1, point2);
+        m_queryGizmos.Add(defaultColor, m_queryShape);
     }
-#endif
 
     return firstHit;
 }
@@ -326,15 +526,17 @@ void Scene::RayCastGizmos(
 {
     RayCast(point1, point2, filter, result);
 
-#ifdef SCENE_SAVE_QUERIES
+    if (m_queryGizmosEnabled == false) return;
+
     Color color = result.empty() ? defaultColor : hitColor;
-    m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(point1, point2)));
+    m_queryShape.Set(point1, point2);
+    m_queryGizmos.Add(color, m_queryShape);
     for (auto it = result.begin(); it != result.end(); ++it)
     {
         const RayHit &rayHit = *it;
-        m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(rayHit.shapeId)));
+        m_queryShape.Set(rayHit.shapeId);
+        m_queryGizmos.Add(color, m_queryShape);
     }
-#endif
 }
 
 class OverlapContext
@@ -403,15 +605,17 @@ void Scene::OverlapAABBGizmos(
 {
     OverlapAABB(aabb, filter, result);
 
-#ifdef SCENE_SAVE_QUERIES
+    if (m_queryGizmosEnabled == false) return;
+
     Color color = result.empty() ? defaultColor : hitColor;
-    m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(aabb)));
+    m_queryShape.Set(aabb);
+    m_queryGizmos.Add(color, m_queryShape);
     for (auto it = result.begin(); it != result.end(); ++it)
     {
         const OverlapResult &overlap = *it;
-        m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(overlap.shapeId)));
+        m_queryShape.Set(overlap.shapeId);
+        m_queryGizmos.Add(color, m_queryShape);
     }
-#endif
 }
 
 void Scene::OverlapCircle(
@@ -441,22 +645,22 @@ void Scene::OverlapCircleGizmos(
 {
     OverlapCircle(center, radius, filter, result);
 
-#ifdef SCENE_SAVE_QUERIES
-    GizmosShape shape;
+    if (m_queryGizmosEnabled == false) return;
+
     b2Transform xf = b2Transform_identity;
     b2Circle circle = { 0 };
     circle.center = center;
     circle.radius = radius;
-    shape.SetAsCircle(circle, xf);
+    m_queryShape.SetAsCircle(circle, xf);
 
     Color color = result.empty() ? defaultColor : hitColor;
-    m_queryGizmos.insert(new QueryGizmos(color, shape));
+    m_queryGizmos.Add(color, m_queryShape);
     for (auto it = result.begin(); it != result.end(); ++it)
     {
         const OverlapResult &overlap = *it;
-        m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(overlap.shapeId)));
+        m_queryShape.Set(overlap.shapeId);
+        m_queryGizmos.Add(color, m_queryShape);
     }
-#endif
 }
 
 void Scene::OverlapPolygon(
@@ -488,21 +692,21 @@ void Scene::OverlapPolygonGizmos(
 {
     OverlapPolygon(vertices, vertexCount, filter, result);
 
-#ifdef SCENE_SAVE_QUERIES
-    GizmosShape shape;
+    if (m_queryGizmosEnabled == false) return;
+
     b2Transform xf = b2Transform_identity;
     b2Hull hull = b2ComputeHull(vertices, vertexCount);
     b2Polygon polygonShape = b2MakePolygon(&hull, 0.f);
-    shape.SetAsPolygon(polygonShape, xf);
+    m_queryShape.SetAsPolygon(polygonShape, xf);
 
     Color color = result.empty() ? defaultColor : hitColor;
-    m_queryGizmos.insert(new QueryGizmos(color, shape));
+    m_queryGizmos.Add(color, m_queryShape);
     for (auto it = result.begin(); it != result.end(); ++it)
     {
         const OverlapResult &overlap = *it;
-        m_queryGizmos.insert(new QueryGizmos(color, GizmosShape(overlap.shapeId)));
+        m_queryShape.Set(overlap.shapeId);
+        m_queryGizmos.Add(color, m_queryShape);
     }
-#endif
 }
 
 float Scene::GetUIPixelsPerUnit() const
@@ -9,23 +9,24 @@
 #include "game_engine_settings.h"
 #include "game_engine_common.h"
 #include "utils/timer.h"
+#include "utils/random.h"
 #include "utils/gizmos_shape.h"
 #include "input/input_manager.h"
 #include "ui/ui_object_manager.h"
 #include "scene/asset_manager.h"
+#include "scene/scene_context.h"
 #include "scene/particle_system.h"
+#include "scene/state_hash.h"
+#include "scene/system_profiler.h"
 #include "ecs/command_buffer.h"
 #include "ecs/basic_components.h"
 #include "ecs/basic_systems.h"
 #include "rendering/sprite_anim.h"
 #include "imgui/imgui_manager_base.h"
 
-#define SCENE_SAVE_QUERIES
-
 class SceneManager;
 class UICanvas;
 class ParticleSystem;
-struct QueryGizmos;
 
 class RayHit
 {
@@ -66,8 +67,10 @@ struct OverlapResult
 
 class Scene
 {
+    friend class SceneSnapshot;
+
 public:
-    Scene(SceneManager *manager, InputManager *inputManager);
+    Scene(SceneManager *manager, InputManager *inputManager, const SceneContext &context = SceneContext());
     Scene(Scene const&) = delete;
     Scene& operator=(Scene const&) = delete;
     virtual ~Scene();
@@ -78,10 +81,35 @@ public:
     SceneManager *GetSceneManager();
     InputManager *GetInputManager();
     AssetManager *GetAssetManager();
+    const SceneContext &GetContext() const;
+    SDL_Renderer *GetRenderer() const;
+    TTF_TextEngine *GetTextEngine() const;
+
+    /// @brief Indique si la scne est mise  jour sans rendu, sans son
+    /// et sans lecture des vnements SDL.
+    bool IsHeadless() const;
     SpriteAnimManager *GetAnimManager();
     b2WorldId GetWorld() const;
     entt::registry &GetRegistry();
     ParticleSystem *GetParticleSystem();
+
+    /// @brief Enregistre un groupe propritaire (owning group) pour une
+    /// combinaison de composants frquemment parcourue.
+    /// Les composants possds sont rangs dans le mme ordre dans leurs pools,
+    /// le parcours du groupe est alors linaire.
+    /// Un composant ne peut tre possd que par un seul groupe et son pool
+    /// ne peut plus tre tri. Cette mthode doit tre appele au dmarrage.
+    template <typename... Owned, typename... Get, typename... Exclude>
+    void RegisterGroup(
+        entt::get_t<Get...> = entt::get_t{},
+        entt::exclude_t<Exclude...> = entt::exclude_t{});
+
+    /// @brief Indique si un groupe a t enregistr avec RegisterGroup().
+    /// Les systmes utilisent le groupe s'il existe et une vue sinon.
+    template <typename... Owned, typename... Get, typename... Exclude>
+    bool HasGroup(
+        entt::get_t<Get...> = entt::get_t{},
+        entt::exclude_t<Exclude...> = entt::exclude_t{}) const;
     UIObjectManager *GetUIObjectManager();
     std::shared_ptr<ImGuiManagerBase> GetImGuiManager();
     void SetImGuiManager(std::shared_ptr<ImGuiManagerBase> imGuiManager);
@@ -115,11 +143,55 @@ public:
     const Uint64 GetTimeStepMS() const;
     const float GetUnscaledDelta() const;
     const Uint64 GetUnscaledDeltaMS() const;
-
-    std::set<QueryGizmos *> &GetQueryGizmos()
+    const Uint64 GetTimeStepNS() const;
+    const Uint64 GetUnscaledDeltaNS() const;
+
+    /// @brief Dfinit la frquence de la simulation (nombre de pas fixes par seconde).
+    /// Le pas fixe est arrondi  la nanoseconde.
+    /// @param ticksPerSecond la frquence, 60 par dfaut.
+    void SetTickRate(float ticksPerSecond);
+    float GetTickRate() const;
+
+    /// @brief Dfinit le nombre maximal de pas fixes excuts pendant une frame.
+    /// Au-del, le temps restant dans l'accumulateur est abandonn : la
+    /// simulation ralentit au lieu d'accumuler un retard qu'elle ne pourra
+    /// jamais rattraper (spirale de la mort).
+    void SetMaxStepsPerFrame(int maxSteps);
+    int GetMaxStepsPerFrame() const;
+
+    struct FixedStepStats
     {
-        return m_queryGizmos;
-    }
+        FixedStepStats();
+
+        /// @brief Nombre de pas fixes de la dernire frame.
+        int lastStepCount;
+        /// @brief Nombre maximal de pas fixes effectus en une frame.
+        int maxStepCount;
+        /// @brief Nombre de frames o la limite de pas a t atteinte.
+        int clampedFrameCount;
+        /// @brief Temps de simulation abandonn  cause de la limite.
+        Uint64 droppedNS;
+    };
+
+    const FixedStepStats &GetFixedStepStats() const;
+
+    /// @brief Renvoie le nombre de pas fixes effectus depuis le dbut de la scne.
+    Uint64 GetFixedStepCount() const;
+
+    /// @brief Renvoie le temps coul mesur en pas fixes (en secondes).
+    /// Contrairement  GetElapsed(), il ne dpend pas du dcoupage en frames
+    /// et peut tre utilis dans OnFixedUpdate() pour une simulation dterministe.
+    const float GetFixedElapsed() const;
+
+    /// @brief Active l'enregistrement des formes des requtes *Gizmos()
+    /// (RayCastFirstGizmos(), OverlapCircleGizmos()...), affiches par
+    /// RenderQuerySystem. Dsactiv, une requte *Gizmos() ne cote qu'un test
+    /// de plus que la requte simple.
+    void SetQueryGizmosEnabled(bool enabled);
+    bool GetQueryGizmosEnabled() const;
+
+    /// @brief Renvoie les formes des requtes du dernier pas fixe.
+    const GizmosBuffer &GetQueryGizmos() const;
 
     RayHit RayCastFirst(
         b2Vec2 point1, b2Vec2 point2, const QueryFilter &filter
@@ -185,6 +257,64 @@ public:
     void MakeStep();
     Uint64 GetUpdateID() const;
 
+    /// @brief Rejoue immdiatement un pas de simulation complet : un pas fixe
+    /// suivi des mthodes OnUpdate() des systmes de simulation, avec le pas fixe
+    /// comme cart de temps. Utilis par le rollback aprs la restauration d'un
+    /// SceneSnapshot.
+    void ResimulateStep();
+
+    /// @brief Indique si la scne est en train de rejouer un pas (ResimulateStep()).
+    bool IsResimulating() const;
+
+    /// @brief Impose l'cart de temps de la prochaine mise  jour en mode temps rel
+    /// au lieu de le mesurer. Permet de rejouer une partie frame par frame,
+    /// plus vite que le temps rel si ncessaire.
+    /// @param deltaMS l'cart de temps en millisecondes.
+    void SetNextDeltaMS(Uint64 deltaMS);
+    void SetNextDeltaNS(Uint64 deltaNS);
+
+    /// @brief Renvoie le gnrateur alatoire de la simulation.
+    /// Il doit tre utilis pour tout ce qui modifie l'tat du jeu
+    /// (IA, apparition d'objets...). Son tat est sauvegard dans les snapshots.
+    RandomStream &GetRandom();
+
+    /// @brief Renvoie le gnrateur alatoire des effets visuels et sonores.
+    /// Il n'influence jamais la simulation, qui reste donc identique
+    /// quel que soit le nombre d'effets jous.
+    RandomStream &GetCosmeticRandom();
+
+    /// @brief Rinitialise les deux gnrateurs alatoires de la scne.
+    void SeedRandom(uint64_t seed);
+
+    using StateHashFunc = std::function<void(Scene *scene, StateHasher &hasher)>;
+
+    /// @brief Ajoute une catgorie au hash de l'tat de la simulation,
+    /// calcul aprs chaque pas fixe. La catgorie "Bodies" (transformations
+    /// et vitesses des corps physiques) est toujours prsente.
+    /// @param name le nom de la catgorie (sans espace).
+    /// @param hashFunc la fonction ajoutant l'tat de la catgorie au hash.
+    void AddStateHashCategory(const std::string &name, StateHashFunc hashFunc);
+    const std::vector<std::string> &GetStateHashCategories() const;
+
+    /// @brief Active le calcul du hash aprs chaque pas fixe.
+    /// Il est activ par dfaut dans les builds de dveloppement.
+    void SetStateHashEnabled(bool enabled);
+    bool IsStateHashEnabled() const;
+
+    /// @brief Renvoie le hash calcul aprs le dernier pas fixe.
+    const TickHash &GetStateHash() const;
+    float GetStateHashTimeMS() const;
+
+    /// @brief Dfinit l'historique dans lequel le hash de chaque pas fixe est enregistr.
+    /// @param log l'historique (nullptr pour ne rien enregistrer).
+    void SetStateHashLog(StateHashLog *log);
+
+    /// @brief Dfinit le profileur qui mesure chaque systme de simulation,
+    /// le pas du moteur physique et la dure de chaque pas fixe.
+    /// @param profiler le profileur (nullptr pour ne rien mesurer).
+    void SetSystemProfiler(SystemProfiler *profiler);
+    SystemProfiler *GetSystemProfiler();
+
 protected:
     entt::registry m_registry;
 
@@ -204,6 +334,8 @@ protected:
     /// @brief Gestionnaire des entres utilisateur.
     InputManager *m_inputManager;
 
+    SceneContext m_context;
+
     /// @brief Gestionnaire des ressources de la scne.
     AssetManager m_assetManager;
 
@@ -215,11 +347,26 @@ protected:
 
     std::shared_ptr<ImGuiManagerBase> m_imGuiManager;
 
-    /// @brief Pas de temps fixe.
-    Uint64 m_timeStepMS;
+    /// @brief Frquence de la simulation (pas fixes par seconde).
+    float m_tickRate;
+
+    /// @brief Pas de temps fixe, en nanosecondes.
+    Uint64 m_timeStepNS;
 
     /// @brief Accumulateur pour la mise  jour  pas de temps fixe.
-    Uint64 m_stepAccuMS;
+    /// Exprim en nanosecondes : la partie d'un pas non encore simule
+    /// est conserve d'une frame  l'autre sans arrondi.
+    Uint64 m_stepAccuNS;
+
+    int m_maxStepsPerFrame;
+    FixedStepStats m_fixedStepStats;
+
+    /// @brief Nombre de pas fixes effectus.
+    Uint64 m_fixedStepCount;
+
+    /// @brief Ecart de temps impos pour la prochaine mise  jour (en nanosecondes).
+    Uint64 m_nextDeltaNS;
+    bool m_hasNextDelta;
 
     Uint64 m_updateID;
 
@@ -236,8 +383,26 @@ protected:
     void MakeFixedStep();
 
     bool m_inFixedUpdate;
+    bool m_resimulating;
+
+    RandomStream m_random;
+    RandomStream m_cosmeticRandom;
+
+    bool m_stateHashEnabled;
+    std::vector<std::string> m_stateHashNames;
+    std::vector<StateHashFunc> m_stateHashFuncs;
+    TickHash m_stateHash;
+    float m_stateHashTimeMS;
+    StateHashLog *m_stateHashLog;
+
+    void UpdateStateHash();
 
-    std::set<QueryGizmos *> m_queryGizmos;
+    SystemProfiler *m_systemProfiler;
+
+    bool m_queryGizmosEnabled;
+    GizmosBuffer m_queryGizmos;
+    /// @brief Forme temporaire copie dans m_queryGizmos (conserve sa capacit).
+    GizmosShape m_queryShape;
     std::vector<std::shared_ptr<System>> m_simulationSystems;
     std::vector<std::shared_ptr<System>> m_presentationSystems;
     EntityCommandBuffer m_entityCommandBuffer;
@@ -258,6 +423,26 @@ inline AssetManager *Scene::GetAssetManager()
     return &m_assetManager;
 }
 
+inline const SceneContext &Scene::GetContext() const
+{
+    return m_context;
+}
+
+inline SDL_Renderer *Scene::GetRenderer() const
+{
+    return m_context.renderer;
+}
+
+inline TTF_TextEngine *Scene::GetTextEngine() const
+{
+    return m_context.textEngine;
+}
+
+inline bool Scene::IsHeadless() const
+{
+    return m_context.headless;
+}
+
 inline SpriteAnimManager *Scene::GetAnimManager()
 {
     return &m_animManager;
@@ -273,6 +458,18 @@ inline entt::registry &Scene::GetRegistry()
     return m_registry;
 }
 
+template <typename... Owned, typename... Get, typename... Exclude>
+inline void Scene::RegisterGroup(entt::get_t<Get...> get, entt::exclude_t<Exclude...> exclude)
+{
+    m_registry.group<Owned...>(get, exclude);
+}
+
+template <typename... Owned, typename... Get, typename... Exclude>
+inline bool Scene::HasGroup(entt::get_t<Get...> get, entt::exclude_t<Exclude...> exclude) const
+{
+    return static_cast<bool>(m_registry.group_if_exists<Owned...>(get, exclude));
+}
+
 inline ParticleSystem *Scene::GetParticleSystem()
 {
     return &m_particleSystem;
@@ -335,32 +532,72 @@ inline const Uint64 Scene::GetElapsedMS() const
 
 inline const float Scene::GetDelta() const
 {
-    return m_inFixedUpdate ? (static_cast<float>(m_timeStepMS) / 1000.f) : m_time.GetDelta();
+    return (m_inFixedUpdate || m_resimulating) ? GetTimeStep() : m_time.GetDelta();
 }
 
 inline const Uint64 Scene::GetDeltaMS() const
 {
-    return m_inFixedUpdate ? m_timeStepMS : m_time.GetDeltaMS();
+    return (m_inFixedUpdate || m_resimulating) ? GetTimeStepMS() : m_time.GetDeltaMS();
 }
 
 inline const float Scene::GetUnscaledDelta() const
 {
-    return m_inFixedUpdate ? (static_cast<float>(m_timeStepMS) / 1000.f) : m_time.GetUnscaledDelta();
+    return (m_inFixedUpdate || m_resimulating) ? GetTimeStep() : m_time.GetUnscaledDelta();
 }
 
 inline const Uint64 Scene::GetUnscaledDeltaMS() const
 {
-    return m_inFixedUpdate ? m_timeStepMS : m_time.GetUnscaledDeltaMS();
+    return (m_inFixedUpdate || m_resimulating) ? GetTimeStepMS() : m_time.GetUnscaledDeltaMS();
+}
+
+inline const Uint64 Scene::GetUnscaledDeltaNS() const
+{
+    return (m_inFixedUpdate || m_resimulating) ? m_timeStepNS : m_time.GetUnscaledDeltaNS();
+}
+
+inline Uint64 Scene::GetFixedStepCount() const
+{
+    return m_fixedStepCount;
+}
+
+inline const float Scene::GetFixedElapsed() const
+{
+    return static_cast<float>((double)(m_fixedStepCount * m_timeStepNS) / 1e9);
 }
 
 inline const float Scene::GetTimeStep() const
 {
-    return static_cast<float>(m_timeStepMS) / 1000.f;
+    return static_cast<float>((double)m_timeStepNS / 1e9);
 }
 
 inline const Uint64 Scene::GetTimeStepMS() const
 {
-    return m_timeStepMS;
+    return SDL_NS_TO_MS(m_timeStepNS);
+}
+
+inline const Uint64 Scene::GetTimeStepNS() const
+{
+    return m_timeStepNS;
+}
+
+inline float Scene::GetTickRate() const
+{
+    return m_tickRate;
+}
+
+inline void Scene::SetMaxStepsPerFrame(int maxSteps)
+{
+    m_maxStepsPerFrame = std::max(1, maxSteps);
+}
+
+inline int Scene::GetMaxStepsPerFrame() const
+{
+    return m_maxStepsPerFrame;
+}
+
+inline const Scene::FixedStepStats &Scene::GetFixedStepStats() const
+{
+    return m_fixedStepStats;
 }
 
 inline Scene::UpdateMode Scene::GetUpdateMode() const
@@ -378,6 +615,17 @@ inline void Scene::MakeStep()
     m_makeStep = true;
 }
 
+inline void Scene::SetNextDeltaMS(Uint64 deltaMS)
+{
+    SetNextDeltaNS(SDL_MS_TO_NS(deltaMS));
+}
+
+inline void Scene::SetNextDeltaNS(Uint64 deltaNS)
+{
+    m_nextDeltaNS = deltaNS;
+    m_hasNextDelta = true;
+}
+
 inline bool Scene::Contains(UIObject *gameObject) const
 {
     return m_uiObjectManager.Contains(gameObject);
@@ -388,12 +636,74 @@ inline Uint64 Scene::GetUpdateID() const
     return m_updateID;
 }
 
-struct QueryGizmos
+inline RandomStream &Scene::GetRandom()
 {
-    QueryGizmos(Color color, GizmosShape shape) :
-        m_color(color), m_shape(shape) { }
+    return m_random;
+}
 
-    Color m_color;
-    GizmosShape m_shape;
-};
+inline RandomStream &Scene::GetCosmeticRandom()
+{
+    return m_cosmeticRandom;
+}
+
+inline const std::vector<std::string> &Scene::GetStateHashCategories() const
+{
+    return m_stateHashNames;
+}
+
+inline void Scene::SetStateHashEnabled(bool enabled)
+{
+    m_stateHashEnabled = enabled;
+}
+
+inline bool Scene::IsStateHashEnabled() const
+{
+    return m_stateHashEnabled;
+}
+
+inline const TickHash &Scene::GetStateHash() const
+{
+    return m_stateHash;
+}
+
+inline float Scene::GetStateHashTimeMS() const
+{
+    return m_stateHashTimeMS;
+}
+
+inline void Scene::SetStateHashLog(StateHashLog *log)
+{
+    m_stateHashLog = log;
+}
+
+inline void Scene::SetSystemProfiler(SystemProfiler *profiler)
+{
+    m_systemProfiler = profiler;
+}
+
+inline SystemProfiler *Scene::GetSystemProfiler()
+{
+    return m_systemProfiler;
+}
+
+inline bool Scene::IsResimulating() const
+{
+    return m_resimulating;
+}
+
+inline void Scene::SetQueryGizmosEnabled(bool enabled)
+{
+    m_queryGizmosEnabled = enabled;
+    if (enabled == false) m_queryGizmos.Clear();
+}
+
+inline bool Scene::GetQueryGizmosEnabled() const
+{
+    return m_queryGizmosEnabled;
+}
+
+inline const GizmosBuffer &Scene::GetQueryGizmos() const
+{
+    return m_queryGizmos;
+}
 
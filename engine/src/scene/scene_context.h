@@ -0,0 +1,67 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "game_engine_common.h"
+
+/// @brief Dépendances d'une scène envers le reste du programme.
+/// Chaque scène possède son propre contexte : plusieurs scènes sans rendu
+/// peuvent ainsi être mises à jour en même temps sur des threads différents.
+struct SceneContext
+{
+    /// @brief Fréquence par défaut de la simulation (pas fixes par seconde).
+    static constexpr float DEFAULT_TICK_RATE = 60.f;
+
+    /// @brief Contexte d'une scène affichée, qui utilise le moteur de rendu
+    /// et le moteur de texte du jeu.
+    SceneContext();
+
+    /// @brief Contexte d'une scène sans rendu, sans son et sans lecture
+    /// des événements SDL. Elle peut être mise à jour sur n'importe quel thread.
+    /// @param userData les données propres à l'application.
+    static SceneContext Headless(void *userData = nullptr);
+
+    SDL_Renderer *renderer;
+    TTF_TextEngine *textEngine;
+    bool headless;
+
+    /// @brief Cache des assets partagé entre les scènes (nullptr pour ne pas en utiliser).
+    AssetCache *assetCache;
+
+    /// @brief Graine des générateurs aléatoires de la scène.
+    /// Si elle est nulle, une graine différente est tirée à chaque création.
+    uint64_t seed;
+
+    /// @brief Fréquence de la simulation (pas fixes par seconde).
+    float tickRate;
+
+    /// @brief Données propres à l'application (configuration du match...).
+    void *userData;
+};
+
+inline SceneContext::SceneContext()
+    : renderer(g_renderer)
+    , textEngine(g_textEngine)
+    , headless(false)
+    , assetCache(g_assetCache)
+    , seed(0)
+    , tickRate(DEFAULT_TICK_RATE)
+    , userData(nullptr)
+{
+}
+
+inline SceneContext SceneContext::Headless(void *userData)
+{
+    SceneContext context;
+    context.renderer = nullptr;
+    context.textEngine = nullptr;
+    context.headless = true;
+    context.assetCache = nullptr;
+    context.userData = userData;
+    return context;
+}
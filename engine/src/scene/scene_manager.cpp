@@ -6,8 +6,8 @@
 
 #include "scene/scene_manager.h"
 
-SceneManager::SceneManager(InputManager *inputManager)
-    : m_scene(this, inputManager)
+SceneManager::SceneManager(InputManager *inputManager, const SceneContext &context)
+    : m_scene(this, inputManager, context)
     , m_shouldQuitScene(false)
     , m_shouldQuitGame(false)
     , m_willQuitScene(false)
@@ -42,7 +42,7 @@ void SceneManager::QuitScene()
 
     m_fillFader->PlayFadeIn();
     m_willQuitScene = true;
-    Mix_FadeOutMusic(1000);
+    m_scene.GetAssetManager()->FadeOutMusic(1000);
 }
 
 void SceneManager::QuitGame()
@@ -52,7 +52,7 @@ void SceneManager::QuitGame()
     m_fillFader->PlayFadeIn();
     m_willQuitScene = true;
     m_willQuitGame = true;
-    Mix_FadeOutMusic(1000);
+    m_scene.GetAssetManager()->FadeOutMusic(1000);
 }
 
 void SceneManager::OnFadeInEnd(UIObject *which)
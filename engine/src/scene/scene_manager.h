@@ -14,7 +14,7 @@
 class SceneManager : public UIAnimListener
 {
 public:
-    SceneManager(InputManager *inputManager);
+    SceneManager(InputManager *inputManager, const SceneContext &context = SceneContext());
     virtual ~SceneManager();
 
     virtual void OnSceneUpdate();
@@ -0,0 +1,590 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/scene_snapshot.h"
+#include "scene/scene.h"
+
+namespace
+{
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x504E5353; // "SSNP"
+    constexpr uint16_t SNAPSHOT_VERSION = 4;
+
+    using EntityType = std::underlying_type_t<entt::entity>;
+
+    struct BodyState
+    {
+        b2BodyType type;
+        b2Transform xf;
+        b2Vec2 linearVelocity;
+        float angularVelocity;
+        float linearDamping;
+        float angularDamping;
+        float gravityScale;
+        bool isAwake;
+        bool isEnabled;
+        bool fixedRotation;
+        bool isBullet;
+        bool enableSleep;
+    };
+
+    struct ShapeState
+    {
+        b2ShapeType type;
+        union
+        {
+            b2Circle circle;
+            b2Capsule capsule;
+            b2Polygon polygon;
+            b2Segment segment;
+        };
+        float density;
+        float friction;
+        float restitution;
+        int material;
+        b2Filter filter;
+        bool isSensor;
+        bool enableSensorEvents;
+        bool enableContactEvents;
+        bool enablePreSolveEvents;
+        bool enableHitEvents;
+    };
+
+    constexpr int MAX_SHAPE_COUNT = 8;
+
+    BodyState GetBodyState(b2BodyId bodyId)
+    {
+        BodyState state = {};
+        state.type = b2Body_GetType(bodyId);
+        state.xf = b2Body_GetTransform(bodyId);
+        state.linearVelocity = b2Body_GetLinearVelocity(bodyId);
+        state.angularVelocity = b2Body_GetAngularVelocity(bodyId);
+        state.linearDamping = b2Body_GetLinearDamping(bodyId);
+        state.angularDamping = b2Body_GetAngularDamping(bodyId);
+        state.gravityScale = b2Body_GetGravityScale(bodyId);
+        state.isAwake = b2Body_IsAwake(bodyId);
+        state.isEnabled = b2Body_IsEnabled(bodyId);
+        state.fixedRotation = b2Body_IsFixedRotation(bodyId);
+        state.isBullet = b2Body_IsBullet(bodyId);
+        state.enableSleep = b2Body_IsSleepEnabled(bodyId);
+        return state;
+    }
+
+    void SetBodyState(b2BodyId bodyId, const BodyState &state)
+    {
+        if (b2Body_GetType(bodyId) != state.type) b2Body_SetType(bodyId, state.type);
+
+        if (state.isEnabled) b2Body_Enable(bodyId);
+        else b2Body_Disable(bodyId);
+
+        b2Body_SetTransform(bodyId, state.xf.p, state.xf.q);
+        b2Body_SetLinearVelocity(bodyId, state.linearVelocity);
+        b2Body_SetAngularVelocity(bodyId, state.angularVelocity);
+        b2Body_SetLinearDamping(bodyId, state.linearDamping);
+        b2Body_SetAngularDamping(bodyId, state.angularDamping);
+        b2Body_SetGravityScale(bodyId, state.gravityScale);
+        b2Body_SetFixedRotation(bodyId, state.fixedRotation);
+        b2Body_SetBullet(bodyId, state.isBullet);
+        b2Body_EnableSleep(bodyId, state.enableSleep);
+        if (state.isEnabled) b2Body_SetAwake(bodyId, state.isAwake);
+    }
+
+    /// @brief Aligne la transformation interpolée sur celle du corps restauré.
+    /// b2Body_SetTransform() ne produit pas d'événement de mouvement : sans
+    /// cela, TransformSystem interpolerait une frame vers l'ancienne position.
+    void SyncFixedTransform(entt::registry &registry, entt::entity entity, const b2Transform &xf)
+    {
+        FixedUpdateTransform *fixedTransform = registry.try_get<FixedUpdateTransform>(entity);
+        if (fixedTransform == nullptr) return;
+
+        // Conserve l'interpolation si le composant restauré est déjà à jour
+        const b2Transform &currXf = fixedTransform->currXf;
+        if (currXf.p.x == xf.p.x && currXf.p.y == xf.p.y
+            && currXf.q.c == xf.q.c && currXf.q.s == xf.q.s)
+        {
+            return;
+        }
+        fixedTransform->Set(xf);
+    }
+
+    bool GetShapeState(b2ShapeId shapeId, ShapeState &state)
+    {
+        state = {};
+        state.type = b2Shape_GetType(shapeId);
+        switch (state.type)
+        {
+        case b2_circleShape:  state.circle = b2Shape_GetCircle(shapeId); break;
+        case b2_capsuleShape: state.capsule = b2Shape_GetCapsule(shapeId); break;
+        case b2_polygonShape: state.polygon = b2Shape_GetPolygon(shapeId); break;
+        case b2_segmentShape: state.segment = b2Shape_GetSegment(shapeId); break;
+        default: return false;
+        }
+        state.density = b2Shape_GetDensity(shapeId);
+        state.friction = b2Shape_GetFriction(shapeId);
+        state.restitution = b2Shape_GetRestitution(shapeId);
+        state.material = b2Shape_GetMaterial(shapeId);
+        state.filter = b2Shape_GetFilter(shapeId);
+        state.isSensor = b2Shape_IsSensor(shapeId);
+        state.enableSensorEvents = b2Shape_AreSensorEventsEnabled(shapeId);
+        state.enableContactEvents = b2Shape_AreContactEventsEnabled(shapeId);
+        state.enablePreSolveEvents = b2Shape_ArePreSolveEventsEnabled(shapeId);
+        state.enableHitEvents = b2Shape_AreHitEventsEnabled(shapeId);
+        return true;
+    }
+
+    void CreateShape(b2BodyId bodyId, const ShapeState &state)
+    {
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        shapeDef.density = state.density;
+        shapeDef.material.friction = state.friction;
+        shapeDef.material.restitution = state.restitution;
+        shapeDef.material.userMaterialId = state.material;
+        shapeDef.filter = state.filter;
+        shapeDef.isSensor = state.isSensor;
+        shapeDef.enableSensorEvents = state.enableSensorEvents;
+        shapeDef.enableContactEvents = state.enableContactEvents;
+        shapeDef.enablePreSolveEvents = state.enablePreSolveEvents;
+        shapeDef.enableHitEvents = state.enableHitEvents;
+
+        switch (state.type)
+        {
+        case b2_circleShape:  b2CreateCircleShape(bodyId, &shapeDef, &state.circle); break;
+        case b2_capsuleShape: b2CreateCapsuleShape(bodyId, &shapeDef, &state.capsule); break;
+        case b2_polygonShape: b2CreatePolygonShape(bodyId, &shapeDef, &state.polygon); break;
+        case b2_segmentShape: b2CreateSegmentShape(bodyId, &shapeDef, &state.segment); break;
+        default: break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Archives
+
+void SnapshotWriter::WriteBytes(const void *src, size_t size)
+{
+    const size_t offset = m_data.size();
+    m_data.resize(offset + size);
+    memcpy(m_data.data() + offset, src, size);
+}
+
+void SnapshotWriter::Write(const std::string &value)
+{
+    Write((uint32_t)value.size());
+    WriteBytes(value.data(), value.size());
+}
+
+void SnapshotWriter::Write(const NameComponent &value)
+{
+    Write(value.name);
+}
+
+void SnapshotWriter::Write(const TilemapRenderer &value)
+{
+    Write((uint32_t)value.tiles.size());
+    WriteBytes(value.tiles.data(), value.tiles.size() * sizeof(Sprite));
+    Write(value.scale);
+}
+
+bool SnapshotReader::ReadBytes(void *dst, size_t size)
+{
+    if (m_valid == false || m_readPos + size > m_data.size())
+    {
+        m_valid = false;
+        return false;
+    }
+    memcpy(dst, m_data.data() + m_readPos, size);
+    m_readPos += size;
+    return true;
+}
+
+bool SnapshotReader::Read(std::string &value)
+{
+    uint32_t size = 0;
+    if (Read(size) == false || m_readPos + size > m_data.size())
+    {
+        m_valid = false;
+        return false;
+    }
+    value.assign((const char *)m_data.data() + m_readPos, size);
+    m_readPos += size;
+    return true;
+}
+
+bool SnapshotReader::Read(NameComponent &value)
+{
+    return Read(value.name);
+}
+
+bool SnapshotReader::Read(TilemapRenderer &value)
+{
+    uint32_t count = 0;
+    if (Read(count) == false || m_readPos + count * sizeof(Sprite) > m_data.size())
+    {
+        m_valid = false;
+        return false;
+    }
+    value.tiles.resize(count);
+    ReadBytes(value.tiles.data(), count * sizeof(Sprite));
+    return Read(value.scale);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Snapshot
+
+SceneSnapshot::SceneSnapshot()
+    : m_data()
+    , m_writer(m_data)
+    , m_reader(m_data)
+{
+}
+
+void SceneSnapshot::Clear()
+{
+    m_data.clear();
+    m_reader.Rewind();
+}
+
+entt::registry &SceneSnapshot::GetRegistry(Scene *scene)
+{
+    return scene->GetRegistry();
+}
+
+void SceneSnapshot::CaptureHeader(Scene *scene)
+{
+    m_writer.Write(SNAPSHOT_MAGIC);
+    m_writer.Write(SNAPSHOT_VERSION);
+}
+
+void SceneSnapshot::CaptureBodies(Scene *scene)
+{
+    auto view = scene->GetRegistry().view<const Rigidbody>();
+    std::array<b2ShapeId, MAX_SHAPE_COUNT> shapeIds = {};
+
+    m_writer.Write((uint32_t)view.size());
+    for (auto [entity, rigidbody] : view.each())
+    {
+        const b2BodyId bodyId = rigidbody.bodyId;
+        const bool isValid = b2Body_IsValid(bodyId);
+        m_writer.Write(entity);
+        m_writer.Write(bodyId);
+        m_writer.Write(isValid);
+        if (isValid == false) continue;
+
+        const BodyState state = GetBodyState(bodyId);
+        m_writer.Write(state);
+
+        // Les formes permettent de recréer le corps s'il est détruit après la capture.
+        // Les corps statiques (terrain) ne sont jamais détruits pendant un match.
+        uint8_t shapeCount = 0;
+        if (state.type != b2_staticBody)
+        {
+            shapeCount = (uint8_t)b2Body_GetShapes(bodyId, shapeIds.data(), MAX_SHAPE_COUNT);
+        }
+        m_writer.Write(shapeCount);
+        for (int i = 0; i < shapeCount; i++)
+        {
+            ShapeState shapeState;
+            if (GetShapeState(shapeIds[i], shapeState) == false)
+            {
+                shapeState.type = b2_shapeTypeCount;
+            }
+            m_writer.Write(shapeState);
+        }
+    }
+}
+
+void SceneSnapshot::CaptureParticles(Scene *scene)
+{
+    const auto &particlePools = scene->m_particleSystem.particlePools;
+
+    m_writer.Write((uint32_t)particlePools.size());
+    for (const auto &[layer, particles] : particlePools)
+    {
+        m_writer.Write(layer);
+        m_writer.Write((uint32_t)particles.size());
+        for (const Particle &particle : particles)
+        {
+            m_writer.Write(particle.lifetime);
+            m_writer.Write(particle.remainingLifetime);
+            m_writer.Write(particle.startSize);
+            m_writer.Write(particle.opacity);
+            m_writer.Write(particle.angle);
+            m_writer.Write(particle.angularVelocity);
+            m_writer.Write(particle.pixPerUnit);
+            m_writer.Write(particle.animState);
+            m_writer.Write(particle.anchor);
+            m_writer.Write(particle.flip);
+            m_writer.Write(particle.blendMode);
+            m_writer.Write(particle.velocity);
+            m_writer.Write(particle.position);
+            m_writer.Write(particle.gravity);
+            m_writer.Write(particle.damping);
+            m_writer.Write(particle.alphaState);
+            m_writer.Write(particle.scaleState);
+            m_writer.Write(particle.alphaValues);
+            m_writer.Write(particle.scaleValues);
+        }
+    }
+}
+
+void SceneSnapshot::CaptureTime(Scene *scene)
+{
+    m_writer.Write(scene->m_fixedStepCount);
+    m_writer.Write(scene->m_random.GetState());
+    m_writer.Write(scene->m_cosmeticRandom.GetState());
+
+    const Timer &time = scene->m_time;
+    m_writer.Write(time.m_delta);
+    m_writer.Write(time.m_unscaledDelta);
+    m_writer.Write(time.m_elapsed);
+    m_writer.Write(time.m_unscaledElapsed);
+    m_writer.Write(scene->m_stepAccuNS);
+    m_writer.Write(scene->m_alpha);
+}
+
+bool SceneSnapshot::RestoreHeader(Scene *scene)
+{
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    m_reader.Read(magic);
+    m_reader.Read(version);
+    return m_reader.IsValid() && magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION;
+}
+
+bool SceneSnapshot::RestoreEntities(Scene *scene)
+{
+    entt::registry &registry = scene->GetRegistry();
+    auto &entityStorage = registry.storage<entt::entity>();
+
+    EntityType length = 0;
+    EntityType inUseCount = 0;
+    m_reader.Read(length);
+    m_reader.Read(inUseCount);
+    if (m_reader.IsValid() == false || inUseCount > length) return false;
+
+    std::vector<entt::entity> entities(length);
+    if (m_reader.ReadBytes(entities.data(), length * sizeof(entt::entity)) == false) return false;
+
+    entt::sparse_set captured;
+    captured.reserve(inUseCount);
+    for (EntityType i = 0; i < inUseCount; i++)
+    {
+        captured.push(entities[i]);
+    }
+
+    // Détruit les entités créées depuis la capture
+    // (leurs corps physiques sont détruits par RigidbodyUtils::Destroy)
+    std::vector<entt::entity> created;
+    for (auto [entity] : entityStorage.each())
+    {
+        if (captured.contains(entity) == false) created.push_back(entity);
+    }
+    registry.destroy(created.begin(), created.end());
+
+    // Reconstruit la liste des identifiants à l'identique, y compris les
+    // identifiants libres, pour que les prochaines créations d'entités
+    // donnent les mêmes identifiants qu'après la capture.
+    // Les composants des entités toujours vivantes ne sont pas modifiés.
+    entt::entity placeholder = entt::null;
+    entityStorage.clear();
+    entityStorage.reserve(length);
+    for (entt::entity entity : entities)
+    {
+        entityStorage.generate(entity);
+        placeholder = (placeholder == entt::null || entity > placeholder) ? entity : placeholder;
+    }
+    if (placeholder != entt::null)
+    {
+        entityStorage.start_from(entt::entt_traits<entt::entity>::next(placeholder));
+    }
+    entityStorage.free_list(inUseCount);
+    return true;
+}
+
+bool SceneSnapshot::RestoreBodies(Scene *scene)
+{
+    entt::registry &registry = scene->GetRegistry();
+    b2WorldId worldId = scene->GetWorld();
+    auto &storage = registry.storage<Rigidbody>();
+
+    uint32_t count = 0;
+    if (m_reader.Read(count) == false) return false;
+
+    entt::sparse_set captured;
+    captured.reserve(count);
+    std::array<ShapeState, MAX_SHAPE_COUNT> shapeStates = {};
+    bool success = true;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        entt::entity entity = entt::null;
+        b2BodyId bodyId = b2_nullBodyId;
+        bool isValid = false;
+        m_reader.Read(entity);
+        m_reader.Read(bodyId);
+        m_reader.Read(isValid);
+        if (m_reader.IsValid() == false) return false;
+
+        captured.push(entity);
+        if (isValid == false) continue;
+
+        BodyState state = {};
+        uint8_t shapeCount = 0;
+        m_reader.Read(state);
+        m_reader.Read(shapeCount);
+        if (m_reader.IsValid() == false || shapeCount > MAX_SHAPE_COUNT) return false;
+
+        for (int k = 0; k < shapeCount; k++)
+        {
+            m_reader.Read(shapeStates[k]);
+        }
+        if (m_reader.IsValid() == false) return false;
+
+        // Le corps existe toujours
+        Rigidbody *rigidbody = storage.contains(entity) ? &storage.get(entity) : nullptr;
+        if (rigidbody && B2_ID_EQUALS(rigidbody->bodyId, bodyId) && b2Body_IsValid(bodyId))
+        {
+            SetBodyState(bodyId, state);
+            SyncFixedTransform(registry, entity, state.xf);
+            continue;
+        }
+
+        // Le corps a été détruit depuis la capture
+        if (rigidbody) registry.remove<Rigidbody>(entity);
+
+        if (shapeCount == 0)
+        {
+            std::cout << "ERROR - Snapshot cannot recreate the body of entity "
+                << (EntityType)entity << std::endl;
+            success = false;
+            continue;
+        }
+
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = state.type;
+        bodyDef.position = state.xf.p;
+        bodyDef.rotation = state.xf.q;
+        b2BodyId newBodyId = b2CreateBody(worldId, &bodyDef);
+        for (int k = 0; k < shapeCount; k++)
+        {
+            CreateShape(newBodyId, shapeStates[k]);
+        }
+        SetBodyState(newBodyId, state);
+
+        registry.emplace<Rigidbody>(entity, newBodyId);
+        SyncFixedTransform(registry, entity, state.xf);
+    }
+
+    // Supprime les corps créés depuis la capture
+    std::vector<entt::entity> added;
+    for (entt::entity entity : static_cast<const entt::sparse_set &>(storage))
+    {
+        if (captured.contains(entity) == false) added.push_back(entity);
+    }
+    for (entt::entity entity : added)
+    {
+        registry.remove<Rigidbody>(entity);
+    }
+    return success;
+}
+
+bool SceneSnapshot::RestoreParticles(Scene *scene, bool apply)
+{
+    // Les particules sont lues même si elles ne sont pas restaurées
+    // pour atteindre les données suivantes.
+    std::map<int, std::vector<Particle>> ignoredPools;
+    auto &particlePools = apply ? scene->m_particleSystem.particlePools : ignoredPools;
+    for (auto &[layer, particles] : particlePools)
+    {
+        particles.clear();
+    }
+
+    uint32_t poolCount = 0;
+    if (m_reader.Read(poolCount) == false) return false;
+
+    for (uint32_t i = 0; i < poolCount; i++)
+    {
+        int layer = 0;
+        uint32_t particleCount = 0;
+        m_reader.Read(layer);
+        m_reader.Read(particleCount);
+        if (m_reader.IsValid() == false) return false;
+
+        std::vector<Particle> &particles = particlePools[layer];
+        particles.reserve(particleCount);
+        for (uint32_t k = 0; k < particleCount; k++)
+        {
+            Particle particle(0);
+            m_reader.Read(particle.lifetime);
+            m_reader.Read(particle.remainingLifetime);
+            m_reader.Read(particle.startSize);
+            m_reader.Read(particle.opacity);
+            m_reader.Read(particle.angle);
+            m_reader.Read(particle.angularVelocity);
+            m_reader.Read(particle.pixPerUnit);
+            m_reader.Read(particle.animState);
+            m_reader.Read(particle.anchor);
+            m_reader.Read(particle.flip);
+            m_reader.Read(particle.blendMode);
+            m_reader.Read(particle.velocity);
+            m_reader.Read(particle.position);
+            m_reader.Read(particle.gravity);
+            m_reader.Read(particle.damping);
+            m_reader.Read(particle.alphaState);
+            m_reader.Read(particle.scaleState);
+            m_reader.Read(particle.alphaValues);
+            m_reader.Read(particle.scaleValues);
+            if (m_reader.IsValid() == false) return false;
+
+            particles.push_back(particle);
+        }
+    }
+    return true;
+}
+
+bool SceneSnapshot::RestoreTime(Scene *scene, bool restoreFrameTime)
+{
+    m_reader.Read(scene->m_fixedStepCount);
+
+    RandomStream::State randomState = {}, cosmeticState = {};
+    m_reader.Read(randomState);
+    m_reader.Read(cosmeticState);
+    scene->m_random.SetState(randomState);
+
+    Uint64 delta = 0, unscaledDelta = 0, elapsed = 0, unscaledElapsed = 0, stepAccuNS = 0;
+    float alpha = 0.f;
+    m_reader.Read(delta);
+    m_reader.Read(unscaledDelta);
+    m_reader.Read(elapsed);
+    m_reader.Read(unscaledElapsed);
+    m_reader.Read(stepAccuNS);
+    m_reader.Read(alpha);
+    if (m_reader.IsValid() == false) return false;
+
+    if (restoreFrameTime)
+    {
+        Timer &time = scene->m_time;
+        time.m_delta = delta;
+        time.m_unscaledDelta = unscaledDelta;
+        time.m_elapsed = elapsed;
+        time.m_unscaledElapsed = unscaledElapsed;
+        scene->m_stepAccuNS = stepAccuNS;
+        scene->m_alpha = alpha;
+        scene->m_cosmeticRandom.SetState(cosmeticState);
+    }
+
+    // La restauration compte comme une nouvelle mise à jour pour que les
+    // caches basés sur les numéros de mise à jour traitent tous les objets.
+    const Uint64 updateID = ++scene->m_updateID;
+    for (auto [entity, transform] : scene->m_registry.view<Transform>().each())
+    {
+        transform.updateID = updateID;
+    }
+    for (auto [entity, sprite] : scene->m_registry.view<Sprite>().each())
+    {
+        sprite.updateID = updateID;
+    }
+    return true;
+}
@@ -0,0 +1,309 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "ecs/basic_components.h"
+
+#include <bit>
+
+class Scene;
+
+/// @brief Archive binaire écrivant à la fin d'un buffer contigu.
+/// Elle est utilisée comme archive de sortie par entt::snapshot.
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(std::vector<uint8_t> &data) : m_data(data) {}
+
+    void WriteBytes(const void *src, size_t size);
+
+    template <typename T>
+    void Write(const T &value);
+    void Write(const std::string &value);
+    void Write(const NameComponent &value);
+    void Write(const TilemapRenderer &value);
+
+    template <typename T>
+    void operator()(const T &value);
+
+private:
+    std::vector<uint8_t> &m_data;
+};
+
+/// @brief Archive binaire lisant un buffer écrit par un SnapshotWriter.
+/// Une lecture au-delà de la fin du buffer invalide l'archive.
+class SnapshotReader
+{
+public:
+    SnapshotReader(const std::vector<uint8_t> &data) : m_data(data), m_readPos(0), m_valid(true) {}
+
+    bool ReadBytes(void *dst, size_t size);
+
+    template <typename T>
+    bool Read(T &value);
+    bool Read(std::string &value);
+    bool Read(NameComponent &value);
+    bool Read(TilemapRenderer &value);
+
+    /// @brief Lit une valeur qui n'a pas forcément de constructeur par défaut.
+    template <typename T>
+    T ReadValue();
+
+    bool IsValid() const;
+    void Rewind();
+
+private:
+    const std::vector<uint8_t> &m_data;
+    size_t m_readPos;
+    bool m_valid;
+};
+
+/// @brief Composants du moteur sauvegardés par défaut dans un SceneSnapshot.
+/// Le Rigidbody n'en fait pas partie : les corps physiques sont toujours sauvegardés.
+using BasicSnapshotComponents = entt::type_list<
+    NameComponent, Transform, FixedUpdateTransform, LocalTransform,
+    RenderSortingLayer, RenderBlendMod, RenderColorMod,
+    Sprite, SpriteAnimState, TiledSprite, TilemapRenderer, BackgroundLayer,
+    Camera
+>;
+
+/// @brief Sauvegarde rapide de l'état d'une scène dans un buffer contigu.
+///
+/// Le snapshot contient les entités et les composants choisis (via entt::snapshot),
+/// l'état de chaque corps Box2D (transformation, vitesses, gravité, réveil),
+/// les particules, les compteurs de temps et les générateurs aléatoires de la scène.
+///
+/// La restauration se fait sur place dans la même scène : les identifiants
+/// des entités sont conservés, les entités créées depuis la capture sont détruites
+/// et les corps physiques détruits depuis la capture sont recréés à partir de
+/// leurs formes (sauf les corps statiques). Les contacts ne sont pas sauvegardés,
+/// Box2D les reconstruit au pas suivant.
+///
+/// Les composants qui ne figurent pas dans la liste ne sont pas modifiés.
+class SceneSnapshot
+{
+public:
+    SceneSnapshot();
+
+    enum class RestoreMode
+    {
+        /// @brief Restaure tout le contenu du snapshot.
+        FULL,
+        /// @brief Restaure uniquement l'état de la simulation. Les particules,
+        /// les compteurs de temps de la frame courante et le générateur
+        /// aléatoire des effets sont conservés.
+        SIMULATION
+    };
+
+    /// @brief Capture l'état de la scène. Le contenu précédent est effacé.
+    /// Des données supplémentaires peuvent être ajoutées avec GetWriter().
+    /// @param scene la scène.
+    /// @param components la liste des composants à sauvegarder.
+    template <typename... Component>
+    void Capture(Scene *scene, entt::type_list<Component...> components);
+
+    /// @brief Restaure l'état de la scène capturé avec Capture().
+    /// Les données supplémentaires peuvent ensuite être lues avec GetReader().
+    /// @param scene la scène ayant été capturée.
+    /// @param components la même liste de composants que lors de la capture.
+    /// @param mode les éléments à restaurer.
+    /// @return false si le snapshot est vide ou invalide.
+    template <typename... Component>
+    bool Restore(
+        Scene *scene, entt::type_list<Component...> components,
+        RestoreMode mode = RestoreMode::FULL);
+
+    SnapshotWriter &GetWriter();
+    SnapshotReader &GetReader();
+
+    bool IsEmpty() const;
+    size_t GetSize() const;
+    void Clear();
+
+private:
+    std::vector<uint8_t> m_data;
+    SnapshotWriter m_writer;
+    SnapshotReader m_reader;
+
+    void CaptureHeader(Scene *scene);
+    void CaptureBodies(Scene *scene);
+    void CaptureParticles(Scene *scene);
+    void CaptureTime(Scene *scene);
+
+    bool RestoreHeader(Scene *scene);
+    bool RestoreEntities(Scene *scene);
+    bool RestoreBodies(Scene *scene);
+    bool RestoreParticles(Scene *scene, bool apply);
+    bool RestoreTime(Scene *scene, bool restoreFrameTime);
+
+    template <typename T>
+    bool RestoreComponents(entt::registry &registry);
+
+    static entt::registry &GetRegistry(Scene *scene);
+};
+
+template <typename T>
+inline void SnapshotWriter::Write(const T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshot components must be trivially copyable");
+    WriteBytes(&value, sizeof(T));
+}
+
+template <typename T>
+inline void SnapshotWriter::operator()(const T &value)
+{
+    Write(value);
+}
+
+template <typename T>
+inline bool SnapshotReader::Read(T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshot components must be trivially copyable");
+    return ReadBytes(&value, sizeof(T));
+}
+
+template <typename T>
+inline T SnapshotReader::ReadValue()
+{
+    if constexpr (std::is_default_constructible_v<T>)
+    {
+        T value{};
+        Read(value);
+        return value;
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot components must be trivially copyable");
+        std::array<uint8_t, sizeof(T)> bytes{};
+        ReadBytes(bytes.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+}
+
+inline bool SnapshotReader::IsValid() const
+{
+    return m_valid;
+}
+
+inline void SnapshotReader::Rewind()
+{
+    m_readPos = 0;
+    m_valid = true;
+}
+
+inline SnapshotWriter &SceneSnapshot::GetWriter()
+{
+    return m_writer;
+}
+
+inline SnapshotReader &SceneSnapshot::GetReader()
+{
+    return m_reader;
+}
+
+inline bool SceneSnapshot::IsEmpty() const
+{
+    return m_data.empty();
+}
+
+inline size_t SceneSnapshot::GetSize() const
+{
+    return m_data.size();
+}
+
+template <typename... Component>
+inline void SceneSnapshot::Capture(Scene *scene, entt::type_list<Component...> components)
+{
+    m_data.clear();
+    CaptureHeader(scene);
+
+    entt::snapshot snapshot{ GetRegistry(scene) };
+    snapshot.get<entt::entity>(m_writer);
+    (snapshot.get<Component>(m_writer), ...);
+
+    CaptureBodies(scene);
+    CaptureParticles(scene);
+    CaptureTime(scene);
+}
+
+template <typename... Component>
+inline bool SceneSnapshot::Restore(
+    Scene *scene, entt::type_list<Component...> components, RestoreMode mode)
+{
+    m_reader.Rewind();
+    if (m_data.empty() || RestoreHeader(scene) == false)
+    {
+        std::cout << "ERROR - Invalid scene snapshot" << std::endl;
+        return false;
+    }
+
+    entt::registry &registry = GetRegistry(scene);
+    bool success = RestoreEntities(scene);
+    success = success && (RestoreComponents<Component>(registry) && ...);
+    success = success && RestoreBodies(scene);
+    success = success && RestoreParticles(scene, mode == RestoreMode::FULL);
+    success = success && RestoreTime(scene, mode == RestoreMode::FULL);
+
+    if (success == false)
+    {
+        std::cout << "ERROR - Corrupted scene snapshot" << std::endl;
+    }
+    return success;
+}
+
+template <typename T>
+inline bool SceneSnapshot::RestoreComponents(entt::registry &registry)
+{
+    using EntityType = std::underlying_type_t<entt::entity>;
+
+    EntityType count = 0;
+    if (m_reader.Read(count) == false) return false;
+
+    auto &storage = registry.storage<T>();
+    constexpr bool isEmpty = std::is_empty_v<T>;
+
+    // Entités possédant le composant lors de la capture
+    entt::sparse_set captured;
+    captured.reserve(count);
+
+    for (EntityType i = 0; i < count; i++)
+    {
+        entt::entity entity = entt::null;
+        if (m_reader.Read(entity) == false) return false;
+        if (entity == entt::null) continue;
+
+        captured.push(entity);
+
+        if constexpr (isEmpty)
+        {
+            if (storage.contains(entity) == false) registry.emplace<T>(entity);
+        }
+        else if (storage.contains(entity))
+        {
+            if (m_reader.Read(storage.get(entity)) == false) return false;
+        }
+        else
+        {
+            T value = m_reader.ReadValue<T>();
+            if (m_reader.IsValid() == false) return false;
+            registry.emplace<T>(entity, std::move(value));
+        }
+    }
+
+    // Supprime les composants ajoutés depuis la capture
+    std::vector<entt::entity> added;
+    for (entt::entity entity : static_cast<const entt::sparse_set &>(storage))
+    {
+        if (captured.contains(entity) == false) added.push_back(entity);
+    }
+    for (entt::entity entity : added)
+    {
+        registry.remove<T>(entity);
+    }
+    return true;
+}
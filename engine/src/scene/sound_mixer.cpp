@@ -0,0 +1,295 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/sound_mixer.h"
+#include "utils/simd_math.h"
+#include "utils/utils.h"
+
+SoundParams::SoundParams(int priority, float volume)
+    : priority(priority)
+    , volume(volume)
+    , positional(false)
+    , position(b2Vec2_zero)
+    , loops(0)
+{
+}
+
+SoundParams SoundParams::At(b2Vec2 position, int priority, float volume)
+{
+    SoundParams params(priority, volume);
+    params.positional = true;
+    params.position = position;
+    return params;
+}
+
+SoundMixer::Stats::Stats()
+    : activeVoiceCount(0)
+    , requestCount(0)
+    , mergedCount(0)
+    , stolenCount(0)
+    , droppedCount(0)
+    , mixTimeNS(0)
+    , mixCallCount(0)
+{
+}
+
+SoundMixer::Voice::Voice(SoundMixer *mixer, int channel)
+    : mixer(mixer)
+    , channel(channel)
+    , soundID(-1)
+    , priority(0)
+    , startID(0)
+    , leftGain(1.f)
+    , rightGain(1.f)
+{
+}
+
+SoundMixer::SoundMixer(bool audioEnabled)
+    : m_audioEnabled(audioEnabled)
+    , m_format(SDL_AUDIO_UNKNOWN)
+    , m_channelCount(0)
+    , m_voices()
+    , m_requests()
+    , m_nextStartID(0)
+    , m_listenerPosition(b2Vec2_zero)
+    , m_listenerHalfWidth(0.f)
+    , m_stats()
+    , m_mixTimeNS(0)
+    , m_mixCallCount(0)
+{
+    if (m_audioEnabled)
+    {
+        int frequency = 0;
+        if (Mix_QuerySpec(&frequency, &m_format, &m_channelCount) == false)
+        {
+            m_format = SDL_AUDIO_UNKNOWN;
+        }
+    }
+}
+
+SoundMixer::~SoundMixer()
+{
+    // Les sons en cours continuent sans l'effet, qui référence les voix
+    UnregisterEffects();
+}
+
+void SoundMixer::SetChannels(int firstChannel, int lastChannel)
+{
+    UnregisterEffects();
+    m_voices.clear();
+    for (int channel = firstChannel; channel <= lastChannel; channel++)
+    {
+        m_voices.push_back(std::make_unique<Voice>(this, channel));
+    }
+}
+
+void SoundMixer::SetListener(b2Vec2 position, float halfWidth)
+{
+    m_listenerPosition = position;
+    m_listenerHalfWidth = halfWidth;
+}
+
+void SoundMixer::Play(int soundID, Mix_Chunk *chunk, const SoundParams &params)
+{
+    if (m_audioEnabled == false || chunk == nullptr) return;
+
+    Request request = { 0 };
+    request.soundID = soundID;
+    request.chunk = chunk;
+    request.priority = params.priority;
+    request.loops = params.loops;
+    ComputeGains(params, request.leftGain, request.rightGain);
+    m_stats.requestCount++;
+
+    // Un même son n'est joué qu'une fois par pas
+    for (Request &other : m_requests)
+    {
+        if (other.soundID != soundID) continue;
+
+        other.priority = std::max(other.priority, request.priority);
+        other.loops = std::max(other.loops, request.loops);
+        if (request.leftGain + request.rightGain > other.leftGain + other.rightGain)
+        {
+            other.leftGain = request.leftGain;
+            other.rightGain = request.rightGain;
+        }
+        m_stats.mergedCount++;
+        return;
+    }
+    m_requests.push_back(request);
+}
+
+void SoundMixer::Flush()
+{
+    if (m_requests.empty()) return;
+
+    // Libère les voix qui ont fini de jouer
+    for (auto &voice : m_voices)
+    {
+        if (voice->soundID >= 0 && Mix_Playing(voice->channel) == 0)
+        {
+            voice->soundID = -1;
+        }
+    }
+
+    std::stable_sort(m_requests.begin(), m_requests.end(),
+        [](const Request &a, const Request &b) { return a.priority > b.priority; });
+
+    for (const Request &request : m_requests)
+    {
+        Voice *voice = FindVoice(request.priority);
+        if (voice == nullptr)
+        {
+            m_stats.droppedCount++;
+            continue;
+        }
+        if (voice->soundID >= 0)
+        {
+            m_stats.stolenCount++;
+        }
+        StartVoice(voice, request);
+    }
+    m_requests.clear();
+}
+
+void SoundMixer::CancelRequests()
+{
+    m_requests.clear();
+}
+
+const SoundMixer::Stats &SoundMixer::GetStats()
+{
+    m_stats.activeVoiceCount = 0;
+    for (auto &voice : m_voices)
+    {
+        if (voice->soundID >= 0 && Mix_Playing(voice->channel))
+        {
+            m_stats.activeVoiceCount++;
+        }
+    }
+    m_stats.mixTimeNS = m_mixTimeNS.load(std::memory_order_relaxed);
+    m_stats.mixCallCount = m_mixCallCount.load(std::memory_order_relaxed);
+    return m_stats;
+}
+
+void SoundMixer::ResetStats()
+{
+    m_stats = Stats();
+    m_mixTimeNS.store(0, std::memory_order_relaxed);
+    m_mixCallCount.store(0, std::memory_order_relaxed);
+}
+
+void SoundMixer::ComputeGains(const SoundParams &params, float &leftGain, float &rightGain) const
+{
+    const float volume = math::Clamp(params.volume, 0.f, 1.f);
+    leftGain = volume;
+    rightGain = volume;
+
+    if (params.positional == false || m_listenerHalfWidth <= 0.f) return;
+
+    // Atténuation au-delà de la vue
+    const float distance = b2Distance(params.position, m_listenerPosition);
+    const float outside = (distance - m_listenerHalfWidth) / m_listenerHalfWidth;
+    const float attenuation = math::Clamp(1.f - outside, MIN_DISTANCE_GAIN, 1.f);
+
+    // Balance : le canal opposé au son est baissé
+    const float pan = PAN_AMOUNT * math::Clamp(
+        (params.position.x - m_listenerPosition.x) / m_listenerHalfWidth, -1.f, 1.f);
+
+    leftGain = volume * attenuation * std::min(1.f, 1.f - pan);
+    rightGain = volume * attenuation * std::min(1.f, 1.f + pan);
+}
+
+SoundMixer::Voice *SoundMixer::FindVoice(int priority)
+{
+    Voice *candidate = nullptr;
+    for (auto &voice : m_voices)
+    {
+        if (voice->soundID < 0) return voice.get();
+        if (voice->priority > priority) continue;
+
+        if (candidate == nullptr ||
+            voice->priority < candidate->priority ||
+            (voice->priority == candidate->priority && voice->startID < candidate->startID))
+        {
+            candidate = voice.get();
+        }
+    }
+    return candidate;
+}
+
+void SoundMixer::StartVoice(Voice *voice, const Request &request)
+{
+    // L'arrêt du canal réinitialise ses effets
+    if (voice->soundID >= 0) Mix_HaltChannel(voice->channel);
+
+    voice->leftGain.store(request.leftGain, std::memory_order_relaxed);
+    voice->rightGain.store(request.rightGain, std::memory_order_relaxed);
+
+    if (m_format == SDL_AUDIO_F32 || m_format == SDL_AUDIO_S16)
+    {
+        Mix_RegisterEffect(voice->channel, EffectCallback, nullptr, voice);
+    }
+    else
+    {
+        Mix_SetPanning(voice->channel,
+            (Uint8)(255.f * request.leftGain), (Uint8)(255.f * request.rightGain));
+    }
+
+    if (Mix_PlayChannel(voice->channel, request.chunk, request.loops) < 0)
+    {
+        std::cout << "ERROR - Play sound " << request.soundID << std::endl
+            << "      - " << SDL_GetError() << std::endl;
+        voice->soundID = -1;
+        return;
+    }
+
+    voice->soundID = request.soundID;
+    voice->priority = request.priority;
+    voice->startID = m_nextStartID++;
+}
+
+void SoundMixer::UnregisterEffects()
+{
+    if (m_audioEnabled == false) return;
+
+    for (auto &voice : m_voices)
+    {
+        Mix_UnregisterEffect(voice->channel, EffectCallback);
+    }
+}
+
+void SDLCALL SoundMixer::EffectCallback(int channel, void *stream, int length, void *userData)
+{
+    Voice *voice = (Voice *)userData;
+    SoundMixer *mixer = voice->mixer;
+    const Uint64 startNS = SDL_GetTicksNS();
+
+    float leftGain = voice->leftGain.load(std::memory_order_relaxed);
+    float rightGain = voice->rightGain.load(std::memory_order_relaxed);
+    if (mixer->m_channelCount != 2)
+    {
+        leftGain = rightGain = 0.5f * (leftGain + rightGain);
+    }
+
+    if (mixer->m_format == SDL_AUDIO_F32)
+    {
+        simd::ApplyStereoGain((float *)stream, (size_t)length / sizeof(float), leftGain, rightGain);
+    }
+    else
+    {
+        Sint16 *samples = (Sint16 *)stream;
+        const int sampleCount = length / (int)sizeof(Sint16);
+        const int gains[2] = { (int)(leftGain * 32768.f), (int)(rightGain * 32768.f) };
+        for (int i = 0; i < sampleCount; i++)
+        {
+            samples[i] = (Sint16)((samples[i] * gains[i % 2]) >> 15);
+        }
+    }
+
+    mixer->m_mixTimeNS.fetch_add(SDL_GetTicksNS() - startNS, std::memory_order_relaxed);
+    mixer->m_mixCallCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,159 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <atomic>
+
+/// @brief Paramètres de lecture d'un effet sonore.
+struct SoundParams
+{
+    SoundParams(int priority = 0, float volume = 1.f);
+
+    /// @brief Une voix ne peut prendre que la place d'une voix de priorité
+    /// inférieure ou égale.
+    int priority;
+    /// @brief Volume du son (entre 0 et 1).
+    float volume;
+    /// @brief Indique si le son est atténué et placé dans l'espace stéréo
+    /// selon sa position par rapport à l'auditeur.
+    bool positional;
+    /// @brief Position du son dans le monde.
+    b2Vec2 position;
+    int loops;
+
+    /// @brief Crée les paramètres d'un son positionné dans le monde.
+    static SoundParams At(b2Vec2 position, int priority = 0, float volume = 1.f);
+};
+
+/// @brief Ensemble de voix (canaux SDL Mixer) utilisées pour les effets sonores.
+///
+/// Les demandes de lecture sont mises en attente puis traitées par Flush(),
+/// à la fin de chaque pas fixe et de chaque frame :
+/// - un même son demandé plusieurs fois n'est joué qu'une fois, avec la plus
+///   grande priorité et le plus grand volume demandés ;
+/// - une voix libre est utilisée en priorité, sinon la voix la moins
+///   prioritaire (puis la plus ancienne) est volée si sa priorité est
+///   inférieure ou égale à celle du son, sinon le son est abandonné ;
+/// - le volume et la balance d'un son positionné dépendent de sa distance
+///   à l'auditeur (voir SetListener()).
+///
+/// Le gain de chaque voix est appliqué par un effet SDL Mixer exécuté sur le
+/// thread audio, avec un noyau SIMD (voir simd::ApplyStereoGain()).
+class SoundMixer
+{
+public:
+    struct Stats
+    {
+        Stats();
+
+        int activeVoiceCount;
+        int requestCount;
+        /// @brief Demandes fusionnées avec une demande du même son.
+        int mergedCount;
+        /// @brief Voix interrompues pour jouer un son plus prioritaire.
+        int stolenCount;
+        /// @brief Demandes abandonnées faute de voix disponible.
+        int droppedCount;
+        /// @brief Temps passé dans l'effet de gain sur le thread audio.
+        Uint64 mixTimeNS;
+        Uint64 mixCallCount;
+    };
+
+    /// @brief Volume minimal d'un son positionné loin de l'auditeur.
+    static constexpr float MIN_DISTANCE_GAIN = 0.2f;
+    /// @brief Écart maximal entre les volumes gauche et droit (entre 0 et 1).
+    static constexpr float PAN_AMOUNT = 0.6f;
+
+    SoundMixer(bool audioEnabled);
+    SoundMixer(SoundMixer const&) = delete;
+    SoundMixer& operator=(SoundMixer const&) = delete;
+    ~SoundMixer();
+
+    /// @brief Définit les canaux SDL Mixer utilisés comme voix.
+    void SetChannels(int firstChannel, int lastChannel);
+    int GetVoiceCount() const;
+    int GetChannel(int voiceIndex) const;
+
+    /// @brief Définit la position de l'auditeur (en général le centre de la caméra).
+    /// Un son est joué à plein volume tant qu'il est à moins de `halfWidth`
+    /// de l'auditeur, puis il est atténué jusqu'à MIN_DISTANCE_GAIN à une
+    /// distance de 2 * `halfWidth`.
+    /// @param halfWidth la demi-largeur de la vue dans le monde.
+    void SetListener(b2Vec2 position, float halfWidth);
+
+    /// @brief Met en attente la lecture d'un son jusqu'au prochain Flush().
+    void Play(int soundID, Mix_Chunk *chunk, const SoundParams &params);
+
+    /// @brief Joue les sons en attente.
+    void Flush();
+
+    /// @brief Abandonne les sons en attente (par exemple pendant une resimulation).
+    void CancelRequests();
+
+    const Stats &GetStats();
+    void ResetStats();
+
+private:
+    struct Request
+    {
+        int soundID;
+        Mix_Chunk *chunk;
+        int priority;
+        int loops;
+        float leftGain;
+        float rightGain;
+    };
+
+    struct Voice
+    {
+        Voice(SoundMixer *mixer, int channel);
+
+        SoundMixer *mixer;
+        int channel;
+        int soundID;
+        int priority;
+        Uint64 startID;
+        /// @brief Gains lus par le thread audio.
+        std::atomic<float> leftGain;
+        std::atomic<float> rightGain;
+    };
+
+    bool m_audioEnabled;
+    SDL_AudioFormat m_format;
+    int m_channelCount;
+
+    std::vector<std::unique_ptr<Voice>> m_voices;
+    std::vector<Request> m_requests;
+    Uint64 m_nextStartID;
+
+    b2Vec2 m_listenerPosition;
+    float m_listenerHalfWidth;
+
+    Stats m_stats;
+    std::atomic<Uint64> m_mixTimeNS;
+    std::atomic<Uint64> m_mixCallCount;
+
+    void ComputeGains(const SoundParams &params, float &leftGain, float &rightGain) const;
+    Voice *FindVoice(int priority);
+    void StartVoice(Voice *voice, const Request &request);
+    void UnregisterEffects();
+
+    static void SDLCALL EffectCallback(int channel, void *stream, int length, void *userData);
+};
+
+inline int SoundMixer::GetVoiceCount() const
+{
+    return (int)m_voices.size();
+}
+
+inline int SoundMixer::GetChannel(int voiceIndex) const
+{
+    assert(0 <= voiceIndex && voiceIndex < (int)m_voices.size());
+    return m_voices[voiceIndex]->channel;
+}
@@ -0,0 +1,169 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/state_hash.h"
+
+#include <fstream>
+#include <sstream>
+
+StateHasher::StateHasher()
+    : m_value(0xcbf29ce484222325ULL)
+{
+}
+
+void StateHasher::AddBytes(const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint64_t value = m_value;
+    for (size_t i = 0; i < size; i++)
+    {
+        value ^= bytes[i];
+        value *= 0x100000001b3ULL;
+    }
+    m_value = value;
+}
+
+TickHash::TickHash()
+    : tick(0)
+    , value(0)
+    , categories()
+{
+}
+
+StateHashLog::StateHashLog()
+    : m_categories()
+    , m_ticks()
+{
+}
+
+StateHashLog::Divergence::Divergence()
+    : diverged(false)
+    , tick(0)
+    , category(-1)
+{
+}
+
+void StateHashLog::SetCategories(const std::vector<std::string> &categories)
+{
+    assert(categories.size() <= MAX_STATE_HASH_CATEGORIES);
+    m_categories = categories;
+}
+
+void StateHashLog::Record(const TickHash &hash)
+{
+    if (hash.tick >= m_ticks.size())
+    {
+        m_ticks.resize(hash.tick + 1);
+    }
+    m_ticks[hash.tick] = hash;
+}
+
+void StateHashLog::Clear()
+{
+    m_ticks.clear();
+}
+
+bool StateHashLog::Save(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't write the state hash log " << path << std::endl;
+        return false;
+    }
+
+    file << "tick hash";
+    for (const std::string &category : m_categories)
+    {
+        file << " " << category;
+    }
+    file << "\n" << std::hex << std::setfill('0');
+
+    for (const TickHash &hash : m_ticks)
+    {
+        file << std::dec << hash.tick << std::hex << " " << std::setw(16) << hash.value;
+        for (size_t i = 0; i < m_categories.size(); i++)
+        {
+            file << " " << std::setw(16) << hash.categories[i];
+        }
+        file << "\n";
+    }
+    return true;
+}
+
+bool StateHashLog::Load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (file.is_open() == false)
+    {
+        std::cout << "ERROR - Can't read the state hash log " << path << std::endl;
+        return false;
+    }
+
+    m_categories.clear();
+    m_ticks.clear();
+
+    std::string line, word;
+    std::getline(file, line);
+    std::istringstream header(line);
+    header >> word >> word;
+    while (header >> word && m_categories.size() < MAX_STATE_HASH_CATEGORIES)
+    {
+        m_categories.push_back(word);
+    }
+
+    while (std::getline(file, line))
+    {
+        std::istringstream values(line);
+        TickHash hash;
+        values >> std::dec >> hash.tick >> std::hex >> hash.value;
+        for (size_t i = 0; i < m_categories.size(); i++)
+        {
+            values >> hash.categories[i];
+        }
+        if (values.fail())
+        {
+            std::cout << "ERROR - Corrupted state hash log " << path << std::endl;
+            return false;
+        }
+        Record(hash);
+    }
+    return true;
+}
+
+StateHashLog::Divergence StateHashLog::Compare(const StateHashLog &a, const StateHashLog &b)
+{
+    Divergence divergence;
+    const size_t tickCount = std::min(a.m_ticks.size(), b.m_ticks.size());
+    const size_t categoryCount = std::min(a.m_categories.size(), b.m_categories.size());
+
+    for (size_t tick = 0; tick < tickCount; tick++)
+    {
+        const TickHash &hashA = a.m_ticks[tick];
+        const TickHash &hashB = b.m_ticks[tick];
+        if (hashA.value == hashB.value) continue;
+
+        divergence.diverged = true;
+        divergence.tick = tick;
+        for (size_t i = 0; i < categoryCount; i++)
+        {
+            if (hashA.categories[i] != hashB.categories[i])
+            {
+                divergence.category = (int)i;
+                break;
+            }
+        }
+        return divergence;
+    }
+
+    if (a.m_ticks.size() != b.m_ticks.size())
+    {
+        divergence.diverged = true;
+        divergence.tick = tickCount;
+        divergence.category = -1;
+    }
+    return divergence;
+}
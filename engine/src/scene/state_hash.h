@@ -0,0 +1,170 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#define MAX_STATE_HASH_CATEGORIES 8
+
+/// @brief Hash incrémental (FNV-1a 64 bits) de l'état de la simulation.
+/// Les valeurs sont hachées bit à bit : deux simulations identiques
+/// produisent le même hash, y compris pour les flottants.
+class StateHasher
+{
+public:
+    StateHasher();
+
+    void AddBytes(const void *data, size_t size);
+
+    template <typename T>
+    void Add(const T &value);
+    void Add(float value);
+    void Add(b2Vec2 value);
+    void Add(b2Rot value);
+
+    /// @brief Ajoute le hash des composants T de toutes les entités.
+    /// Le résultat ne dépend pas de l'ordre de stockage des composants,
+    /// qui peut changer après la restauration d'un snapshot.
+    /// @param registry le registre.
+    /// @param hashFunc la fonction ajoutant les champs d'un composant
+    /// (StateHasher &, const T &).
+    template <typename T, typename Func>
+    void AddComponents(const entt::registry &registry, Func &&hashFunc);
+
+    uint64_t GetValue() const;
+
+private:
+    uint64_t m_value;
+
+    static uint64_t Mix(uint64_t value);
+};
+
+/// @brief Hash de l'état de la simulation après un pas fixe.
+struct TickHash
+{
+    TickHash();
+
+    /// @brief Indice du pas fixe (à partir de 0).
+    Uint64 tick;
+    /// @brief Hash combiné de toutes les catégories.
+    uint64_t value;
+    /// @brief Hash de chaque catégorie, dans l'ordre d'ajout à la scène.
+    std::array<uint64_t, MAX_STATE_HASH_CATEGORIES> categories;
+};
+
+/// @brief Historique des hashs d'une simulation, indexé par pas fixe.
+/// Il peut être écrit dans un fichier texte pour comparer deux exécutions.
+class StateHashLog
+{
+public:
+    StateHashLog();
+
+    struct Divergence
+    {
+        Divergence();
+
+        bool diverged;
+        /// @brief Premier pas fixe dont les hashs diffèrent.
+        Uint64 tick;
+        /// @brief Première catégorie différente, -1 si le nombre de pas diffère.
+        int category;
+    };
+
+    void SetCategories(const std::vector<std::string> &categories);
+    const std::vector<std::string> &GetCategories() const;
+
+    /// @brief Enregistre le hash d'un pas fixe. Un pas resimulé
+    /// (après un retour en arrière) remplace le hash précédent.
+    void Record(const TickHash &hash);
+    void Clear();
+
+    size_t GetTickCount() const;
+    const TickHash &GetTick(size_t tick) const;
+
+    bool Save(const std::string &path) const;
+    bool Load(const std::string &path);
+
+    /// @brief Recherche le premier pas fixe où deux simulations divergent.
+    static Divergence Compare(const StateHashLog &a, const StateHashLog &b);
+
+private:
+    std::vector<std::string> m_categories;
+    std::vector<TickHash> m_ticks;
+};
+
+template <typename T>
+inline void StateHasher::Add(const T &value)
+{
+    static_assert(std::has_unique_object_representations_v<T>,
+        "Values with padding bytes must be hashed field by field");
+    AddBytes(&value, sizeof(T));
+}
+
+inline void StateHasher::Add(float value)
+{
+    AddBytes(&value, sizeof(float));
+}
+
+inline void StateHasher::Add(b2Vec2 value)
+{
+    Add(value.x);
+    Add(value.y);
+}
+
+inline void StateHasher::Add(b2Rot value)
+{
+    Add(value.c);
+    Add(value.s);
+}
+
+template <typename T, typename Func>
+inline void StateHasher::AddComponents(const entt::registry &registry, Func &&hashFunc)
+{
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    for (auto [entity, component] : registry.view<const T>().each())
+    {
+        StateHasher hasher;
+        hasher.Add(entity);
+        hashFunc(hasher, component);
+        sum += Mix(hasher.GetValue());
+        count++;
+    }
+    Add(count);
+    Add(sum);
+}
+
+inline uint64_t StateHasher::GetValue() const
+{
+    return m_value;
+}
+
+inline uint64_t StateHasher::Mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+inline const std::vector<std::string> &StateHashLog::GetCategories() const
+{
+    return m_categories;
+}
+
+inline size_t StateHashLog::GetTickCount() const
+{
+    return m_ticks.size();
+}
+
+inline const TickHash &StateHashLog::GetTick(size_t tick) const
+{
+    assert(tick < m_ticks.size());
+    return m_ticks[tick];
+}
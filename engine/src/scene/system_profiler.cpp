@@ -0,0 +1,80 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "scene/system_profiler.h"
+
+SystemProfiler::Stats::Stats()
+    : name(), sampleCount(0), meanUS(0.0), p99US(0.0), maxUS(0.0)
+{
+}
+
+SystemProfiler::SystemProfiler()
+    : m_names()
+    , m_samples()
+    , m_indices()
+    , m_ticks()
+{
+}
+
+void SystemProfiler::AddSample(const std::string &name, Uint64 timeNS)
+{
+    auto it = m_indices.find(name);
+    if (it == m_indices.end())
+    {
+        it = m_indices.emplace(name, (int)m_names.size()).first;
+        m_names.push_back(name);
+        m_samples.emplace_back();
+    }
+    m_samples[it->second].push_back(timeNS);
+}
+
+void SystemProfiler::AddTick(Uint64 timeNS)
+{
+    m_ticks.push_back(timeNS);
+}
+
+void SystemProfiler::Clear()
+{
+    m_names.clear();
+    m_samples.clear();
+    m_indices.clear();
+    m_ticks.clear();
+}
+
+std::vector<SystemProfiler::Stats> SystemProfiler::GetSystemStats() const
+{
+    std::vector<Stats> stats;
+    stats.reserve(m_names.size());
+    for (size_t i = 0; i < m_names.size(); i++)
+    {
+        stats.push_back(ComputeStats(m_names[i], m_samples[i]));
+    }
+    return stats;
+}
+
+SystemProfiler::Stats SystemProfiler::GetTickStats() const
+{
+    return ComputeStats("Tick", m_ticks);
+}
+
+SystemProfiler::Stats SystemProfiler::ComputeStats(const std::string &name, std::vector<Uint64> samplesNS)
+{
+    Stats stats;
+    stats.name = name;
+    stats.sampleCount = (int)samplesNS.size();
+    if (samplesNS.empty()) return stats;
+
+    std::sort(samplesNS.begin(), samplesNS.end());
+
+    double totalNS = 0.0;
+    for (Uint64 sample : samplesNS) totalNS += (double)sample;
+
+    const size_t p99Index = (size_t)std::ceil(0.99 * (double)samplesNS.size()) - 1;
+    stats.meanUS = totalNS / (double)samplesNS.size() / 1000.0;
+    stats.p99US = (double)samplesNS[p99Index] / 1000.0;
+    stats.maxUS = (double)samplesNS.back() / 1000.0;
+    return stats;
+}
@@ -0,0 +1,59 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Mesure le temps de chaque système d'une scène, pas fixe par pas fixe.
+/// Une scène n'enregistre des mesures que si un profileur lui est associé
+/// avec Scene::SetSystemProfiler().
+class SystemProfiler
+{
+public:
+    struct Stats
+    {
+        Stats();
+
+        std::string name;
+        int sampleCount;
+        double meanUS;
+        /// @brief 99e centile : 1 % des mesures sont plus longues.
+        double p99US;
+        double maxUS;
+    };
+
+    SystemProfiler();
+    SystemProfiler(SystemProfiler const&) = delete;
+    SystemProfiler& operator=(SystemProfiler const&) = delete;
+
+    /// @brief Ajoute la mesure d'un système (ou d'une étape de la scène).
+    void AddSample(const std::string &name, Uint64 timeNS);
+
+    /// @brief Ajoute la durée totale d'un pas fixe.
+    void AddTick(Uint64 timeNS);
+
+    void Clear();
+
+    /// @brief Renvoie les statistiques de chaque système, dans l'ordre
+    /// de leur première mesure.
+    std::vector<Stats> GetSystemStats() const;
+    Stats GetTickStats() const;
+    int GetTickCount() const;
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<std::vector<Uint64>> m_samples;
+    std::map<std::string, int> m_indices;
+    std::vector<Uint64> m_ticks;
+
+    static Stats ComputeStats(const std::string &name, std::vector<Uint64> samplesNS);
+};
+
+inline int SystemProfiler::GetTickCount() const
+{
+    return (int)m_ticks.size();
+}
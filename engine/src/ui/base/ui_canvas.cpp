@@ -17,7 +17,7 @@ UICanvas::UICanvas(Scene *scene)
     m_rect.anchorMax = { 0.f, 0.f };
 
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(m_scene->GetRenderer(), &viewport);
 
     m_pixelPerUnit = (float)viewport.w / 640.f;
 }
@@ -25,7 +25,7 @@ UICanvas::UICanvas(Scene *scene)
 void UICanvas::Update()
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(m_scene->GetRenderer(), &viewport);
 
     m_pixelPerUnit = (float)viewport.w / 640.f;
 }
@@ -257,7 +257,7 @@ void UIGridLayout::DrawGizmos()
         m_rowOffsets[m_rowCount]
     );
     
-    SDL_SetRenderDrawColor(g_renderer, 255, 255, 0, 128);
+    SDL_SetRenderDrawColor(m_scene->GetRenderer(), 255, 255, 0, 128);
     for (size_t i = 0; i < m_rowCount; i++)
     {
         for (size_t j = 0; j < m_colCount; j++)
@@ -307,7 +307,7 @@ void UIGridLayout::DrawGizmos()
                 break;
             }
 
-            SDL_RenderFillRect(g_renderer, &rect);
+            SDL_RenderFillRect(m_scene->GetRenderer(), &rect);
         }
     }
 }
@@ -127,19 +127,19 @@ void UISelectable::OnDelete()
 void UISelectable::DrawGizmos()
 {
     SDL_FRect navRect = GetCanvasNavigationRect();
-    SDL_SetRenderDrawColor(g_renderer, 255, 0, 0, 128);
-    SDL_RenderFillRect(g_renderer, &navRect);
+    SDL_SetRenderDrawColor(m_scene->GetRenderer(), 255, 0, 0, 128);
+    SDL_RenderFillRect(m_scene->GetRenderer(), &navRect);
 
     SDL_FRect rect = GetCanvasRect();
-    SDL_SetRenderDrawColor(g_renderer, 255, 255, 0, 128);
-    SDL_RenderRect(g_renderer, &rect);
+    SDL_SetRenderDrawColor(m_scene->GetRenderer(), 255, 255, 0, 128);
+    SDL_RenderRect(m_scene->GetRenderer(), &rect);
 
-    SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
+    SDL_SetRenderDrawColor(m_scene->GetRenderer(), 255, 255, 255, 255);
     if (m_nextUp)
     {
         SDL_FRect nextRect = m_nextUp->GetCanvasRect();
         SDL_RenderLine(
-            g_renderer, rect.x + 0.5f * rect.w, rect.y,
+            m_scene->GetRenderer(), rect.x + 0.5f * rect.w, rect.y,
             nextRect.x + 0.5f * nextRect.w, nextRect.y + 0.5f * nextRect.h
         );
     }
@@ -147,7 +147,7 @@ void UISelectable::DrawGizmos()
     {
         SDL_FRect nextRect = m_nextDown->GetCanvasRect();
         SDL_RenderLine(
-            g_renderer, rect.x + 0.5f * rect.w, rect.y + rect.h,
+            m_scene->GetRenderer(), rect.x + 0.5f * rect.w, rect.y + rect.h,
             nextRect.x + 0.5f * nextRect.w, nextRect.y + 0.5f * nextRect.h
         );
     }
@@ -155,7 +155,7 @@ void UISelectable::DrawGizmos()
     {
         SDL_FRect nextRect = m_nextRight->GetCanvasRect();
         SDL_RenderLine(
-            g_renderer, rect.x + rect.w, rect.y + 0.5f * rect.h,
+            m_scene->GetRenderer(), rect.x + rect.w, rect.y + 0.5f * rect.h,
             nextRect.x + 0.5f * nextRect.w, nextRect.y + 0.5f * nextRect.h
         );
     }
@@ -163,7 +163,7 @@ void UISelectable::DrawGizmos()
     {
         SDL_FRect nextRect = m_nextLeft->GetCanvasRect();
         SDL_RenderLine(
-            g_renderer, rect.x, rect.y + 0.5f * rect.h,
+            m_scene->GetRenderer(), rect.x, rect.y + 0.5f * rect.h,
             nextRect.x + 0.5f * nextRect.w, nextRect.y + 0.5f * nextRect.h
         );
     }
@@ -171,8 +171,8 @@ void UISelectable::DrawGizmos()
     if (m_group != nullptr && m_group->GetCursor() != nullptr)
     {
         SDL_FRect cursorRect = GetCanvasCursorRect();
-        SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 50);
-        SDL_RenderFillRect(g_renderer, &cursorRect);
+        SDL_SetRenderDrawColor(m_scene->GetRenderer(), 0, 255, 255, 50);
+        SDL_RenderFillRect(m_scene->GetRenderer(), &cursorRect);
     }
 }
 
@@ -52,31 +52,35 @@ UITarget::UITarget()
 {}
 
 UIObject::UIObject(Scene *scene)
-    : m_scene(scene)
-    , m_children()
-    , m_parent(nullptr)
-    , m_depth(0)
-    , m_layer(DEFAULT_UI_LAYER)
+    : m_rect()
+    , m_scene(scene)
     , m_name()
-    , m_flags(Flag::NONE)
     , m_objectID(-1)
+    , m_flags(Flag::NONE)
+    , m_enabled(true)
+    , m_layer(DEFAULT_UI_LAYER)
+    , m_depth(0)
+    , m_depthVersion(0)
     , m_gizmosEnabled(false)
-    , m_rect()
+    , m_parent(nullptr)
+    , m_children()
+    , m_slotIndex(0)
+    , m_objectIndex(-1)
+    , m_visibleFrame(0)
+    , m_animListeners()
     , m_useParentAnim(true)
     , m_useParentAlpha(true)
-    , m_alpha(1.f)
     , m_fadeChildren(true)
-    , m_animListeners()
-    , m_targets()
+    , m_shift(b2Vec2_zero)
+    , m_alpha(1.f)
     , m_targetMask(0)
-    , m_enabled(true)
+    , m_targets()
+    , m_delayFadeI(0.f)
+    , m_delayFadeO(0.f)
     , m_fadeIAnim()
     , m_fadeOAnim()
     , m_transformAnimState(0.25f, 1, true)
     , m_transformEasing(EasingFct_InOut)
-    , m_shift(b2Vec2_zero)
-    , m_delayFadeI(0.f)
-    , m_delayFadeO(0.f)
 {
     SetName("UIObject");
     scene->GetUIObjectManager()->AddObject(this);
@@ -91,34 +95,24 @@ void UIObject::AddChild(UIObject *child)
 {
     assert(child);
 
-    m_children.insert(child);
+    m_children.push_back(child);
     child->m_parent = this;
-    child->UpdateDepth();
 }
 
 void UIObject::RemoveChild(UIObject *child)
 {
     assert(child);
 
-    auto it = m_children.find(child);
+    auto it = std::find(m_children.begin(), m_children.end(), child);
     if (it == m_children.end())
     {
         assert(false);
         return;
     }
 
-    m_children.erase(child);
+    // Conserve l'ordre des frères
+    m_children.erase(it);
     child->m_parent = nullptr;
-    child->UpdateDepth();
-}
-
-void UIObject::UpdateDepth()
-{
-    m_depth = (m_parent == nullptr) ? 0 : m_parent->m_depth + 1;
-    for (UIObject *child : m_children)
-    {
-        child->UpdateDepth();
-    }
 }
 
 void UIObject::SetParent(UIObject *parent)
@@ -129,6 +123,9 @@ void UIObject::SetParent(UIObject *parent)
     if (parent) parent->AddChild(this);
     
     m_parent = parent;
+
+    // Les profondeurs du sous-arbre seront recalculées à la demande
+    m_scene->GetUIObjectManager()->OnHierarchyChanged(this);
 }
 
 UIObject::~UIObject()
@@ -336,7 +333,7 @@ void UIObject::NotifyTransformEnd()
 SDL_FRect UIObject::GetCanvasRect() const
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(m_scene->GetRenderer(), &viewport);
 
     float pixelsPerUnit = m_scene->GetCanvas()->GetPixelsPerUnit();
     SDL_FRect rect = GetCanvasRectRec(pixelsPerUnit);
@@ -384,18 +381,18 @@ bool UIObject::Contains(const SDL_FPoint &point) const
 void UIObject::DrawGizmos()
 {
     SDL_Rect viewport = { 0 };
-    SDL_GetRenderViewport(g_renderer, &viewport);
+    SDL_GetRenderViewport(m_scene->GetRenderer(), &viewport);
     SDL_FRect canvasRect = GetCanvasRect();
     if ((fabsf(viewport.w - canvasRect.w) < 1.f) &&
         (fabsf(viewport.h - canvasRect.h) < 1.f))
     {
-        SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 255);
-        SDL_RenderRect(g_renderer, &canvasRect);
+        SDL_SetRenderDrawColor(m_scene->GetRenderer(), 0, 255, 255, 255);
+        SDL_RenderRect(m_scene->GetRenderer(), &canvasRect);
     }
     else
     {
-        SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 31);
-        SDL_RenderFillRect(g_renderer, &canvasRect);
+        SDL_SetRenderDrawColor(m_scene->GetRenderer(), 0, 255, 255, 31);
+        SDL_RenderFillRect(m_scene->GetRenderer(), &canvasRect);
     }
 }
 
@@ -501,12 +498,20 @@ float UIObject::GetFadeOutProgression() const
 
 void UIObject::AddAnimListener(UIAnimListener *listener)
 {
-    m_animListeners.insert(listener);
+    auto it = std::find(m_animListeners.begin(), m_animListeners.end(), listener);
+    if (it == m_animListeners.end())
+    {
+        m_animListeners.push_back(listener);
+    }
 }
 
 void UIObject::RemoveAnimListener(UIAnimListener *listener)
 {
-    m_animListeners.erase(listener);
+    auto it = std::find(m_animListeners.begin(), m_animListeners.end(), listener);
+    if (it != m_animListeners.end())
+    {
+        m_animListeners.erase(it);
+    }
 }
 
 SDL_FRect UIObject::GetRenderRect() const
@@ -669,5 +674,8 @@ int UIObject::GetLayer() const
 
 void UIObject::SetLayer(int layer)
 {
+    if (layer == m_layer) return;
+
     m_layer = layer;
+    m_scene->GetUIObjectManager()->OnOrderChanged(this);
 }
@@ -10,6 +10,7 @@
 #include "game_engine_common.h"
 #include "rendering/anim.h"
 #include "utils/color.h"
+#include "ui/ui_object_manager.h"
 
 class Scene;
 class UIObject;
@@ -111,10 +112,16 @@ public:
     void SetName(const std::string &name);
     const std::string &GetName();
 
+    /// @brief Renvoie la profondeur de l'objet dans l'arbre (0 pour une racine).
+    /// Elle est recalcule  la demande aprs un changement de parent.
     int GetDepth() const;
     int GetID() const;
 
-    const std::set<UIObject *> &GetChildren();
+    /// @brief Renvoie une poigne vers l'objet, qui reste sre aprs sa destruction.
+    UIObjectHandle GetHandle() const;
+
+    /// @brief Renvoie les enfants dans leur ordre d'ajout.
+    const std::vector<UIObject *> &GetChildren();
 
     bool GetGizmosEnabled() const;
     void SetGizmosEnabled(bool gizmosEnabled);
@@ -191,7 +198,6 @@ private:
     };
     void AddChild(UIObject *child);
     void RemoveChild(UIObject *child);
-    void UpdateDepth();
     void AddFlags(UIObject::Flag flags);
     void SubFlags(UIObject::Flag flags);
     bool TestFlag(UIObject::Flag flag) const;
@@ -207,13 +213,23 @@ private:
     Flag m_flags;
     bool m_enabled;
     int m_layer;
-    int m_depth;
+    /// @brief Profondeur valide si m_depthVersion est la version de la
+    /// hirarchie de UIObjectManager.
+    mutable int m_depth;
+    mutable Uint32 m_depthVersion;
     bool m_gizmosEnabled;
 
     UIObject *m_parent;
-    std::set<UIObject *> m_children;
+    std::vector<UIObject *> m_children;
+
+    /// @brief Emplacement de la poigne de l'objet dans UIObjectManager.
+    Uint32 m_slotIndex;
+    /// @brief Indice dans les objets dmarrs, -1 avant Start().
+    int m_objectIndex;
+    /// @brief Frame de UIObjectManager pendant laquelle l'objet est visible.
+    Uint64 m_visibleFrame;
 
-    std::set<UIAnimListener *> m_animListeners;
+    std::vector<UIAnimListener *> m_animListeners;
     bool m_useParentAnim;
     bool m_useParentAlpha;
     bool m_fadeChildren;
@@ -291,6 +307,12 @@ inline const std::string &UIObject::GetName()
 
 inline int UIObject::GetDepth() const
 {
+    const Uint32 version = m_scene->GetUIObjectManager()->m_hierarchyVersion;
+    if (m_depthVersion != version)
+    {
+        m_depth = (m_parent == nullptr) ? 0 : m_parent->GetDepth() + 1;
+        m_depthVersion = version;
+    }
     return m_depth;
 }
 
@@ -299,7 +321,12 @@ inline int UIObject::GetID() const
     return m_objectID;
 }
 
-inline const std::set<UIObject *> &UIObject::GetChildren()
+inline UIObjectHandle UIObject::GetHandle() const
+{
+    return m_scene->GetUIObjectManager()->GetHandle(const_cast<UIObject *>(this));
+}
+
+inline const std::vector<UIObject *> &UIObject::GetChildren()
 {
     return m_children;
 }
@@ -9,8 +9,29 @@
 
 //#define DEBUG_OBJECT_ON_DELETE
 
-UIObjectManager::UIObjectManager() :
-    m_objects(), m_toProcess(), m_visibleObjects(), m_nextID(0)
+UIObjectHandle::UIObjectHandle()
+    : index(0)
+    , generation(0)
+{
+}
+
+UIObjectManager::UIObjectManager()
+    : m_nextID(0)
+    , m_objects()
+    , m_slots()
+    , m_freeSlots()
+    , m_treeOrder()
+    , m_treeStack()
+    , m_treeDirty(false)
+    , m_hierarchyVersion(1)
+    , m_renderList()
+    , m_renderListDirty(false)
+    , m_visibleObjects()
+    , m_visibleFrame(1)
+    , m_toStart()
+    , m_toDelete()
+    , m_processStart()
+    , m_processDelete()
 {
 }
 
@@ -21,23 +42,38 @@ UIObjectManager::~UIObjectManager()
 
 void UIObjectManager::AddObject(UIObject *object)
 {
-    // Teste si l'objet est dj prsent
-    if (Contains(object)) return;
-
-    // Teste si l'objet est en attente de Start()
-    if (m_toProcess.find(object) != m_toProcess.end()) return;
+    // Teste si l'objet est dj prsent ou en attente de Start()
+    if (object->m_objectIndex >= 0) return;
+    if (object->TestFlag(UIObject::Flag::TO_START)) return;
 
     object->AddFlags(UIObject::Flag::TO_START);
     object->m_objectID = m_nextID++;
 
-    m_toProcess.insert(object);
+    // Emplacement de la poigne
+    Uint32 slotIndex = 0;
+    if (m_freeSlots.empty())
+    {
+        slotIndex = (Uint32)m_slots.size();
+        m_slots.push_back(Slot{ nullptr, 1 });
+    }
+    else
+    {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    m_slots[slotIndex].object = object;
+    object->m_slotIndex = slotIndex;
+
+    m_toStart.push_back(object);
 }
 
 void UIObjectManager::DeleteObject(UIObject *object)
 {
-    m_toProcess.insert(object);
-
-    object->AddFlags(UIObject::Flag::TO_DELETE);
+    if (object->TestFlag(UIObject::Flag::TO_DELETE) == false)
+    {
+        object->AddFlags(UIObject::Flag::TO_DELETE);
+        m_toDelete.push_back(object);
+    }
 
     for (UIObject *child : object->GetChildren())
     {
@@ -47,10 +83,12 @@ void UIObjectManager::DeleteObject(UIObject *object)
 
 void UIObjectManager::SetVisible(UIObject *object, bool visible)
 {
-    if (visible)
-        m_visibleSet.insert(object);
-    else
-        m_visibleSet.erase(object);
+    object->m_visibleFrame = visible ? m_visibleFrame : 0;
+}
+
+bool UIObjectManager::IsVisible(UIObject *object) const
+{
+    return object->m_visibleFrame == m_visibleFrame;
 }
 
 void UIObjectManager::DeleteObjects()
@@ -61,15 +99,32 @@ void UIObjectManager::DeleteObjects()
         delete gameObject;
     }
     m_objects.clear();
-    m_toProcess.clear();
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_treeOrder.clear();
+    m_renderList.clear();
     m_visibleObjects.clear();
-    m_visibleSet.clear();
+    m_toStart.clear();
+    m_toDelete.clear();
 }
 
 bool UIObjectManager::Contains(UIObject *object) const
 {
     if (object == nullptr) return false;
-    return m_objects.find(object) != m_objects.end();
+    return std::find(m_objects.begin(), m_objects.end(), object) != m_objects.end();
+}
+
+UIObjectHandle UIObjectManager::GetHandle(UIObject *object) const
+{
+    UIObjectHandle handle;
+    if (object == nullptr || object->m_slotIndex >= m_slots.size()) return handle;
+
+    const Slot &slot = m_slots[object->m_slotIndex];
+    if (slot.object != object) return handle;
+
+    handle.index = object->m_slotIndex;
+    handle.generation = slot.generation;
+    return handle;
 }
 
 void UIObjectManager::ClearVisibleObjects()
@@ -79,34 +134,54 @@ void UIObjectManager::ClearVisibleObjects()
 
 void UIObjectManager::ProcessObjects()
 {
-    std::set<UIObject *> toDelete;
-    std::vector<UIObject *> toProcessCopy(m_toProcess.begin(), m_toProcess.end());
+    // Les objets crs ou supprims pendant le traitement le seront au prochain appel
+    std::swap(m_toStart, m_processStart);
+    std::swap(m_toDelete, m_processDelete);
 
-    // Remet  zro le conteneur
-    m_toProcess.clear();
-    m_visibleSet.clear();
+    // Les objets doivent se rendre visibles  chaque frame
+    m_visibleFrame++;
 
     // Trie les objets selon leurs profondeurs
-    std::sort(toProcessCopy.begin(), toProcessCopy.end(), CompareUIObjects);
+    std::sort(m_processStart.begin(), m_processStart.end(), CompareUIObjects);
 
-    for (auto &gameObject : toProcessCopy)
+    for (UIObject *gameObject : m_processStart)
     {
         // START
-        if (gameObject->TestFlag(UIObject::Flag::TO_START))
+        // Insertion dans la liste des objets et dans la liste de rendu
+        gameObject->m_objectIndex = (int)m_objects.size();
+        m_objects.push_back(gameObject);
+        if (m_renderListDirty == false)
         {
-            // Insertion dans la liste des objets
-            m_objects.insert(gameObject);
-
-            gameObject->SubFlags(UIObject::Flag::TO_START);
-            gameObject->Start();
+            auto it = std::upper_bound(
+                m_renderList.begin(), m_renderList.end(), gameObject, CompareUIObjects);
+            m_renderList.insert(it, gameObject);
         }
-
-        // DELETE
-        if (gameObject->TestFlag(UIObject::Flag::TO_DELETE))
+        else
         {
-            toDelete.insert(gameObject);
+            m_renderList.push_back(gameObject);
         }
 
+        m_treeDirty = true;
+
+        gameObject->SubFlags(UIObject::Flag::TO_START);
+        gameObject->Start();
+    }
+    m_processStart.clear();
+
+    if (m_processDelete.empty() == false)
+    {
+        DestroyObjects();
+    }
+    if (m_treeDirty)
+    {
+        UpdateTreeOrder();
+    }
+}
+
+void UIObjectManager::DestroyObjects()
+{
+    for (UIObject *gameObject : m_processDelete)
+    {
         // DEBUG
     #ifdef DEBUG_OBJECT_ON_DELETE
         if (gameObject->TestFlag(UIObject::Flag::DEBUG_DELETED))
@@ -114,22 +189,25 @@ void UIObjectManager::ProcessObjects()
             assert(false);
         }
     #endif
-    }
-
-    for (auto gameObject : toDelete)
-    {
         gameObject->OnDelete();
     }
-    for (auto gameObject : toDelete)
+    // Dtache les objets sans passer par SetParent() : les objets restants
+    // gardent leur profondeur et leur ordre de rendu, la liste de rendu n'a
+    // donc pas besoin d'tre trie  nouveau
+    for (UIObject *gameObject : m_processDelete)
     {
-        gameObject->SetParent(nullptr);
+        if (gameObject->m_parent) gameObject->m_parent->RemoveChild(gameObject);
     }
-    for (auto &gameObject : toDelete)
+
+    // Retire les objets de la liste de rendu en conservant son ordre
+    auto last = std::remove_if(m_renderList.begin(), m_renderList.end(),
+        [](const UIObject *object) { return object->TestFlag(UIObject::Flag::TO_DELETE); });
+    m_renderList.erase(last, m_renderList.end());
+
+    for (UIObject *gameObject : m_processDelete)
     {
         // On dtruit toutes les rfrences de l'objet
-        m_toProcess.erase(gameObject);
-        m_objects.erase(gameObject);
-        m_visibleSet.erase(gameObject);
+        RemoveObject(gameObject);
 
     #ifdef DEBUG_OBJECT_ON_DELETE
         gameObject->AddFlags(UIObject::Flag::DEBUG_DELETED);
@@ -137,7 +215,77 @@ void UIObjectManager::ProcessObjects()
         delete gameObject;
     #endif
     }
+    m_processDelete.clear();
     m_visibleObjects.clear();
+    m_treeDirty = true;
+}
+
+void UIObjectManager::OnOrderChanged(UIObject *object)
+{
+    if (object->m_objectIndex >= 0) m_renderListDirty = true;
+}
+
+void UIObjectManager::OnHierarchyChanged(UIObject *object)
+{
+    m_treeDirty = true;
+
+    // Un objet dtruit est retir avec ses enfants : les profondeurs et
+    // l'ordre de rendu des autres objets ne changent pas
+    if (object->TestFlag(UIObject::Flag::TO_DELETE)) return;
+
+    // 0 est rserv aux objets dont la profondeur n'a jamais t calcule
+    if (++m_hierarchyVersion == 0) m_hierarchyVersion = 1;
+    OnOrderChanged(object);
+}
+
+void UIObjectManager::UpdateTreeOrder()
+{
+    m_treeOrder.clear();
+    m_treeStack.clear();
+
+    // Racines dans l'ordre de cration, empiles  l'envers
+    for (UIObject *gameObject : m_objects)
+    {
+        if (gameObject->m_parent == nullptr) m_treeStack.push_back(gameObject);
+    }
+    std::sort(m_treeStack.begin(), m_treeStack.end(),
+        [](const UIObject *a, const UIObject *b) { return a->GetID() > b->GetID(); });
+
+    // Parcours en profondeur sans rcursion ; les objets pas encore
+    // dmarrs sont traverss mais pas ajouts
+    while (m_treeStack.empty() == false)
+    {
+        UIObject *gameObject = m_treeStack.back();
+        m_treeStack.pop_back();
+        if (gameObject->m_objectIndex >= 0) m_treeOrder.push_back(gameObject);
+
+        const std::vector<UIObject *> &children = gameObject->m_children;
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            m_treeStack.push_back(*it);
+        }
+    }
+    m_treeDirty = false;
+}
+
+void UIObjectManager::RemoveObject(UIObject *object)
+{
+    // Suppression par change avec le dernier objet
+    const int index = object->m_objectIndex;
+    if (index >= 0)
+    {
+        UIObject *lastObject = m_objects.back();
+        m_objects[index] = lastObject;
+        lastObject->m_objectIndex = index;
+        m_objects.pop_back();
+        object->m_objectIndex = -1;
+    }
+
+    // La gnration invalide les poignes existantes (0 est rserv)
+    Slot &slot = m_slots[object->m_slotIndex];
+    slot.object = nullptr;
+    slot.generation = (slot.generation == UINT32_MAX) ? 1 : slot.generation + 1;
+    m_freeSlots.push_back(object->m_slotIndex);
 }
 
 void UIObjectManager::PrintObjects() const
@@ -189,12 +337,20 @@ bool UIObjectManager::CompareUIObjects(const UIObject *objectA, const UIObject *
 
 void UIObjectManager::ProcessVisibleObjects()
 {
+    if (m_renderListDirty)
+    {
+        // Un layer ou une profondeur a chang
+        std::sort(m_renderList.begin(), m_renderList.end(), CompareUIObjects);
+        m_renderListDirty = false;
+    }
+
+    // La liste de rendu est dj trie selon les layers
     m_visibleObjects.clear();
-    for (UIObject *gameObject : m_visibleSet)
+    for (UIObject *gameObject : m_renderList)
     {
-        m_visibleObjects.push_back(gameObject);
+        if (gameObject->m_visibleFrame == m_visibleFrame)
+        {
+            m_visibleObjects.push_back(gameObject);
+        }
     }
-    
-    // Trie les objets selon leurs layers
-    std::sort(m_visibleObjects.begin(), m_visibleObjects.end(), CompareUIObjects);
 }
@@ -10,6 +10,36 @@
 
 class UIObject;
 
+/// @brief Référence faible vers un UIObject.
+/// Une poignée reste sûre après la destruction de l'objet :
+/// UIObjectManager::Get() renvoie alors nullptr.
+struct UIObjectHandle
+{
+    UIObjectHandle();
+
+    Uint32 index;
+    /// @brief Génération de l'emplacement, 0 pour une poignée nulle.
+    Uint32 generation;
+
+    bool IsNull() const;
+};
+
+/// @brief Gestionnaire des UIObjects d'une scène.
+///
+/// Les objets sont stockés dans des tableaux plats :
+/// - un tableau dense des objets démarrés ;
+/// - l'arbre des objets en profondeur d'abord (parent, puis ses enfants
+///   dans leur ordre d'ajout), parcouru par Scene pour Update() et
+///   reconstruit par ProcessObjects() si la hiérarchie a changé ;
+/// - des emplacements indexés par les poignées (UIObjectHandle), dont la
+///   génération augmente à chaque destruction ;
+/// - la liste de rendu, triée par layer, profondeur puis identifiant, qui
+///   n'est triée à nouveau que si un layer ou une profondeur change.
+///
+/// La visibilité est valable une frame : un objet appelle SetVisible() dans
+/// Update() pour être dessiné. Elle est enregistrée par un numéro de frame
+/// dans l'objet, sans conteneur à vider.
+/// Start() et la destruction sont différés jusqu'au prochain ProcessObjects().
 class UIObjectManager
 {
 public:
@@ -23,42 +53,92 @@ public:
     void SetVisible(UIObject *object, bool visible);
     bool IsVisible(UIObject *object) const;
     void DeleteObjects();
+
+    /// @brief Indique si un objet est démarré et non détruit.
+    /// Le pointeur n'est pas déréférencé (recherche linéaire) : préférer
+    /// les poignées pour suivre un objet qui peut être détruit.
     bool Contains(UIObject *object) const;
 
+    UIObjectHandle GetHandle(UIObject *object) const;
+    UIObject *Get(UIObjectHandle handle) const;
+
     void ClearVisibleObjects();
-         
+
     void ProcessObjects();
     void ProcessVisibleObjects();
 
-    std::set<UIObject *>::iterator begin();
-    std::set<UIObject *>::iterator end();
+    /// @brief Parcourt les objets démarrés en profondeur d'abord.
+    std::vector<UIObject *>::iterator begin();
+    std::vector<UIObject *>::iterator end();
 
     const std::vector<UIObject *>::iterator visibleObjectsBegin();
     const std::vector<UIObject *>::iterator visibleObjectsEnd();
 
+    int GetObjectCount() const;
+
     void PrintObjects() const;
 
 private:
     friend class UIObject;
     int m_nextID;
 
+    struct Slot
+    {
+        UIObject *object;
+        Uint32 generation;
+    };
+
+    /// @brief Objets démarrés, dans un ordre quelconque.
+    std::vector<UIObject *> m_objects;
+    std::vector<Slot> m_slots;
+    std::vector<Uint32> m_freeSlots;
+
+    /// @brief Objets démarrés en profondeur d'abord.
+    std::vector<UIObject *> m_treeOrder;
+    std::vector<UIObject *> m_treeStack;
+    bool m_treeDirty;
+    /// @brief Incrémentée à chaque changement de parent, invalide les
+    /// profondeurs mémorisées par les objets (voir UIObject::GetDepth()).
+    Uint32 m_hierarchyVersion;
+
+    /// @brief Objets démarrés triés selon CompareUIObjects().
+    std::vector<UIObject *> m_renderList;
+    bool m_renderListDirty;
     std::vector<UIObject *> m_visibleObjects;
-    std::set<UIObject *> m_objects;
-    std::set<UIObject *> m_visibleSet;
-    std::set<UIObject *> m_toProcess;
+    Uint64 m_visibleFrame;
+
+    std::vector<UIObject *> m_toStart;
+    std::vector<UIObject *> m_toDelete;
+    /// @brief Files en cours de traitement (échangées avec les précédentes
+    /// pour conserver la capacité des tableaux).
+    std::vector<UIObject *> m_processStart;
+    std::vector<UIObject *> m_processDelete;
+
+    /// @brief Signale que le layer ou la profondeur d'un objet a changé.
+    void OnOrderChanged(UIObject *object);
+    void OnHierarchyChanged(UIObject *object);
+    void UpdateTreeOrder();
+    void RemoveObject(UIObject *object);
+    /// @brief Appelle OnDelete() puis détruit les objets de m_processDelete.
+    void DestroyObjects();
 
     void PrintObjectsRec(UIObject *gameObject) const;
     static bool CompareUIObjects(const UIObject *objectA, const UIObject *objectB);
 };
 
-inline std::set<UIObject*>::iterator UIObjectManager::begin()
+inline bool UIObjectHandle::IsNull() const
+{
+    return generation == 0;
+}
+
+inline std::vector<UIObject*>::iterator UIObjectManager::begin()
 {
-    return m_objects.begin();
+    return m_treeOrder.begin();
 }
 
-inline std::set<UIObject*>::iterator UIObjectManager::end()
+inline std::vector<UIObject*>::iterator UIObjectManager::end()
 {
-    return m_objects.end();
+    return m_treeOrder.end();
 }
 
 inline const std::vector<UIObject *>::iterator UIObjectManager::visibleObjectsBegin()
@@ -71,8 +151,15 @@ inline const std::vector<UIObject *>::iterator UIObjectManager::visibleObjectsEn
     return m_visibleObjects.end();
 }
 
-inline bool UIObjectManager::IsVisible(UIObject *object) const
+inline int UIObjectManager::GetObjectCount() const
 {
-    auto it = m_visibleSet.find(object);
-    return it != m_visibleSet.end();
+    return (int)m_objects.size();
+}
+
+inline UIObject *UIObjectManager::Get(UIObjectHandle handle) const
+{
+    if (handle.index >= m_slots.size()) return nullptr;
+
+    const Slot &slot = m_slots[handle.index];
+    return (slot.generation == handle.generation) ? slot.object : nullptr;
 }
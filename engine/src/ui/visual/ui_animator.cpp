@@ -43,7 +43,7 @@ void UIAnimator::Render()
 
     if (m_stretch)
     {
-        SDL_RenderTexture(g_renderer, texture, srcRect, &dstRect);
+        SDL_RenderTexture(m_scene->GetRenderer(), texture, srcRect, &dstRect);
     }
     else
     {
@@ -86,7 +86,7 @@ void UIAnimator::Render()
         dstRect.h = (float)srcRect->h * m_scale * viewportScale;
         dstRect.w = (float)srcRect->w * m_scale * viewportScale;
 
-        RenderTexture(g_renderer, texture, srcRect, &dstRect, m_anchor);
+        RenderTexture(m_scene->GetRenderer(), texture, srcRect, &dstRect, m_anchor);
     }
 }
 
@@ -27,10 +27,10 @@ void UIFillRect::Render()
     SDL_FRect rect = GetRenderRect();
     Color color = GetColor();
     SDL_SetRenderDrawColor(
-        g_renderer, color.r, color.g, color.b,
+        m_scene->GetRenderer(), color.r, color.g, color.b,
         (Uint8)(color.a * alpha)
     );
-    SDL_RenderFillRect(g_renderer, &rect);
+    SDL_RenderFillRect(m_scene->GetRenderer(), &rect);
 }
 
 void UIFillRect::DrawImGui()
@@ -37,7 +37,7 @@ void UIImage::Render()
     {
     default:
     case UIImage::RenderMode::STRETCH:
-        SDL_RenderTexture(g_renderer, texture, srcRect, &dstRect);
+        SDL_RenderTexture(m_scene->GetRenderer(), texture, srcRect, &dstRect);
         break;
 
     case UIImage::RenderMode::ANCHOR:
@@ -79,13 +79,13 @@ void UIImage::Render()
         }
         dstRect.h = srcRect->h * m_scale * viewportScale;
         dstRect.w = srcRect->w * m_scale * viewportScale;
-        RenderTexture(g_renderer, texture, srcRect, &dstRect, m_anchor);
+        RenderTexture(m_scene->GetRenderer(), texture, srcRect, &dstRect, m_anchor);
         break;
     }
 
     case UIImage::RenderMode::BORDERS:
         RenderTexture9Grid(
-            g_renderer, texture, srcRect, &dstRect, Anchor::NORTH_WEST,
+            m_scene->GetRenderer(), texture, srcRect, &dstRect, Anchor::NORTH_WEST,
             m_borders.left, m_borders.right,
             m_borders.top, m_borders.bottom,
             m_borders.scale * viewportScale
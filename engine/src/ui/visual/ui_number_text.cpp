@@ -0,0 +1,179 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "ui/visual/ui_number_text.h"
+#include "rendering/glyph_atlas.h"
+
+#include <charconv>
+
+UINumberText::UINumberText(Scene *scene, int fontID, Color color, int value)
+    : UIObject(scene)
+    , m_fontID(fontID)
+    , m_value(value)
+    , m_anchor(Anchor::CENTER)
+    , m_prefix()
+    , m_suffix()
+    , m_text()
+    , m_pixelW(0.f)
+    , m_pixelH(0.f)
+    , m_glyphAtlas(nullptr)
+    , m_fontGeneration(0)
+{
+    SetName("UINumberText");
+    SetColor(color);
+
+    UpdateGlyphAtlas();
+}
+
+void UINumberText::SetValue(int value)
+{
+    if (value == m_value) return;
+    m_value = value;
+    UpdateText();
+}
+
+void UINumberText::SetPrefix(const std::string &prefix)
+{
+    m_prefix = prefix;
+    UpdateText();
+}
+
+void UINumberText::SetSuffix(const std::string &suffix)
+{
+    m_suffix = suffix;
+    UpdateText();
+}
+
+void UINumberText::UpdateText()
+{
+    char *end = m_text + MAX_LENGTH - 1;
+    char *ptr = m_text;
+    ptr += m_prefix.copy(ptr, end - ptr);
+    ptr = std::to_chars(ptr, end, m_value).ptr;
+    ptr += m_suffix.copy(ptr, end - ptr);
+    *ptr = '\0';
+
+    if (m_glyphAtlas)
+    {
+        m_pixelW = m_glyphAtlas->GetTextWidth(m_text);
+        m_pixelH = m_glyphAtlas->GetHeight();
+    }
+}
+
+void UINumberText::UpdateGlyphAtlas()
+{
+    AssetManager *assets = m_scene->GetAssetManager();
+    m_fontGeneration = assets->GetFontGeneration();
+    m_glyphAtlas = assets->GetGlyphAtlas(m_fontID);
+    UpdateText();
+}
+
+b2Vec2 UINumberText::GetNativeUISize() const
+{
+    float pixelsPerUnit = m_scene->GetUIPixelsPerUnit();
+    return 1.0f / pixelsPerUnit * b2Vec2(m_pixelW, m_pixelH);
+}
+
+void UINumberText::Render()
+{
+    if (IsEnabled() == false) return;
+
+    // L'atlas a pu être supprimé si la taille des polices a changé depuis Update()
+    if (m_fontGeneration != m_scene->GetAssetManager()->GetFontGeneration())
+    {
+        UpdateGlyphAtlas();
+    }
+    if (m_glyphAtlas == nullptr) return;
+
+    SDL_Texture *texture = m_glyphAtlas->GetTexture();
+    const Color color = GetColor();
+    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaModFloat(texture, GetAlpha() * (float)color.a / 255.f);
+
+    SDL_FRect dstRect = GetRenderRect();
+    dstRect.w -= m_pixelW;
+    dstRect.h -= m_pixelH;
+
+    switch (m_anchor)
+    {
+    case Anchor::NORTH_WEST:
+        break;
+    case Anchor::NORTH:
+        dstRect.x += 0.5f * dstRect.w;
+        break;
+    case Anchor::NORTH_EAST:
+        dstRect.x += dstRect.w;
+        break;
+    case Anchor::WEST:
+        dstRect.y += 0.5f * dstRect.h;
+        break;
+    case Anchor::CENTER:
+        dstRect.x += 0.5f * dstRect.w;
+        dstRect.y += 0.5f * dstRect.h;
+        break;
+    case Anchor::EAST:
+        dstRect.x += dstRect.w;
+        dstRect.y += 0.5f * dstRect.h;
+        break;
+    case Anchor::SOUTH_WEST:
+        dstRect.y += dstRect.h;
+        break;
+    case Anchor::SOUTH:
+        dstRect.x += 0.5f * dstRect.w;
+        dstRect.y += dstRect.h;
+        break;
+    case Anchor::SOUTH_EAST:
+        dstRect.x += dstRect.w;
+        dstRect.y += dstRect.h;
+        break;
+    default:
+        break;
+    }
+
+    float x = roundf(dstRect.x);
+    const float y = roundf(dstRect.y);
+    SDL_Renderer *renderer = m_scene->GetRenderer();
+    for (const char *c = m_text; *c != '\0'; c++)
+    {
+        const SDL_FRect *srcRect = m_glyphAtlas->GetGlyphRect(*c);
+        if (srcRect == nullptr) continue;
+
+        const SDL_FRect glyphRect = { x, y, srcRect->w, srcRect->h };
+        SDL_RenderTexture(renderer, texture, srcRect, &glyphRect);
+        x += srcRect->w;
+    }
+}
+
+void UINumberText::Update()
+{
+    UIObject::Update();
+    SetVisible(true);
+
+    // L'atlas n'est recherché qu'après un changement de taille des polices
+    if (m_fontGeneration != m_scene->GetAssetManager()->GetFontGeneration())
+    {
+        m_glyphAtlas = nullptr;
+        UpdateGlyphAtlas();
+    }
+}
+
+void UINumberText::DrawImGui()
+{
+    UIObject::DrawImGui();
+
+    ImGui::PushID(this);
+    if (ImGui::CollapsingHeader("UINumberText"))
+    {
+        if (ImGui::BeginTable("UINumberText Members", 2, ImGuiTableFlags_RowBg))
+        {
+            ImGuiUtils::Member("Anchor", ENUM_STRING(m_anchor));
+            ImGuiUtils::Member("Text", m_text);
+
+            ImGui::EndTable();
+        }
+    }
+    ImGui::PopID();
+}
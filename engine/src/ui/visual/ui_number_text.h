@@ -0,0 +1,66 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "ui/ui_object.h"
+
+class GlyphAtlas;
+
+/// @brief Nombre entier affiché à partir de l'atlas des chiffres d'une police
+/// (voir AssetManager::GetGlyphAtlas()).
+/// Changer la valeur ne fait ni allocation ni mise en page SDL_ttf : le texte
+/// est formaté dans un tampon fixe et chaque caractère est une copie de texture.
+/// Le préfixe et le suffixe ne peuvent utiliser que les caractères de l'atlas.
+class UINumberText : public UIObject
+{
+public:
+    UINumberText(Scene *scene, int fontID, Color color, int value = 0);
+
+    void SetValue(int value);
+    int GetValue() const;
+
+    void SetPrefix(const std::string &prefix);
+    void SetSuffix(const std::string &suffix);
+    void SetAnchor(Anchor anchor);
+
+    b2Vec2 GetNativeUISize() const;
+
+    virtual void Render() override;
+    virtual void Update() override;
+    virtual void DrawImGui() override;
+
+private:
+    static constexpr int MAX_LENGTH = 32;
+
+    int m_fontID;
+    int m_value;
+    Anchor m_anchor;
+    std::string m_prefix;
+    std::string m_suffix;
+
+    /// @brief Texte formaté, refait uniquement quand la valeur change.
+    char m_text[MAX_LENGTH];
+    float m_pixelW;
+    float m_pixelH;
+    /// @brief Atlas valide pour la génération m_fontGeneration des polices.
+    GlyphAtlas *m_glyphAtlas;
+    Uint32 m_fontGeneration;
+
+    void UpdateText();
+    void UpdateGlyphAtlas();
+};
+
+inline int UINumberText::GetValue() const
+{
+    return m_value;
+}
+
+inline void UINumberText::SetAnchor(Anchor anchor)
+{
+    m_anchor = anchor;
+}
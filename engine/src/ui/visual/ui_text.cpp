@@ -13,18 +13,22 @@ UIText::UIText(Scene *scene, const std::string &str, TTF_Font *font, Color color
     , m_pixelW(0)
     , m_pixelH(0)
     , m_ttfText(nullptr)
+    , m_string(str)
+    , m_fontSize(0.f)
+    , m_textColor()
 {
     SetName("UIText");
     SetColor(color);
 
-    m_ttfText = TTF_CreateText(g_textEngine, font, str.c_str(), str.length());
+    m_ttfText = TTF_CreateText(m_scene->GetTextEngine(), font, str.c_str(), str.length());
     assert(m_ttfText);
 
     bool success = true;
+    m_textColor = { color.r, color.g, color.b, color.a };
     success = TTF_SetTextColor(m_ttfText, color.r, color.g, color.b, color.a);
     assert(success);
-    success = TTF_GetTextSize(m_ttfText, &m_pixelW, &m_pixelH);
-    assert(success);
+
+    UpdateLayout();
 }
 
 UIText::~UIText()
@@ -34,9 +38,21 @@ UIText::~UIText()
 
 void UIText::SetString(const std::string &str)
 {
+    if (str == m_string) return;
+    m_string = str;
+
     bool success = true;
     success = TTF_SetTextString(m_ttfText, str.c_str(), str.length());
     assert(success);
+
+    UpdateLayout();
+}
+
+void UIText::UpdateLayout()
+{
+    m_fontSize = TTF_GetFontSize(TTF_GetTextFont(m_ttfText));
+
+    bool success = true;
     success = TTF_GetTextSize(m_ttfText, &m_pixelW, &m_pixelH);
     assert(success);
 }
@@ -48,11 +64,16 @@ void UIText::Render()
     bool success = true;
     float fadeAlpha = GetAlpha();
     Color color = GetColor();
-    success = TTF_SetTextColor(
-        m_ttfText, color.r, color.g, color.b,
-        static_cast<Uint8>(fadeAlpha * color.a)
-    );
-    assert(success);
+    const SDL_Color textColor = {
+        color.r, color.g, color.b, static_cast<Uint8>(fadeAlpha * color.a)
+    };
+    if (textColor.r != m_textColor.r || textColor.g != m_textColor.g ||
+        textColor.b != m_textColor.b || textColor.a != m_textColor.a)
+    {
+        m_textColor = textColor;
+        success = TTF_SetTextColor(m_ttfText, textColor.r, textColor.g, textColor.b, textColor.a);
+        assert(success);
+    }
 
     SDL_FRect dstRect = GetRenderRect();
     dstRect.w -= static_cast<float>(m_pixelW);
@@ -105,9 +126,11 @@ void UIText::Update()
     UIObject::Update();
     SetVisible(true);
 
-    bool success = true;
-    success = TTF_GetTextSize(m_ttfText, &m_pixelW, &m_pixelH);
-    assert(success);
+    // La police peut être partagée et redimensionnée par ailleurs
+    if (TTF_GetFontSize(TTF_GetTextFont(m_ttfText)) != m_fontSize)
+    {
+        UpdateLayout();
+    }
 }
 
 void UIText::DrawImGui()
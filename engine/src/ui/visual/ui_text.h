@@ -9,6 +9,11 @@
 #include "game_engine_settings.h"
 #include "ui/ui_object.h"
 
+/// @brief Texte affiché avec SDL_ttf.
+/// La mise en page (TTF_GetTextSize) n'est refaite que lorsque le texte ou
+/// la taille de la police change, et la couleur n'est transmise à SDL_ttf
+/// que lorsqu'elle change. Pour un nombre mis à jour à chaque frame,
+/// préférer UINumberText.
 class UIText : public UIObject
 {
 public:
@@ -25,7 +30,7 @@ public:
     void SetString(const std::string &str);
     void SetAnchor(Anchor anchor);
 
-    const std::string GetString() const;
+    const std::string &GetString() const;
 
     void GetNativePixelSize(int &pixelWidth, int &pixelHeight) const;
     b2Vec2 GetNativeUISize() const;
@@ -42,6 +47,13 @@ protected:
     int m_pixelH;
 
     TTF_Text *m_ttfText;
+
+    /// @brief Etat transmis à SDL_ttf, pour ne le modifier qu'en cas de changement.
+    std::string m_string;
+    float m_fontSize;
+    SDL_Color m_textColor;
+
+    void UpdateLayout();
 };
 
 inline void UIText::SetAnchor(Anchor anchor)
@@ -50,9 +62,9 @@ inline void UIText::SetAnchor(Anchor anchor)
     m_anchor = anchor;
 }
 
-inline const std::string UIText::GetString() const
+inline const std::string &UIText::GetString() const
 {
-    return std::string(m_ttfText->text);
+    return m_string;
 }
 
 inline void UIText::SetRenderMode(RenderMode renderMode)
@@ -224,17 +224,52 @@ void GizmosShape::SetAsChain(const b2ChainId chainId, const b2Transform &transfo
 }
 
 void GizmosShape::Render(
-    SDL_Renderer *renderer, const Camera &camera, const Transform &cameraTransform)
+    LineBatch &batch, Color color, const Camera &camera, const Transform &cameraTransform) const
 {
     if (m_vertices.size() < 2) return;
 
-    SDL_FPoint points[2] = { 0 };
-    camera.WorldToView(cameraTransform.position, m_vertices[0], points[0].x, points[0].y);
+    SDL_FPoint *points = batch.AddPolyline(color, (int)m_vertices.size());
+    for (int i = 0; i < m_vertices.size(); ++i)
+    {
+        camera.WorldToView(cameraTransform.position, m_vertices[i], points[i].x, points[i].y);
+    }
+}
 
-    for (int i = 1; i < m_vertices.size(); ++i)
+GizmosBuffer::GizmosBuffer()
+    : m_entries()
+    , m_vertices()
+{
+}
+
+void GizmosBuffer::Clear()
+{
+    m_entries.clear();
+    m_vertices.clear();
+}
+
+void GizmosBuffer::Add(Color color, const GizmosShape &shape)
+{
+    const std::vector<b2Vec2> &vertices = shape.GetVertices();
+    if (vertices.size() < 2) return;
+
+    Entry entry;
+    entry.color = color;
+    entry.firstVertex = (int)m_vertices.size();
+    entry.vertexCount = (int)vertices.size();
+    m_entries.push_back(entry);
+    m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+}
+
+void GizmosBuffer::Render(
+    LineBatch &batch, const Camera &camera, const Transform &cameraTransform) const
+{
+    for (const Entry &entry : m_entries)
     {
-        camera.WorldToView(cameraTransform.position, m_vertices[i], points[1].x, points[1].y);
-        SDL_RenderLines(g_renderer, points, 2);
-        points[0] = points[1];
+        SDL_FPoint *points = batch.AddPolyline(entry.color, entry.vertexCount);
+        for (int i = 0; i < entry.vertexCount; ++i)
+        {
+            const b2Vec2 vertex = m_vertices[entry.firstVertex + i];
+            camera.WorldToView(cameraTransform.position, vertex, points[i].x, points[i].y);
+        }
     }
 }
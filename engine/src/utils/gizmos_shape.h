@@ -9,6 +9,7 @@
 #include "game_engine_settings.h"
 #include "game_engine_common.h"
 #include "ecs/basic_components.h"
+#include "rendering/line_batch.h"
 
 class GizmosShape
 {
@@ -32,8 +33,53 @@ public:
     void SetAsCapsule(const b2Capsule &capsule,  const b2Transform &transform = b2Transform_identity);
     void SetAsChain(const b2ChainId chainId, const b2Transform &transform = b2Transform_identity);
 
-    void Render(SDL_Renderer *renderer, const Camera &camera, const Transform &cameraTransform);
+    /// @brief Ajoute la forme à un lot de lignes, en une seule ligne brisée.
+    void Render(LineBatch &batch, Color color, const Camera &camera, const Transform &cameraTransform) const;
+
+    const std::vector<b2Vec2> &GetVertices() const;
 
 private:
     std::vector<b2Vec2> m_vertices;
 };
+
+/// @brief Formes à dessiner, stockées à la suite dans un même tableau de sommets.
+/// Clear() conserve la capacité des tableaux : le tampon est une arène
+/// réutilisée à chaque pas, qui n'alloue plus une fois sa taille atteinte.
+class GizmosBuffer
+{
+public:
+    GizmosBuffer();
+
+    void Clear();
+    void Add(Color color, const GizmosShape &shape);
+    void Render(LineBatch &batch, const Camera &camera, const Transform &cameraTransform) const;
+
+    int GetShapeCount() const;
+    int GetVertexCount() const;
+
+private:
+    struct Entry
+    {
+        Color color;
+        int firstVertex;
+        int vertexCount;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<b2Vec2> m_vertices;
+};
+
+inline const std::vector<b2Vec2> &GizmosShape::GetVertices() const
+{
+    return m_vertices;
+}
+
+inline int GizmosBuffer::GetShapeCount() const
+{
+    return (int)m_entries.size();
+}
+
+inline int GizmosBuffer::GetVertexCount() const
+{
+    return (int)m_vertices.size();
+}
@@ -0,0 +1,29 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/random.h"
+
+RandomStream::RandomStream(uint64_t seed)
+    : m_state()
+{
+    Seed(seed);
+}
+
+void RandomStream::Seed(uint64_t seed)
+{
+    // SplitMix64 : des graines proches donnent des états très différents
+    for (int i = 0; i < 2; i++)
+    {
+        seed += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z = z ^ (z >> 31);
+
+        m_state[2 * i] = (uint32_t)z;
+        m_state[2 * i + 1] = (uint32_t)(z >> 32);
+    }
+}
@@ -0,0 +1,90 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Générateur pseudo-aléatoire rapide (xoshiro128**).
+/// Contrairement à rand(), chaque instance a son propre état : une même graine
+/// produit toujours la même suite, quel que soit l'ordre d'utilisation
+/// des autres générateurs.
+class RandomStream
+{
+public:
+    using State = std::array<uint32_t, 4>;
+
+    RandomStream(uint64_t seed = 0);
+
+    /// @brief Réinitialise le générateur à partir d'une graine.
+    void Seed(uint64_t seed);
+
+    uint32_t Next();
+
+    /// @brief Renvoie un entier entre min et max (inclus).
+    int RangeI(int min, int max);
+
+    /// @brief Renvoie un flottant entre min et max.
+    float RangeF(float min, float max);
+
+    bool Bool();
+
+    const State &GetState() const;
+    void SetState(const State &state);
+
+private:
+    State m_state;
+
+    static uint32_t Rotl(uint32_t x, int k);
+};
+
+inline uint32_t RandomStream::Rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+inline uint32_t RandomStream::Next()
+{
+    const uint32_t result = Rotl(m_state[1] * 5, 7) * 9;
+    const uint32_t t = m_state[1] << 9;
+
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = Rotl(m_state[3], 11);
+
+    return result;
+}
+
+inline int RandomStream::RangeI(int min, int max)
+{
+    const uint64_t range = (uint64_t)((int64_t)max - (int64_t)min + 1);
+    return min + (int)(((uint64_t)Next() * range) >> 32);
+}
+
+inline float RandomStream::RangeF(float min, float max)
+{
+    // 24 bits de mantisse : valeur uniforme dans [0, 1)
+    const float value = (float)(Next() >> 8) * (1.f / 16777216.f);
+    return min + (max - min) * value;
+}
+
+inline bool RandomStream::Bool()
+{
+    return (Next() >> 31) != 0;
+}
+
+inline const RandomStream::State &RandomStream::GetState() const
+{
+    return m_state;
+}
+
+inline void RandomStream::SetState(const State &state)
+{
+    m_state = state;
+}
@@ -0,0 +1,266 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/simd_math.h"
+#include <cfloat>
+
+namespace
+{
+#if defined(SIMD_AVX2)
+    using FloatW = __m256;
+    inline FloatW Load(const float *p) { return _mm256_loadu_ps(p); }
+    inline void Store(float *p, FloatW a) { _mm256_storeu_ps(p, a); }
+    inline FloatW Splat(float a) { return _mm256_set1_ps(a); }
+    inline FloatW Add(FloatW a, FloatW b) { return _mm256_add_ps(a, b); }
+    inline FloatW Sub(FloatW a, FloatW b) { return _mm256_sub_ps(a, b); }
+    inline FloatW Mul(FloatW a, FloatW b) { return _mm256_mul_ps(a, b); }
+    inline FloatW Div(FloatW a, FloatW b) { return _mm256_div_ps(a, b); }
+    inline FloatW Min(FloatW a, FloatW b) { return _mm256_min_ps(a, b); }
+    inline FloatW Max(FloatW a, FloatW b) { return _mm256_max_ps(a, b); }
+    inline FloatW Abs(FloatW a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    inline FloatW Less(FloatW a, FloatW b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline FloatW Select(FloatW mask, FloatW a, FloatW b) { return _mm256_blendv_ps(b, a, mask); }
+#elif defined(SIMD_SSE2)
+    using FloatW = __m128;
+    inline FloatW Load(const float *p) { return _mm_loadu_ps(p); }
+    inline void Store(float *p, FloatW a) { _mm_storeu_ps(p, a); }
+    inline FloatW Splat(float a) { return _mm_set1_ps(a); }
+    inline FloatW Add(FloatW a, FloatW b) { return _mm_add_ps(a, b); }
+    inline FloatW Sub(FloatW a, FloatW b) { return _mm_sub_ps(a, b); }
+    inline FloatW Mul(FloatW a, FloatW b) { return _mm_mul_ps(a, b); }
+    inline FloatW Div(FloatW a, FloatW b) { return _mm_div_ps(a, b); }
+    inline FloatW Min(FloatW a, FloatW b) { return _mm_min_ps(a, b); }
+    inline FloatW Max(FloatW a, FloatW b) { return _mm_max_ps(a, b); }
+    inline FloatW Abs(FloatW a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    inline FloatW Less(FloatW a, FloatW b) { return _mm_cmplt_ps(a, b); }
+    inline FloatW Select(FloatW mask, FloatW a, FloatW b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+#elif defined(SIMD_NEON)
+    using FloatW = float32x4_t;
+    inline FloatW Load(const float *p) { return vld1q_f32(p); }
+    inline void Store(float *p, FloatW a) { vst1q_f32(p, a); }
+    inline FloatW Splat(float a) { return vdupq_n_f32(a); }
+    inline FloatW Add(FloatW a, FloatW b) { return vaddq_f32(a, b); }
+    inline FloatW Sub(FloatW a, FloatW b) { return vsubq_f32(a, b); }
+    inline FloatW Mul(FloatW a, FloatW b) { return vmulq_f32(a, b); }
+    inline FloatW Div(FloatW a, FloatW b) { return vdivq_f32(a, b); }
+    inline FloatW Min(FloatW a, FloatW b) { return vminq_f32(a, b); }
+    inline FloatW Max(FloatW a, FloatW b) { return vmaxq_f32(a, b); }
+    inline FloatW Abs(FloatW a) { return vabsq_f32(a); }
+    inline FloatW Less(FloatW a, FloatW b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+    inline FloatW Select(FloatW mask, FloatW a, FloatW b)
+    {
+        return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+    }
+#endif
+
+    // Opérations sur des octets. SSE2 et AVX2 n'ont pas de multiplication
+    // 8 bits : les octets pairs et impairs sont multipliés sur 16 bits.
+#if defined(SIMD_AVX2)
+    using ByteW = __m256i;
+    inline ByteW LoadBytes(const Uint8 *p) { return _mm256_loadu_si256((const __m256i *)p); }
+    inline void StoreBytes(Uint8 *p, ByteW a) { _mm256_storeu_si256((__m256i *)p, a); }
+    inline ByteW SplatByte(Uint8 a) { return _mm256_set1_epi8((char)a); }
+    inline ByteW AddBytes(ByteW a, ByteW b) { return _mm256_add_epi8(a, b); }
+    inline ByteW XorBytes(ByteW a, ByteW b) { return _mm256_xor_si256(a, b); }
+    inline ByteW MulBytes(ByteW a, Uint8 b)
+    {
+        const __m256i factor = _mm256_set1_epi16(b);
+        const __m256i even = _mm256_and_si256(
+            _mm256_mullo_epi16(a, factor), _mm256_set1_epi16(0x00FF));
+        const __m256i odd = _mm256_slli_epi16(
+            _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), factor), 8);
+        return _mm256_or_si256(even, odd);
+    }
+#elif defined(SIMD_SSE2)
+    using ByteW = __m128i;
+    inline ByteW LoadBytes(const Uint8 *p) { return _mm_loadu_si128((const __m128i *)p); }
+    inline void StoreBytes(Uint8 *p, ByteW a) { _mm_storeu_si128((__m128i *)p, a); }
+    inline ByteW SplatByte(Uint8 a) { return _mm_set1_epi8((char)a); }
+    inline ByteW AddBytes(ByteW a, ByteW b) { return _mm_add_epi8(a, b); }
+    inline ByteW XorBytes(ByteW a, ByteW b) { return _mm_xor_si128(a, b); }
+    inline ByteW MulBytes(ByteW a, Uint8 b)
+    {
+        const __m128i factor = _mm_set1_epi16(b);
+        const __m128i even = _mm_and_si128(
+            _mm_mullo_epi16(a, factor), _mm_set1_epi16(0x00FF));
+        const __m128i odd = _mm_slli_epi16(
+            _mm_mullo_epi16(_mm_srli_epi16(a, 8), factor), 8);
+        return _mm_or_si128(even, odd);
+    }
+#elif defined(SIMD_NEON)
+    using ByteW = uint8x16_t;
+    inline ByteW LoadBytes(const Uint8 *p) { return vld1q_u8(p); }
+    inline void StoreBytes(Uint8 *p, ByteW a) { vst1q_u8(p, a); }
+    inline ByteW SplatByte(Uint8 a) { return vdupq_n_u8(a); }
+    inline ByteW AddBytes(ByteW a, ByteW b) { return vaddq_u8(a, b); }
+    inline ByteW XorBytes(ByteW a, ByteW b) { return veorq_u8(a, b); }
+    inline ByteW MulBytes(ByteW a, Uint8 b) { return vmulq_u8(a, vdupq_n_u8(b)); }
+#endif
+
+#if defined(SIMD_AVX2) || defined(SIMD_SSE2) || defined(SIMD_NEON)
+    /// Reprend l'approximation de b2Atan2() sur LANE_COUNT éléments.
+    /// Voir https://mazzo.li/posts/vectorized-atan2.html
+    inline FloatW Atan2(FloatW y, FloatW x)
+    {
+        const FloatW zero = Splat(0.f);
+        const FloatW ax = Abs(x);
+        const FloatW ay = Abs(y);
+        const FloatW mx = Max(ay, ax);
+        const FloatW mn = Min(ay, ax);
+        const FloatW a = Div(mn, Add(mx, Splat(FLT_MIN)));
+
+        // Approximation polynomiale de atan(a) sur [0,1]
+        const FloatW s = Mul(a, a);
+        const FloatW c = Mul(s, a);
+        const FloatW q = Mul(s, s);
+        FloatW r = Add(Mul(Splat(0.024840285f), q), Splat(0.18681418f));
+        FloatW t = Sub(Mul(Splat(-0.094097948f), q), Splat(0.33213072f));
+        r = Add(Mul(r, s), t);
+        r = Add(Mul(r, c), a);
+
+        // Ramène le résultat sur le cercle complet
+        r = Select(Less(ax, ay), Sub(Splat(1.57079637f), r), r);
+        r = Select(Less(x, zero), Sub(Splat(3.14159274f), r), r);
+        r = Select(Less(y, zero), Sub(zero, r), r);
+        return r;
+    }
+#endif
+}
+
+const char *simd::GetInstructionSetName()
+{
+#if defined(SIMD_AVX2)
+    return "AVX2";
+#elif defined(SIMD_SSE2)
+    return "SSE2";
+#elif defined(SIMD_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void simd::TransformArrays::Resize(size_t count)
+{
+    const size_t size = (count + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+    if (size <= prevX.size()) return;
+
+    for (std::vector<float> *array : {
+        &prevX, &prevY, &prevC, &prevS,
+        &currX, &currY, &currC, &currS,
+        &outX, &outY, &outAngle })
+    {
+        array->resize(size, 0.f);
+    }
+}
+
+void simd::InterpolateTransformsScalar(TransformArrays &arrays, size_t count, float alpha)
+{
+    const float t = fminf(fmaxf(alpha, 0.f), 1.f);
+    const float omt = 1.f - t;
+    for (size_t i = 0; i < count; i++)
+    {
+        arrays.outX[i] = omt * arrays.prevX[i] + t * arrays.currX[i];
+        arrays.outY[i] = omt * arrays.prevY[i] + t * arrays.currY[i];
+
+        // Pas besoin de normaliser la rotation, atan2 est invariant par échelle
+        const float c = omt * arrays.prevC[i] + t * arrays.currC[i];
+        const float s = omt * arrays.prevS[i] + t * arrays.currS[i];
+        arrays.outAngle[i] = b2Atan2(s, c);
+    }
+}
+
+void simd::InterpolateTransforms(TransformArrays &arrays, size_t count, float alpha)
+{
+#if defined(SIMD_AVX2) || defined(SIMD_SSE2) || defined(SIMD_NEON)
+    assert(arrays.prevX.size() >= count);
+
+    const float tf = fminf(fmaxf(alpha, 0.f), 1.f);
+    const FloatW t = Splat(tf);
+    const FloatW omt = Splat(1.f - tf);
+
+    // Les tableaux ont une taille multiple de LANE_COUNT (voir Resize)
+    for (size_t i = 0; i < count; i += LANE_COUNT)
+    {
+        FloatW x = Add(Mul(omt, Load(&arrays.prevX[i])), Mul(t, Load(&arrays.currX[i])));
+        FloatW y = Add(Mul(omt, Load(&arrays.prevY[i])), Mul(t, Load(&arrays.currY[i])));
+        FloatW c = Add(Mul(omt, Load(&arrays.prevC[i])), Mul(t, Load(&arrays.currC[i])));
+        FloatW s = Add(Mul(omt, Load(&arrays.prevS[i])), Mul(t, Load(&arrays.currS[i])));
+
+        Store(&arrays.outX[i], x);
+        Store(&arrays.outY[i], y);
+        Store(&arrays.outAngle[i], Atan2(s, c));
+    }
+#else
+    InterpolateTransformsScalar(arrays, count, alpha);
+#endif
+}
+
+void simd::RetriveBytesScalar(Uint8 *memory, size_t size, Uint8 prev)
+{
+    if (size == 0) return;
+
+    // Parcours à rebours : l'octet précédent est encore codé
+    for (size_t i = size - 1; i > 0; i--)
+    {
+        memory[i] = 0x73 * (memory[i] + 0x37);
+        memory[i] ^= memory[i - 1];
+    }
+    memory[0] = 0x73 * (memory[0] + 0x37);
+    memory[0] ^= prev;
+}
+
+void simd::RetriveBytes(Uint8 *memory, size_t size, Uint8 prev)
+{
+    size_t i = size;
+#if defined(SIMD_AVX2) || defined(SIMD_SSE2) || defined(SIMD_NEON)
+    const ByteW offset = SplatByte(0x37);
+
+    // Chaque paquet est lu (avec l'octet qui le précède) avant d'être écrit,
+    // et le paquet suivant est situé avant lui dans le tampon
+    while (i > (size_t)BYTE_LANE_COUNT)
+    {
+        i -= BYTE_LANE_COUNT;
+        const ByteW curr = LoadBytes(memory + i);
+        const ByteW prevBytes = LoadBytes(memory + i - 1);
+        StoreBytes(memory + i, XorBytes(MulBytes(AddBytes(curr, offset), 0x73), prevBytes));
+    }
+#endif
+    RetriveBytesScalar(memory, i, prev);
+}
+
+void simd::ApplyStereoGainScalar(float *samples, size_t sampleCount, float leftGain, float rightGain)
+{
+    for (size_t i = 0; i + 1 < sampleCount; i += 2)
+    {
+        samples[i] *= leftGain;
+        samples[i + 1] *= rightGain;
+    }
+    if (sampleCount % 2) samples[sampleCount - 1] *= leftGain;
+}
+
+void simd::ApplyStereoGain(float *samples, size_t sampleCount, float leftGain, float rightGain)
+{
+    size_t i = 0;
+#if defined(SIMD_AVX2) || defined(SIMD_SSE2) || defined(SIMD_NEON)
+    // LANE_COUNT est pair : chaque paquet commence par un échantillon gauche
+    float gains[LANE_COUNT];
+    for (int j = 0; j < LANE_COUNT; j++)
+    {
+        gains[j] = (j % 2 == 0) ? leftGain : rightGain;
+    }
+    const FloatW gain = Load(gains);
+
+    for (; i + LANE_COUNT <= sampleCount; i += LANE_COUNT)
+    {
+        Store(samples + i, Mul(Load(samples + i), gain));
+    }
+#endif
+    ApplyStereoGainScalar(samples + i, sampleCount - i, leftGain, rightGain);
+}
@@ -0,0 +1,110 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#if defined(__AVX2__)
+#  define SIMD_AVX2
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define SIMD_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  define SIMD_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace simd
+{
+    /// @brief Nombre de flottants traités par instruction SIMD.
+#if defined(SIMD_AVX2)
+    constexpr int LANE_COUNT = 8;
+#elif defined(SIMD_SSE2) || defined(SIMD_NEON)
+    constexpr int LANE_COUNT = 4;
+#else
+    constexpr int LANE_COUNT = 1;
+#endif
+
+    /// @brief Nom du jeu d'instructions utilisé à la compilation.
+    const char *GetInstructionSetName();
+
+    /// @brief Tableaux compacts (structure de tableaux) des transformations
+    /// à interpoler entre deux pas de temps fixes.
+    /// Les rotations sont stockées sous forme de cosinus/sinus (b2Rot).
+    struct TransformArrays
+    {
+        std::vector<float> prevX, prevY, prevC, prevS;
+        std::vector<float> currX, currY, currC, currS;
+        std::vector<float> outX, outY, outAngle;
+
+        /// @brief Redimensionne les tableaux.
+        /// La taille est arrondie au multiple de LANE_COUNT supérieur
+        /// pour que les noyaux SIMD n'aient pas de boucle de fin.
+        void Resize(size_t count);
+
+        void Set(size_t i, const b2Transform &prevXf, const b2Transform &currXf);
+    };
+
+    /// @brief Interpole les transformations par paquets de LANE_COUNT éléments.
+    /// Les positions sont interpolées linéairement et les rotations avec un
+    /// nlerp (sans fonction trigonométrique). L'angle final est obtenu avec
+    /// la même approximation polynomiale que b2Atan2().
+    /// @param arrays les tableaux compacts.
+    /// @param count le nombre de transformations valides.
+    /// @param alpha le paramètre d'interpolation (entre 0 et 1).
+    void InterpolateTransforms(TransformArrays &arrays, size_t count, float alpha);
+
+    /// @brief Version scalaire de InterpolateTransforms().
+    /// Elle sert de référence pour valider les chemins SIMD.
+    void InterpolateTransformsScalar(TransformArrays &arrays, size_t count, float alpha);
+
+    /// @brief Nombre d'octets traités par instruction SIMD.
+#if defined(SIMD_AVX2)
+    constexpr int BYTE_LANE_COUNT = 32;
+#elif defined(SIMD_SSE2) || defined(SIMD_NEON)
+    constexpr int BYTE_LANE_COUNT = 16;
+#else
+    constexpr int BYTE_LANE_COUNT = 1;
+#endif
+
+    /// @brief Décode sur place des octets obfusqués (voir AssetManager::RetriveMem()).
+    /// Chaque octet décodé ne dépend que de l'octet codé qui le précède,
+    /// les octets sont donc décodés par paquets de BYTE_LANE_COUNT.
+    /// Un tampon peut être découpé en morceaux décodés indépendamment.
+    /// @param memory les octets à décoder.
+    /// @param size le nombre d'octets.
+    /// @param prev l'octet codé qui précède le premier octet
+    /// (0x73 pour le début d'un fichier).
+    void RetriveBytes(Uint8 *memory, size_t size, Uint8 prev);
+
+    /// @brief Version scalaire de RetriveBytes().
+    void RetriveBytesScalar(Uint8 *memory, size_t size, Uint8 prev);
+
+    /// @brief Applique un gain à des échantillons stéréo entrelacés
+    /// (gauche, droite, gauche...) par paquets de LANE_COUNT échantillons.
+    /// @param samples les échantillons.
+    /// @param sampleCount le nombre d'échantillons (deux par trame).
+    /// @param leftGain le gain du canal gauche.
+    /// @param rightGain le gain du canal droit.
+    void ApplyStereoGain(float *samples, size_t sampleCount, float leftGain, float rightGain);
+
+    /// @brief Version scalaire de ApplyStereoGain().
+    void ApplyStereoGainScalar(float *samples, size_t sampleCount, float leftGain, float rightGain);
+}
+
+inline void simd::TransformArrays::Set(size_t i, const b2Transform &prevXf, const b2Transform &currXf)
+{
+    prevX[i] = prevXf.p.x;
+    prevY[i] = prevXf.p.y;
+    prevC[i] = prevXf.q.c;
+    prevS[i] = prevXf.q.s;
+    currX[i] = currXf.p.x;
+    currY[i] = currXf.p.y;
+    currC[i] = currXf.q.c;
+    currS[i] = currXf.q.s;
+}
@@ -0,0 +1,51 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+/// @brief Ensemble de threads qui exécutent des tâches indépendantes.
+/// Les tâches sont exécutées dans leur ordre de soumission, par le premier
+/// thread disponible.
+class ThreadPool
+{
+public:
+    /// @brief Crée les threads.
+    /// @param threadCount le nombre de threads (0 pour le nombre de cœurs).
+    ThreadPool(int threadCount = 0);
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ~ThreadPool();
+
+    void Submit(std::function<void()> task);
+
+    /// @brief Attend la fin de toutes les tâches soumises.
+    void Wait();
+
+    int GetThreadCount() const;
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskCondition;
+    std::condition_variable m_doneCondition;
+    int m_activeCount;
+    bool m_stop;
+
+    void WorkerLoop();
+};
+
+inline int ThreadPool::GetThreadCount() const
+{
+    return (int)m_threads.size();
+}
@@ -17,21 +17,21 @@ Timer::Timer()
     m_elapsed = 0;
     m_unscaledElapsed = 0;
 
-    m_maxDelta = 100;
+    m_maxDelta = SDL_MS_TO_NS(100);
     m_scale = 1.0f;
 }
 
 void Timer::Start()
 {
-    m_currentTime = SDL_GetTicks();
-    m_previousTime = SDL_GetTicks();
+    m_currentTime = SDL_GetTicksNS();
+    m_previousTime = m_currentTime;
     m_delta = 0;
 }
 
 void Timer::Update()
 {
     m_previousTime = m_currentTime;
-    m_currentTime = SDL_GetTicks();
+    m_currentTime = SDL_GetTicksNS();
 
     m_unscaledDelta = m_currentTime - m_previousTime;
     if (m_unscaledDelta > m_maxDelta)
@@ -44,9 +44,9 @@ void Timer::Update()
     m_elapsed += m_delta;
 }
 
-void Timer::Update(Uint64 deltaTimeMS)
+void Timer::UpdateNS(Uint64 deltaTimeNS)
 {
-    m_unscaledDelta = deltaTimeMS;
+    m_unscaledDelta = deltaTimeNS;
     if (m_unscaledDelta > m_maxDelta)
     {
         m_unscaledDelta = m_maxDelta;
@@ -10,8 +10,12 @@
 
 /// @ingroup Timer
 /// @brief Structure représentant un chronomètre.
+/// Le temps est mesuré en nanosecondes avec SDL_GetTicksNS() : les écarts
+/// de temps ne sont pas arrondis à la milliseconde.
 class Timer
 {
+    friend class SceneSnapshot;
+
 public:
     Timer();
     Timer(Timer const&) = delete;
@@ -26,6 +30,10 @@ public:
     void Update(float deltaTime);
     void Update(Uint64 deltaTimeMS);
 
+    /// @brief Met à jour le timer avec un écart de temps imposé.
+    /// @param deltaTimeNS l'écart de temps en nanosecondes.
+    void UpdateNS(Uint64 deltaTimeNS);
+
     void SetMaximumDeltaTime(float maxDelta);
 
     /// @brief Définit le facteur d'échelle de temps appliqué à un timer.
@@ -85,52 +93,67 @@ public:
     /// dernière mise à jour (sans échelle de temps).
     Uint64 GetUnscaledElapsedMS() const;
 
+    /// @brief Renvoie l'écart de temps (en nanosecondes) entre les deux
+    /// dernières mises à jour.
+    Uint64 GetDeltaNS() const;
+
+    /// @brief Renvoie l'écart de temps (en nanosecondes) entre les deux
+    /// dernières mises à jour, sans échelle de temps.
+    Uint64 GetUnscaledDeltaNS() const;
+
+    /// @brief Renvoie le temps écoulé (en nanosecondes) depuis le lancement du timer.
+    Uint64 GetElapsedNS() const;
+
+    /// @brief Renvoie le temps écoulé (en nanosecondes) depuis le lancement
+    /// du timer, sans échelle de temps.
+    Uint64 GetUnscaledElapsedNS() const;
+
 protected:
     /// @brief Temps de départ.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_startTime;
 
     /// @brief Temps du dernier appel à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_currentTime;
 
     /// @brief Temps de l'avant dernier appel à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_previousTime;
 
     /// @brief Ecart entre les deux derniers appels à Timer_update().
     /// Ce membre est affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_delta;
 
     /// @brief Ecart entre les deux derniers appels à Timer_update().
     /// Ce membre n'est pas affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_unscaledDelta;
 
     /// @brief Facteur d'échelle appliqué au temps.
     float m_scale;
 
     /// @brief Ecart de temps maximum entre deux appels à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_maxDelta;
 
     /// @brief Ecart entre le lancement du timer Timer_start()
     /// et le dernier appel à Timer_update().
     /// Ce membre est affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_elapsed;
 
     /// @brief Ecart entre le lancement du timer Timer_start()
     /// et le dernier appel à Timer_update().
     /// Ce membre n'est pas affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_unscaledElapsed;
 };
 
 inline void Timer::SetMaximumDeltaTime(float maxDelta)
 {
-    m_maxDelta = (Uint64)(maxDelta * 1000.f);
+    m_maxDelta = (Uint64)((double)maxDelta * 1e9);
 }
 
 inline void Timer::SetTimeScale(float scale)
@@ -140,7 +163,7 @@ inline void Timer::SetTimeScale(float scale)
 
 inline float Timer::GetDelta() const
 {
-    return (float)m_delta / 1000.f;
+    return (float)((double)m_delta / 1e9);
 }
 
 inline float Timer::GetTimeScale() const
@@ -150,40 +173,65 @@ inline float Timer::GetTimeScale() const
 
 inline float Timer::GetUnscaledDelta() const
 {
-    return (float)m_unscaledDelta / 1000.f;
+    return (float)((double)m_unscaledDelta / 1e9);
 }
 
 inline float Timer::GetElapsed() const
 {
-    return (float)m_elapsed / 1000.f;
+    return (float)((double)m_elapsed / 1e9);
 }
 
 inline float Timer::GetUnscaledElapsed() const
 {
-    return (float)m_unscaledElapsed / 1000.f;
+    return (float)((double)m_unscaledElapsed / 1e9);
 }
 
 inline Uint64 Timer::GetDeltaMS() const
 {
-    return m_delta;
+    return SDL_NS_TO_MS(m_delta);
 }
 
 inline Uint64 Timer::GetUnscaledDeltaMS() const
 {
-    return m_unscaledElapsed;
+    return SDL_NS_TO_MS(m_unscaledDelta);
 }
 
 inline Uint64 Timer::GetElapsedMS() const
 {
-    return m_elapsed;
+    return SDL_NS_TO_MS(m_elapsed);
 }
 
 inline Uint64 Timer::GetUnscaledElapsedMS() const
+{
+    return SDL_NS_TO_MS(m_unscaledElapsed);
+}
+
+inline Uint64 Timer::GetDeltaNS() const
+{
+    return m_delta;
+}
+
+inline Uint64 Timer::GetUnscaledDeltaNS() const
+{
+    return m_unscaledDelta;
+}
+
+inline Uint64 Timer::GetElapsedNS() const
+{
+    return m_elapsed;
+}
+
+inline Uint64 Timer::GetUnscaledElapsedNS() const
 {
     return m_unscaledElapsed;
 }
 
 inline void Timer::Update(float deltaTime)
 {
-    Update((Uint64)(deltaTime * 1000.f));
+    UpdateNS((Uint64)((double)deltaTime * 1e9));
+}
+
+inline void Timer::Update(Uint64 deltaTimeMS)
+{
+    UpdateNS(SDL_MS_TO_NS(deltaTimeMS));
 }
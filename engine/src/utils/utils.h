@@ -8,19 +8,6 @@
 
 #include "game_engine_settings.h"
 
-namespace random
-{
-    inline int RangeI(int min, int max)
-    {
-        return min + (rand() % (max - min + 1));
-    }
-
-    inline float RangeF(float min, float max)
-    {
-        return min + (max - min) * (float)rand() / (float)RAND_MAX;
-    }
-};
-
 #define RAD_TO_DEG 57.2957795130823f
 #define DEG_TO_RAD 0.01745329251994329576923690768489f
 #define TAU 6.283185307179586476925286766559
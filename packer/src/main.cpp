@@ -0,0 +1,53 @@
+/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game_engine.h"
+
+#include <filesystem>
+
+// Construit l'archive des assets lue par le jeu au démarrage.
+// Utilisation : asset_packer <dossier des assets> <archive>
+//
+// Chaque sprite sheet (.json) est d'abord convertie au format binaire (.sheet)
+// dans le dossier des assets ; les fichiers binaires sont ajoutés à l'archive.
+
+namespace
+{
+    bool ConvertSpriteSheets(const std::string &assetsPath)
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code error;
+        int count = 0;
+        for (const fs::directory_entry &dirEntry : fs::recursive_directory_iterator(assetsPath, error))
+        {
+            if (dirEntry.is_regular_file() == false) continue;
+            if (dirEntry.path().extension() != ".json") continue;
+
+            const std::string jsonPath = dirEntry.path().generic_string();
+            if (SpriteSheet::ConvertFile(jsonPath, SpriteSheet::GetBinaryPath(jsonPath)) == false)
+            {
+                return false;
+            }
+            count++;
+        }
+        std::cout << "Sprite sheets : " << count << " converted" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cout << "Usage: asset_packer <assets directory> <pack file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (ConvertSpriteSheets(argv[1]) == false) return EXIT_FAILURE;
+
+    return AssetPack::Build(argv[1], argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}